@@ -8,12 +8,277 @@
  * about its quality, reliability, or any other characteristic.
  */
 
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+
 #include <frifte/e1n.h>
 
+/** State of the default asynchronous methods of one SearchInterface. */
+struct DefaultSearchQueue
+{
+	/** Results queued by submission, in order. */
+	std::deque<FRIF::SearchCompletion> completions{};
+	/** Next ticket to issue. */
+	FRIF::SearchTicket nextTicket{};
+};
+
+/*
+ * Kept outside of SearchInterface so the default asynchronous methods do not
+ * change the layout of participants' SearchInterface implementations.
+ */
+static std::mutex defaultSearchQueuesMutex{};
+static std::unordered_map<const FRIF::Evaluations::Exemplar1N::SearchInterface*,
+    DefaultSearchQueue> defaultSearchQueues{};
+
 FRIF::Evaluations::Exemplar1N::ExtractionInterface::ExtractionInterface() =
     default;
 FRIF::Evaluations::Exemplar1N::ExtractionInterface::~ExtractionInterface() =
     default;
 
+std::tuple<FRIF::ReturnStatus,
+    std::optional<FRIF::pmr::CreateTemplateResult>>
+FRIF::Evaluations::Exemplar1N::ExtractionInterface::createTemplate(
+    const TemplateType templateType,
+    const std::string &identifier,
+    const std::vector<Sample> &samples,
+    std::pmr::memory_resource *resource)
+    const
+{
+	const auto [rv, ctr] = this->createTemplate(templateType, identifier,
+	    samples);
+	if (!ctr)
+		return {rv, std::nullopt};
+	return {rv, pmr::CreateTemplateResult{*ctr, resource}};
+}
+
+std::vector<std::tuple<FRIF::ReturnStatus,
+    std::optional<FRIF::CreateTemplateResult>>>
+FRIF::Evaluations::Exemplar1N::ExtractionInterface::createTemplateBatch(
+    const TemplateType templateType,
+    const std::vector<std::tuple<std::string, std::vector<Sample>>> &jobs)
+    const
+{
+	std::vector<std::tuple<ReturnStatus,
+	    std::optional<CreateTemplateResult>>> results{};
+	results.reserve(jobs.size());
+	for (const auto &[identifier, samples] : jobs)
+		results.push_back(this->createTemplate(templateType,
+		    identifier, samples));
+
+	return (results);
+}
+
+std::optional<std::tuple<FRIF::ReturnStatus,
+    std::pmr::vector<FRIF::pmr::TemplateData>>>
+FRIF::Evaluations::Exemplar1N::ExtractionInterface::extractTemplateData(
+    const TemplateType templateType,
+    const pmr::CreateTemplateResult &templateResult,
+    std::pmr::memory_resource *resource)
+    const
+{
+	CreateTemplateResult ctr{};
+	ctr.data.assign(templateResult.data.cbegin(),
+	    templateResult.data.cend());
+
+	const auto ret = this->extractTemplateData(templateType, ctr);
+	if (!ret)
+		return (std::nullopt);
+	const auto &[rv, data] = *ret;
+	return (std::make_tuple(rv, std::pmr::vector<pmr::TemplateData>{
+	    data.cbegin(), data.cend(), resource}));
+}
+
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::ExtractionInterface::
+    insertIntoReferenceDatabase(
+    [[maybe_unused]] const TemplateArchive &referenceTemplates,
+    [[maybe_unused]] const std::filesystem::path &databaseDirectory,
+    [[maybe_unused]] const uint64_t maxSize)
+    const
+{
+	return {ReturnStatus::Result::Failure, "Not implemented"};
+}
+
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::ExtractionInterface::
+    removeFromReferenceDatabase(
+    [[maybe_unused]] const std::vector<std::string> &identifiers,
+    [[maybe_unused]] const std::filesystem::path &databaseDirectory)
+    const
+{
+	return {ReturnStatus::Result::Failure, "Not implemented"};
+}
+
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::ExtractionInterface::updateReferenceDatabase(
+    [[maybe_unused]] const TemplateArchive &referenceTemplates,
+    [[maybe_unused]] const std::filesystem::path &databaseDirectory,
+    [[maybe_unused]] const uint64_t maxSize)
+    const
+{
+	return {ReturnStatus::Result::Failure, "Not implemented"};
+}
+
 FRIF::Evaluations::Exemplar1N::SearchInterface::SearchInterface() = default;
-FRIF::Evaluations::Exemplar1N::SearchInterface::~SearchInterface() = default;
+
+FRIF::Evaluations::Exemplar1N::SearchInterface::~SearchInterface()
+{
+	const std::lock_guard lock{defaultSearchQueuesMutex};
+	defaultSearchQueues.erase(this);
+}
+
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::SearchInterface::reload(
+    [[maybe_unused]] const uint64_t maxSize)
+{
+	return {ReturnStatus::Result::Failure, "Not implemented"};
+}
+
+std::vector<std::tuple<FRIF::ReturnStatus,
+    std::optional<FRIF::SearchSubjectPositionResult>>>
+FRIF::Evaluations::Exemplar1N::SearchInterface::searchSubjectPositionBatch(
+    const std::vector<std::span<const std::byte>> &probeTemplates,
+    const uint16_t maxCandidates)
+    const
+{
+	std::vector<std::tuple<ReturnStatus,
+	    std::optional<SearchSubjectPositionResult>>> results{};
+	results.reserve(probeTemplates.size());
+	for (const auto &probeTemplate : probeTemplates)
+		results.push_back(this->searchSubjectPosition(probeTemplate,
+		    maxCandidates));
+
+	return (results);
+}
+
+std::vector<std::tuple<FRIF::ReturnStatus,
+    std::optional<FRIF::SearchSubjectResult>>>
+FRIF::Evaluations::Exemplar1N::SearchInterface::searchSubjectBatch(
+    const std::vector<std::span<const std::byte>> &probeTemplates,
+    const uint16_t maxCandidates)
+    const
+{
+	std::vector<std::tuple<ReturnStatus,
+	    std::optional<SearchSubjectResult>>> results{};
+	results.reserve(probeTemplates.size());
+	for (const auto &probeTemplate : probeTemplates)
+		results.push_back(this->searchSubject(probeTemplate,
+		    maxCandidates));
+
+	return (results);
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectPositionResult>>
+FRIF::Evaluations::Exemplar1N::SearchInterface::searchSubjectPosition(
+    std::span<const std::byte> probeTemplate,
+    const uint16_t maxCandidates)
+    const
+{
+	return (this->searchSubjectPosition(std::vector<std::byte>(
+	    probeTemplate.begin(), probeTemplate.end()), maxCandidates));
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectResult>>
+FRIF::Evaluations::Exemplar1N::SearchInterface::searchSubject(
+    std::span<const std::byte> probeTemplate,
+    const uint16_t maxCandidates)
+    const
+{
+	return (this->searchSubject(std::vector<std::byte>(
+	    probeTemplate.begin(), probeTemplate.end()), maxCandidates));
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectPositionResult>>
+FRIF::Evaluations::Exemplar1N::SearchInterface::searchSubjectPosition(
+    std::span<const std::byte> probeTemplate,
+    const uint16_t maxCandidates,
+    [[maybe_unused]] const SearchLimits &limits)
+    const
+{
+	/* Searching to completion satisfies any limit */
+	return (this->searchSubjectPosition(probeTemplate, maxCandidates));
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectResult>>
+FRIF::Evaluations::Exemplar1N::SearchInterface::searchSubject(
+    std::span<const std::byte> probeTemplate,
+    const uint16_t maxCandidates,
+    [[maybe_unused]] const SearchLimits &limits)
+    const
+{
+	/* Searching to completion satisfies any limit */
+	return (this->searchSubject(probeTemplate, maxCandidates));
+}
+
+std::optional<FRIF::SubjectPositionCandidateListCorrespondence>
+FRIF::Evaluations::Exemplar1N::SearchInterface::
+    extractCorrespondenceSubjectPosition(
+    std::span<const std::byte> probeTemplate,
+    const SearchSubjectPositionResult &searchResult)
+    const
+{
+	return (this->extractCorrespondenceSubjectPosition(
+	    std::vector<std::byte>(probeTemplate.begin(), probeTemplate.end()),
+	    searchResult));
+}
+
+std::optional<FRIF::SubjectCandidateListCorrespondence>
+FRIF::Evaluations::Exemplar1N::SearchInterface::extractCorrespondenceSubject(
+    std::span<const std::byte> probeTemplate,
+    const SearchSubjectResult &searchResult)
+    const
+{
+	return (this->extractCorrespondenceSubject(std::vector<std::byte>(
+	    probeTemplate.begin(), probeTemplate.end()), searchResult));
+}
+
+FRIF::SearchTicket
+FRIF::Evaluations::Exemplar1N::SearchInterface::submitSearchSubjectPosition(
+    std::span<const std::byte> probeTemplate,
+    const uint16_t maxCandidates)
+{
+	const auto [rs, result] = this->searchSubjectPosition(probeTemplate,
+	    maxCandidates);
+
+	const std::lock_guard lock{defaultSearchQueuesMutex};
+	auto &queue = defaultSearchQueues[this];
+	const SearchTicket ticket{queue.nextTicket++};
+	queue.completions.push_back({ticket, rs, result});
+	return (ticket);
+}
+
+FRIF::SearchTicket
+FRIF::Evaluations::Exemplar1N::SearchInterface::submitSearchSubject(
+    std::span<const std::byte> probeTemplate,
+    const uint16_t maxCandidates)
+{
+	const auto [rs, result] = this->searchSubject(probeTemplate,
+	    maxCandidates);
+
+	const std::lock_guard lock{defaultSearchQueuesMutex};
+	auto &queue = defaultSearchQueues[this];
+	const SearchTicket ticket{queue.nextTicket++};
+	queue.completions.push_back({ticket, rs, result});
+	return (ticket);
+}
+
+std::vector<FRIF::SearchCompletion>
+FRIF::Evaluations::Exemplar1N::SearchInterface::completeSearches(
+    [[maybe_unused]] const bool wait)
+{
+	/* Searches completed on submission, so there is never a wait */
+	const std::lock_guard lock{defaultSearchQueuesMutex};
+	const auto it = defaultSearchQueues.find(this);
+	if (it == defaultSearchQueues.end())
+		return {};
+
+	auto &queue = it->second.completions;
+	std::vector<SearchCompletion> completions(
+	    std::make_move_iterator(queue.begin()),
+	    std::make_move_iterator(queue.end()));
+	queue.clear();
+
+	return (completions);
+}
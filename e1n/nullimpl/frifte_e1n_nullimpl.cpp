@@ -8,6 +8,12 @@
  * about its quality, reliability, or any other characteristic.
  */
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
 #include <frifte_e1n_nullimpl.h>
 
 FRIF::Evaluations::Exemplar1N::NullExtractionImplementation::
@@ -68,6 +74,153 @@ FRIF::Evaluations::Exemplar1N::NullExtractionImplementation::
 	return {};
 }
 
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::NullExtractionImplementation::
+    insertIntoReferenceDatabase(
+    const TemplateArchive &referenceTemplates,
+    const std::filesystem::path &databaseDirectory,
+    const uint64_t maxSize)
+    const
+{
+	return (this->modifyReferenceDatabase(databaseDirectory, {},
+	    referenceTemplates));
+}
+
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::NullExtractionImplementation::
+    removeFromReferenceDatabase(
+    const std::vector<std::string> &identifiers,
+    const std::filesystem::path &databaseDirectory)
+    const
+{
+	return (this->modifyReferenceDatabase(databaseDirectory,
+	    {identifiers.begin(), identifiers.end()}, {}));
+}
+
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::NullExtractionImplementation::
+    updateReferenceDatabase(
+    const TemplateArchive &referenceTemplates,
+    const std::filesystem::path &databaseDirectory,
+    const uint64_t maxSize)
+    const
+{
+	std::ifstream manifest{referenceTemplates.manifest};
+	if (!manifest)
+		return {ReturnStatus::Result::Failure, "Could not open " +
+		    referenceTemplates.manifest.string()};
+
+	std::set<std::string> identifiers{};
+	std::string line{}, identifier{};
+	while (std::getline(manifest, line)) {
+		if (!(std::istringstream{line} >> identifier))
+			return {ReturnStatus::Result::Failure, "Invalid entry "
+			    "in " + referenceTemplates.manifest.string() +
+			    ": " + line};
+		identifiers.insert(identifier);
+	}
+
+	return (this->modifyReferenceDatabase(databaseDirectory, identifiers,
+	    referenceTemplates));
+}
+
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::NullExtractionImplementation::
+    modifyReferenceDatabase(
+    const std::filesystem::path &databaseDirectory,
+    const std::set<std::string> &removals,
+    const std::optional<TemplateArchive> &additions)
+    const
+{
+	const auto archivePath = databaseDirectory / "archive";
+	const auto manifestPath = databaseDirectory / "manifest";
+
+	/* Keep existing manifest lines that aren't being removed */
+	std::ifstream manifest{manifestPath};
+	if (!manifest)
+		return {ReturnStatus::Result::Failure, "Could not open " +
+		    manifestPath.string()};
+	std::set<std::string> identifiers{};
+	std::string lines{}, line{}, identifier{};
+	while (std::getline(manifest, line)) {
+		if (!(std::istringstream{line} >> identifier))
+			return {ReturnStatus::Result::Failure, "Invalid entry "
+			    "in " + manifestPath.string() + ": " + line};
+		identifiers.insert(identifier);
+		if (!removals.contains(identifier))
+			lines += line + '\n';
+	}
+	manifest.close();
+
+	for (const auto &removal : removals)
+		if (!identifiers.contains(removal))
+			return {ReturnStatus::Result::Failure, removal +
+			    " is not in the reference database"};
+
+	/* Offsets in additions are relative to the end of our archive */
+	std::error_code ec{};
+	const auto archiveSize = std::filesystem::file_size(archivePath, ec);
+	if (ec)
+		return {ReturnStatus::Result::Failure, "Could not stat " +
+		    archivePath.string() + ": " + ec.message()};
+	if (additions) {
+		manifest.open(additions->manifest);
+		if (!manifest)
+			return {ReturnStatus::Result::Failure, "Could not "
+			    "open " + additions->manifest.string()};
+
+		uint64_t length{}, offset{};
+		while (std::getline(manifest, line)) {
+			if (!(std::istringstream{line} >> identifier >>
+			    length >> offset))
+				return {ReturnStatus::Result::Failure,
+				    "Invalid entry in " +
+				    additions->manifest.string() + ": " +
+				    line};
+			if (identifiers.contains(identifier) &&
+			    !removals.contains(identifier))
+				return {ReturnStatus::Result::Failure,
+				    identifier + " is already in the "
+				    "reference database"};
+			lines += identifier + ' ' + std::to_string(length) +
+			    ' ' + std::to_string(offset + archiveSize) + '\n';
+		}
+
+		/*
+		 * XXX: Bytes of removed templates stay in the archive. You
+		 *      may want to compact your database once enough of it
+		 *      is unreferenced.
+		 */
+		std::ifstream in{additions->archive, std::ios_base::binary};
+		std::ofstream out{archivePath, std::ios_base::binary |
+		    std::ios_base::app};
+		/* Inserting an empty stream buffer sets failbit */
+		const bool empty{in.peek() == std::ifstream::traits_type::eof()};
+		if (!in || !out || (!empty && !(out << in.rdbuf())) ||
+		    !out.flush())
+			return {ReturnStatus::Result::Failure, "Error when "
+			    "appending " + additions->archive.string()};
+	}
+
+	/*
+	 * Appended bytes are unreferenced until the new manifest replaces
+	 * the old one, so a failure leaves a usable database.
+	 */
+	const auto tempManifestPath = databaseDirectory / "manifest.tmp";
+	std::ofstream out{tempManifestPath, std::ios_base::trunc};
+	if (!(out << lines) || !out.flush())
+		return {ReturnStatus::Result::Failure, "Error when writing " +
+		    tempManifestPath.string()};
+	out.close();
+
+	std::filesystem::rename(tempManifestPath, manifestPath, ec);
+	if (ec)
+		return {ReturnStatus::Result::Failure, "Error when replacing " +
+		    manifestPath.string() + ": " + ec.message()};
+
+	return {};
+}
+
 std::optional<FRIF::ProductIdentifier>
 FRIF::Evaluations::Exemplar1N::ExtractionInterface::getProductIdentifier()
 {
@@ -105,6 +258,7 @@ FRIF::Evaluations::Exemplar1N::ExtractionInterface::getCompatibility()
 
 	compatibility.supportsProbeTemplateIntrospection = false;
 	compatibility.supportsReferenceTemplateIntrospection = false;
+	compatibility.supportsIncrementalReferenceDatabase = true;
 
 	compatibility.probeTemplateVersions = {
 	    NullImplementationConstants::featureExtractionProductVersion,
@@ -163,11 +317,74 @@ FRIF::Evaluations::Exemplar1N::NullSearchImplementation::load(
 		throw std::runtime_error{(this->databaseDirectory /
 		    "manifest").string() + " does not exist"};
 
-	/* XXX: Load maxSize bytes of data into RAM. */
+	if (this->archive)
+		return {};
+
+	return (this->mapDatabase(maxSize));
+}
+
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::NullSearchImplementation::mapDatabase(
+    const uint64_t maxSize)
+{
+	std::optional<Util::MappedFile> mappedArchive{};
+	try {
+		mappedArchive.emplace(this->databaseDirectory / "archive");
+	} catch (const std::exception &e) {
+		return {ReturnStatus::Result::Failure, e.what()};
+	}
+	const auto bytes = mappedArchive->data();
+
+	const auto manifestPath = this->databaseDirectory / "manifest";
+	std::ifstream manifest{manifestPath};
+	if (!manifest)
+		return {ReturnStatus::Result::Failure, "Could not open " +
+		    manifestPath.string()};
+
+	std::unordered_map<std::string, std::span<const std::byte>>
+	    mappedTemplates{};
+	std::string line{}, identifier{};
+	uint64_t length{}, offset{};
+	while (std::getline(manifest, line)) {
+		if (!(std::istringstream{line} >> identifier >> length >>
+		    offset) || (offset > bytes.size()) ||
+		    (length > bytes.size() - offset))
+			return {ReturnStatus::Result::Failure, "Invalid entry "
+			    "in " + manifestPath.string() + ": " + line};
+		mappedTemplates[identifier] = bytes.subspan(offset, length);
+	}
+
+	/*
+	 * XXX: Pages of the archive are read from disk when first touched,
+	 *      and shared among fork()ed processes. Touch the first maxSize
+	 *      bytes now so early searches don't wait on the disk. Pages
+	 *      beyond maxSize may be evicted under memory pressure. Yours
+	 *      might instead touch the most discriminating data first.
+	 */
+	const auto pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+	const auto resident = std::min<uint64_t>(maxSize, bytes.size());
+	[[maybe_unused]] volatile std::byte sink{};
+	for (uint64_t i{0}; i < resident; i += pageSize)
+		sink = bytes[i];
+
+	this->archive = std::move(mappedArchive);
+	this->templates = std::move(mappedTemplates);
 
 	return {};
 }
 
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::NullSearchImplementation::reload(
+    const uint64_t maxSize)
+{
+	/*
+	 * XXX: Mapping again is cheap, since pages already resident are
+	 *      reused, but you may want to compare the manifest with what
+	 *      was loaded and update only the templates that changed.
+	 */
+	return (this->mapDatabase(maxSize));
+}
+
 std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectPositionResult>>
 FRIF::Evaluations::Exemplar1N::NullSearchImplementation::searchSubjectPosition(
     const std::vector<std::byte> &probeTemplate,
@@ -282,6 +499,9 @@ FRIF::Evaluations::Exemplar1N::SearchInterface::getCompatibility()
 	Compatibility compatibility{};
 
 	compatibility.supportsCorrespondence = false;
+	/* Null search methods modify no state */
+	compatibility.supportsConcurrentSearch = true;
+	compatibility.supportsReload = true;
 
 	compatibility.probeTemplateVersions = {
 	    NullImplementationConstants::featureExtractionProductVersion,
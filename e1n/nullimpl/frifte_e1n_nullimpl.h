@@ -11,7 +11,12 @@
 #ifndef FRIF_E1N_NULLIMPL_H_
 #define FRIF_E1N_NULLIMPL_H_
 
+#include <set>
+#include <span>
+#include <unordered_map>
+
 #include <frifte/e1n.h>
+#include <frifte/util.h>
 
 namespace FRIF::Evaluations::Exemplar1N
 {
@@ -34,6 +39,15 @@ namespace FRIF::Evaluations::Exemplar1N
 	class NullExtractionImplementation : public ExtractionInterface
 	{
 	public:
+		/*
+		 * XXX: Expose ExtractionInterface's std::pmr overloads, which
+		 *      copy into the per-request memory resource. Override
+		 *      them instead if your algorithm can build its results
+		 *      within that memory resource.
+		 */
+		using ExtractionInterface::createTemplate;
+		using ExtractionInterface::extractTemplateData;
+
 		std::tuple<ReturnStatus, std::optional<CreateTemplateResult>>
 		createTemplate(
 		    const TemplateType templateType,
@@ -58,21 +72,84 @@ namespace FRIF::Evaluations::Exemplar1N
 		    const
 		    override;
 
+		ReturnStatus
+		insertIntoReferenceDatabase(
+		    const TemplateArchive &referenceTemplates,
+		    const std::filesystem::path &databaseDirectory,
+		    const uint64_t maxSize)
+		    const
+		    override;
+
+		ReturnStatus
+		removeFromReferenceDatabase(
+		    const std::vector<std::string> &identifiers,
+		    const std::filesystem::path &databaseDirectory)
+		    const
+		    override;
+
+		ReturnStatus
+		updateReferenceDatabase(
+		    const TemplateArchive &referenceTemplates,
+		    const std::filesystem::path &databaseDirectory,
+		    const uint64_t maxSize)
+		    const
+		    override;
+
 		NullExtractionImplementation(
 		    const std::filesystem::path &configurationDirectory = {});
 
 	private:
+		/**
+		 * @brief
+		 * Remove and then append templates to the archive and
+		 * manifest copied by createReferenceDatabase().
+		 *
+		 * @param databaseDirectory
+		 * Directory populated by createReferenceDatabase().
+		 * @param removals
+		 * Identifiers that must exist in the database, to be removed.
+		 * @param additions
+		 * Templates whose identifiers must not exist in the database
+		 * once `removals` are removed, to be appended.
+		 *
+		 * @return
+		 * Information about the result of executing the method.
+		 */
+		ReturnStatus
+		modifyReferenceDatabase(
+		    const std::filesystem::path &databaseDirectory,
+		    const std::set<std::string> &removals,
+		    const std::optional<TemplateArchive> &additions)
+		    const;
+
 		const std::filesystem::path configurationDirectory{};
 	};
 
 	class NullSearchImplementation : public SearchInterface
 	{
 	public:
+		/*
+		 * XXX: Expose SearchInterface's std::span overloads, which copy
+		 *      into a std::vector. Override them instead if your
+		 *      algorithm can search without owning the probe template,
+		 *      and override the SearchLimits overloads if your
+		 *      algorithm can stop searching early.
+		 */
+		using SearchInterface::searchSubjectPosition;
+		using SearchInterface::searchSubject;
+		using SearchInterface::extractCorrespondenceSubjectPosition;
+		using SearchInterface::extractCorrespondenceSubject;
+
 		ReturnStatus
 		load(
 		    const uint64_t maxSize)
 		    override;
 
+		ReturnStatus
+		reload(
+		    const uint64_t maxSize)
+		    override;
+
 		std::tuple<ReturnStatus,
 		    std::optional<SearchSubjectPositionResult>>
 		searchSubjectPosition(
@@ -107,8 +184,28 @@ namespace FRIF::Evaluations::Exemplar1N
 		    const std::filesystem::path &databaseDirectory);
 
 	private:
+		/**
+		 * @brief
+		 * Map the archive and index its templates with the manifest.
+		 *
+		 * @param maxSize
+		 * Number of bytes of the archive to make resident up front.
+		 *
+		 * @return
+		 * Information about the result of executing the method.
+		 */
+		ReturnStatus
+		mapDatabase(
+		    const uint64_t maxSize);
+
 		const std::filesystem::path configurationDirectory{};
 		const std::filesystem::path databaseDirectory{};
+
+		/** Read-only mapping of the database archive. */
+		std::optional<Util::MappedFile> archive{};
+		/** Each reference template, pointing into #archive. */
+		std::unordered_map<std::string, std::span<const std::byte>>
+		    templates{};
 	};
 }
 
@@ -8,9 +8,15 @@
  * about its quality, reliability, or any other characteristic.
  */
 
+#include <array>
+#include <cstddef>
 #include <fstream>
+#include <limits>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "frifte_e1n_data.h"
 
@@ -337,3 +343,237 @@ FRIF::Evaluations::Exemplar1N::Validation::Data::readCSV(
 
 	return (dataset);
 }
+
+/** First bytes of an ImagePack. */
+static constexpr std::array<std::byte, 4> ImagePackMagic{std::byte{'F'},
+    std::byte{'I'}, std::byte{'P'}, std::byte{'K'}};
+/** Size of the header at the start of an ImagePack. */
+static constexpr uint64_t ImagePackHeaderSize{32};
+
+template<typename T>
+static void
+putLE(
+    std::vector<std::byte> &buf,
+    const T value)
+{
+	for (std::size_t i{0}; i < sizeof(T); ++i)
+		buf.push_back(static_cast<std::byte>((value >> (8 * i)) & 0xFF));
+}
+
+/** Read a value at `offset`, advancing `offset` past it. */
+template<typename T>
+static T
+readLE(
+    std::span<const std::byte> buf,
+    uint64_t &offset)
+{
+	if ((offset > buf.size()) || (sizeof(T) > buf.size() - offset))
+		throw std::runtime_error{"ImagePack is truncated"};
+
+	uint64_t value{};
+	for (std::size_t i{0}; i < sizeof(T); ++i)
+		value |= uint64_t{std::to_integer<uint8_t>(buf[offset + i])} <<
+		    (8 * i);
+	offset += sizeof(T);
+
+	if constexpr (std::is_same_v<T, uint64_t>)
+		return (value);
+	else
+		return (static_cast<T>(value));
+}
+
+/** Write all of `buf` to `stream`. */
+static void
+writeBytes(
+    std::ostream &stream,
+    std::span<const std::byte> buf,
+    const std::filesystem::path &pathName)
+{
+	stream.write(reinterpret_cast<const char*>(buf.data()),
+	    static_cast<std::streamsize>(buf.size()));
+	if (!stream)
+		throw std::runtime_error{"Could not write " +
+		    pathName.string()};
+}
+
+FRIF::Evaluations::Exemplar1N::Validation::Data::ImagePack::ImagePack(
+    const std::filesystem::path &pathName) :
+    file{std::make_shared<const Util::MappedFile>(pathName)}
+{
+	const auto data = this->file->data();
+
+	uint64_t offset{0};
+	for (const auto &b : ImagePackMagic)
+		if (readLE<uint8_t>(data, offset) != std::to_integer<uint8_t>(b))
+			throw std::runtime_error{pathName.string() + " is not "
+			    "an ImagePack"};
+	const auto version = readLE<uint16_t>(data, offset);
+	if (version > Version)
+		throw std::runtime_error{"Unsupported ImagePack version " +
+		    std::to_string(version) + " in " + pathName.string()};
+	offset += sizeof(uint16_t);
+	const auto count = readLE<uint32_t>(data, offset);
+	offset += sizeof(uint32_t);
+	const auto indexOffset = readLE<uint64_t>(data, offset);
+
+	offset = indexOffset;
+	this->entries.reserve(count);
+	for (uint32_t i{0}; i < count; ++i) {
+		const auto nameLength = readLE<uint16_t>(data, offset);
+		if ((offset > data.size()) ||
+		    (nameLength > data.size() - offset))
+			throw std::runtime_error{"ImagePack is truncated"};
+		std::string filename(reinterpret_cast<const char*>(
+		    data.data() + offset), nameLength);
+		offset += nameLength;
+
+		const auto pixelOffset = readLE<uint64_t>(data, offset);
+		const auto pixelSize = readLE<uint64_t>(data, offset);
+		if ((pixelOffset > data.size()) ||
+		    (pixelSize > data.size() - pixelOffset))
+			throw std::runtime_error{"Pixels of " + filename +
+			    " are outside of " + pathName.string()};
+
+		Entry entry{};
+		entry.pixels = data.subspan(pixelOffset, pixelSize);
+		entry.image.filename = filename;
+		entry.image.width = readLE<uint16_t>(data, offset);
+		entry.image.height = readLE<uint16_t>(data, offset);
+		entry.image.ppi = readLE<uint16_t>(data, offset);
+		switch (readLE<uint8_t>(data, offset)) {
+		case 0:
+			entry.image.colorspace = Image::Colorspace::Grayscale;
+			break;
+		case 1:
+			entry.image.colorspace = Image::Colorspace::RGB;
+			break;
+		default:
+			throw std::runtime_error{"Invalid colorspace for " +
+			    filename + " in " + pathName.string()};
+		}
+		entry.image.bpc = Image::toBitsPerChannel(
+		    readLE<uint8_t>(data, offset));
+		entry.image.bpp = Image::toBitsPerPixel(
+		    readLE<uint8_t>(data, offset));
+
+		if (!this->entries.emplace(filename, entry).second)
+			throw std::runtime_error{"Duplicate image " + filename +
+			    " in " + pathName.string()};
+	}
+}
+
+FRIF::Image
+FRIF::Evaluations::Exemplar1N::Validation::Data::ImagePack::makeImage(
+    const uint8_t identifier,
+    const CSVImage &image)
+    const
+{
+	if (!image.filename)
+		throw std::runtime_error{"No filename provided"};
+	const auto it = this->entries.find(*image.filename);
+	if (it == this->entries.cend())
+		throw std::runtime_error{*image.filename + " is not in "
+		    "ImagePack"};
+
+	const auto &packed = it->second.image;
+	if ((image.width != packed.width) ||
+	    (image.height != packed.height) || (image.ppi != packed.ppi) ||
+	    (image.colorspace != packed.colorspace) ||
+	    (image.bpc != packed.bpc) || (image.bpp != packed.bpp))
+		throw std::runtime_error{"Metadata of " + *image.filename +
+		    " differs from ImagePack"};
+
+	return {identifier, *packed.width, *packed.height, *packed.ppi,
+	    *packed.colorspace, *packed.bpc, *packed.bpp, it->second.pixels,
+	    this->file};
+}
+
+std::size_t
+FRIF::Evaluations::Exemplar1N::Validation::Data::ImagePack::size()
+    const
+{
+	return (this->entries.size());
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::Data::writeImagePack(
+    const Dataset &dataset,
+    const std::filesystem::path &imageDir,
+    const std::filesystem::path &pathName)
+{
+	std::ofstream pack{pathName, std::ios_base::binary |
+	    std::ios_base::trunc};
+	if (!pack)
+		throw std::runtime_error{"Could not open " + pathName.string()};
+
+	/* Header is rewritten once the index location is known */
+	writeBytes(pack, std::vector<std::byte>(ImagePackHeaderSize),
+	    pathName);
+
+	uint64_t offset{ImagePackHeaderSize};
+	uint32_t count{0};
+	std::vector<std::byte> index{};
+	std::unordered_set<std::string> packed{};
+	for (const auto &[identifier, inputs] :
+	    std::get<std::vector<ImageSet>>(dataset)) {
+		for (const auto &input : inputs) {
+			if (!input.image)
+				continue;
+			const auto &im = *input.image;
+			if (!im.filename || !im.width || !im.height ||
+			    !im.ppi || !im.colorspace || !im.bpc || !im.bpp)
+				throw std::runtime_error{"Missing image "
+				    "metadata for " + identifier};
+			if (im.filename->length() >
+			    std::numeric_limits<uint16_t>::max())
+				throw std::runtime_error{"Filename too long: " +
+				    *im.filename};
+			if (!packed.insert(*im.filename).second)
+				continue;
+
+			const auto file = std::make_shared<
+			    const Util::MappedFile>(imageDir / *im.filename,
+			    Util::MappedFile::Access::Sequential);
+			const Image image(0, *im.width, *im.height, *im.ppi,
+			    *im.colorspace, *im.bpc, *im.bpp, file->data(),
+			    file);
+			image.sanityCheck();
+
+			const auto padding = (ImagePack::Alignment -
+			    (offset % ImagePack::Alignment)) %
+			    ImagePack::Alignment;
+			writeBytes(pack, std::vector<std::byte>(padding),
+			    pathName);
+			offset += padding;
+			writeBytes(pack, image.getPixels(), pathName);
+
+			putLE(index, static_cast<uint16_t>(
+			    im.filename->length()));
+			for (const auto &c : *im.filename)
+				index.push_back(static_cast<std::byte>(c));
+			putLE(index, offset);
+			putLE(index, uint64_t{image.getPixels().size()});
+			putLE(index, image.width);
+			putLE(index, image.height);
+			putLE(index, image.ppi);
+			putLE(index, static_cast<uint8_t>(image.colorspace));
+			putLE(index, static_cast<uint8_t>(image.bpc));
+			putLE(index, static_cast<uint8_t>(image.bpp));
+
+			offset += image.getPixels().size();
+			++count;
+		}
+	}
+	writeBytes(pack, index, pathName);
+
+	std::vector<std::byte> header(ImagePackMagic.cbegin(),
+	    ImagePackMagic.cend());
+	putLE(header, ImagePack::Version);
+	putLE(header, uint16_t{0});
+	putLE(header, count);
+	putLE(header, uint32_t{0});
+	putLE(header, offset);
+	putLE(header, uint64_t{index.size()});
+	pack.seekp(0);
+	writeBytes(pack, header, pathName);
+}
@@ -13,9 +13,12 @@
 
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -139,6 +142,106 @@ namespace FRIF::Evaluations::Exemplar1N::Validation::Data
 	    const char coordSep = ';',
 	    const char multiValueSep = '|');
 
+	/** Suffix of the ImagePack written alongside each dataset's CSV. */
+	const std::string ImagePackSuffix{".pack"};
+
+	/**
+	 * @brief
+	 * Every image of a dataset, packed into one memory-mapped file.
+	 *
+	 * @details
+	 * An ImagePack begins with a header, followed by the pixels of each
+	 * image aligned to ImagePack::Alignment bytes, and ends with an
+	 * index of each image's filename, location, and metadata. Every
+	 * integer is little-endian. Reading an image from an ImagePack
+	 * requires no system calls, and each Image shares the mapping
+	 * instead of copying its pixels.
+	 */
+	class ImagePack
+	{
+	public:
+		/** Version of the format written by writeImagePack(). */
+		static constexpr uint16_t Version{1};
+		/** Alignment of the start of each image's pixels. */
+		static constexpr uint64_t Alignment{64};
+
+		/**
+		 * @brief
+		 * ImagePack constructor.
+		 *
+		 * @param pathName
+		 * Path to a file created by writeImagePack().
+		 *
+		 * @throw
+		 * Error mapping `pathName`, or `pathName` is malformed.
+		 */
+		ImagePack(
+		    const std::filesystem::path &pathName);
+
+		/**
+		 * @brief
+		 * Make an Image from packed pixels.
+		 *
+		 * @param identifier
+		 * Image::identifier of the returned Image.
+		 * @param image
+		 * Metadata of the image from the dataset's CSV.
+		 *
+		 * @return
+		 * Image sharing pixels with this ImagePack.
+		 *
+		 * @throw
+		 * `image` is not in this ImagePack, or its metadata differs
+		 * from that in this ImagePack.
+		 */
+		Image
+		makeImage(
+		    const uint8_t identifier,
+		    const CSVImage &image)
+		    const;
+
+		/** @return Number of images in this ImagePack. */
+		std::size_t
+		size()
+		    const;
+
+	private:
+		/** Location and metadata of one packed image. */
+		struct Entry
+		{
+			/** Pixels within #file. */
+			std::span<const std::byte> pixels{};
+			/** Metadata, including filename. */
+			CSVImage image{};
+		};
+
+		/** Mapping of the file, shared with each Image. */
+		std::shared_ptr<const Util::MappedFile> file{};
+		/** Packed images, keyed by filename. */
+		std::unordered_map<std::string, Entry> entries{};
+	};
+
+	/**
+	 * @brief
+	 * Pack every image of a dataset into an ImagePack.
+	 *
+	 * @param dataset
+	 * Dataset, as read by readCSV(), naming the images to pack.
+	 * @param imageDir
+	 * Directory containing the images named in `dataset`.
+	 * @param pathName
+	 * Path at which to write the ImagePack.
+	 *
+	 * @throw
+	 * Error reading an image, an image does not match its metadata, or
+	 * error writing `pathName`.
+	 */
+	void
+	writeImagePack(
+	    const Dataset &dataset,
+	    const std::filesystem::path &imageDir,
+	    const std::filesystem::path &pathName);
+
 	/**
 	 * @brief
 	 * Obtain expected TemplateArchive for given dataset.
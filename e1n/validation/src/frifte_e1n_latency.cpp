@@ -0,0 +1,101 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include "frifte_e1n_latency.h"
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::LatencyRecorder::record(
+    const std::string &operation,
+    const std::string &dataset,
+    const std::chrono::steady_clock::time_point &start,
+    const std::chrono::steady_clock::time_point &stop)
+{
+	const std::lock_guard lock{this->mutex};
+	this->histograms[{operation, dataset}].record(start, stop);
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::LatencyRecorder::merge(
+    const std::filesystem::path &pathName)
+{
+	std::ifstream in{pathName};
+	if (!in)
+		throw std::runtime_error{"Could not open " + pathName.string()};
+
+	/* Each histogram follows the quoted operation and dataset */
+	std::string operation{}, dataset{};
+	while (in >> std::quoted(operation) >> std::quoted(dataset)) {
+		const Util::LatencyHistogram histogram{in};
+
+		const std::lock_guard lock{this->mutex};
+		this->histograms[{operation, dataset}].merge(histogram);
+	}
+	if (!in.eof())
+		throw std::runtime_error{"Error reading " + pathName.string()};
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::LatencyRecorder::write(
+    const std::filesystem::path &pathName)
+    const
+{
+	std::ofstream out{pathName, std::ios_base::out | std::ios_base::trunc};
+
+	const std::lock_guard lock{this->mutex};
+	for (const auto &[key, histogram] : this->histograms) {
+		/* Quoted, since dataset names may contain spaces */
+		out << std::quoted(key.first) << ' ' <<
+		    std::quoted(key.second) << '\n';
+		histogram.write(out);
+	}
+	if (!out)
+		throw std::runtime_error{"Error writing " + pathName.string()};
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::LatencyRecorder::writeSummary(
+    const std::filesystem::path &pathName)
+    const
+{
+	std::ofstream out{pathName, std::ios_base::out | std::ios_base::app};
+
+	const std::lock_guard lock{this->mutex};
+	for (const auto &[key, histogram] : this->histograms) {
+		out << '"' << key.first << "\",\"" << key.second << "\"," <<
+		    Util::ts(histogram.getCount());
+		for (const auto &[name, percentile] : LatencyPercentiles)
+			out << ',' << Util::ts(histogram.getValueAtPercentile(
+			    percentile));
+		out << ',' << Util::ts(histogram.getMax()) << '\n';
+	}
+	if (!out)
+		throw std::runtime_error{"Error writing " + pathName.string()};
+}
+
+bool
+FRIF::Evaluations::Exemplar1N::Validation::LatencyRecorder::empty()
+    const
+{
+	const std::lock_guard lock{this->mutex};
+	return (this->histograms.empty());
+}
+
+std::string
+FRIF::Evaluations::Exemplar1N::Validation::LatencyRecorder::getSummaryHeader()
+{
+	std::string header{"\"operation\",\"dataset\",count"};
+	for (const auto &[name, percentile] : LatencyPercentiles)
+		header += ',' + name;
+	return (header + ",max");
+}
@@ -0,0 +1,123 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#ifndef FRIF_E1N_LATENCY_H_
+#define FRIF_E1N_LATENCY_H_
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <frifte/frifte.h>
+
+namespace FRIF::Evaluations::Exemplar1N::Validation
+{
+	/** Column name and value of percentiles in a latency summary. */
+	const std::vector<std::pair<std::string, double>> LatencyPercentiles{
+	    {"p50", 50}, {"p90", 90}, {"p99", 99}, {"p99_9", 99.9}};
+
+	/**
+	 * @brief
+	 * Latency of calls to an implementation, by operation and dataset.
+	 *
+	 * @note
+	 * Methods may be called from multiple threads.
+	 */
+	class LatencyRecorder
+	{
+	public:
+		/**
+		 * @brief
+		 * Count the latency of one call.
+		 *
+		 * @param operation
+		 * Name of the method called.
+		 * @param dataset
+		 * Name of the dataset being processed.
+		 * @param start
+		 * When the call began.
+		 * @param stop
+		 * When the call returned.
+		 */
+		void
+		record(
+		    const std::string &operation,
+		    const std::string &dataset,
+		    const std::chrono::steady_clock::time_point &start,
+		    const std::chrono::steady_clock::time_point &stop);
+
+		/**
+		 * @brief
+		 * Add histograms written by write() to this recorder.
+		 *
+		 * @param pathName
+		 * File written by write().
+		 *
+		 * @throw
+		 * Error reading `pathName`.
+		 */
+		void
+		merge(
+		    const std::filesystem::path &pathName);
+
+		/**
+		 * @brief
+		 * Write every histogram, to be read by merge().
+		 *
+		 * @param pathName
+		 * File to write.
+		 *
+		 * @throw
+		 * Error writing `pathName`.
+		 */
+		void
+		write(
+		    const std::filesystem::path &pathName)
+		    const;
+
+		/**
+		 * @brief
+		 * Append LatencyPercentiles and the maximum of each
+		 * histogram to a CSV log.
+		 *
+		 * @param pathName
+		 * Log to append to, whose header is getSummaryHeader().
+		 *
+		 * @throw
+		 * Error writing `pathName`.
+		 */
+		void
+		writeSummary(
+		    const std::filesystem::path &pathName)
+		    const;
+
+		/** @return Whether no latencies were recorded. */
+		bool
+		empty()
+		    const;
+
+		/** @return Header of the log written by writeSummary(). */
+		static std::string
+		getSummaryHeader();
+
+	private:
+		/** Guards #histograms. */
+		mutable std::mutex mutex{};
+		/** Histogram of each {operation, dataset}. */
+		std::map<std::pair<std::string, std::string>,
+		    Util::LatencyHistogram> histograms{};
+	};
+}
+
+#endif /* FRIF_E1N_LATENCY_H_ */
@@ -0,0 +1,667 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <frifte/e1n.h>
+#include <frifte/util.h>
+
+#include "frifte_e1n_data.h"
+#include "frifte_e1n_shard.h"
+
+template<typename Result>
+static std::tuple<FRIF::ReturnStatus, std::optional<Result>>
+mergeResults(
+    const std::vector<std::tuple<FRIF::ReturnStatus,
+        std::optional<Result>>> &results,
+    const uint16_t maxCandidates)
+{
+	Result merged{};
+	bool found{false};
+	for (std::size_t i{0}; i < results.size(); ++i) {
+		const auto &[rs, result] = results[i];
+		if (!rs)
+			return {FRIF::ReturnStatus{rs.result, "Shard " +
+			    FRIF::Util::ts(i) + (rs.message ? ": " +
+			    *rs.message : "")}, std::nullopt};
+		if (!result)
+			continue;
+
+		found = true;
+		merged.decision = merged.decision || result->decision;
+		if (merged.termination == FRIF::SearchTermination::Complete)
+			merged.termination = result->termination;
+		for (const auto &[candidate, similarity] :
+		    result->candidateList) {
+			const auto [it, inserted] = merged.candidateList.
+			    emplace(candidate, similarity);
+			if (!inserted)
+				it->second = std::max(it->second, similarity);
+		}
+
+		if (result->correspondence) {
+			if (!merged.correspondence)
+				merged.correspondence.emplace();
+			merged.correspondence->insert(
+			    result->correspondence->cbegin(),
+			    result->correspondence->cend());
+		}
+	}
+	if (!found)
+		return {FRIF::ReturnStatus{}, std::nullopt};
+
+	/* Keep only the global top maxCandidates */
+	if (merged.candidateList.size() > maxCandidates) {
+		using CandidateList = decltype(merged.candidateList);
+		const FRIF::RankedCandidateList<
+		    typename CandidateList::key_type,
+		    typename CandidateList::hasher> ranked(
+		    merged.candidateList, maxCandidates);
+
+		merged.candidateList = ranked.toCandidateList();
+		if (merged.correspondence)
+			std::erase_if(*merged.correspondence,
+			    [&](const auto &entry) {
+				return (!merged.candidateList.contains(
+				    entry.first));
+			    });
+	}
+
+	return {FRIF::ReturnStatus{}, merged};
+}
+
+template<typename Result>
+static std::vector<std::tuple<FRIF::ReturnStatus, std::optional<Result>>>
+mergeBatchResults(
+    const std::vector<std::vector<std::tuple<FRIF::ReturnStatus,
+        std::optional<Result>>>> &perShard,
+    const std::size_t numProbes,
+    const uint16_t maxCandidates)
+{
+	for (std::size_t i{0}; i < perShard.size(); ++i)
+		if (perShard[i].size() != numProbes)
+			throw std::runtime_error{"Shard " + FRIF::Util::ts(i) +
+			    " returned " + FRIF::Util::ts(perShard[i].size()) +
+			    " results for " + FRIF::Util::ts(numProbes) +
+			    " probes"};
+
+	std::vector<std::tuple<FRIF::ReturnStatus, std::optional<Result>>>
+	    merged{};
+	merged.reserve(numProbes);
+	for (std::size_t probe{0}; probe < numProbes; ++probe) {
+		std::vector<std::tuple<FRIF::ReturnStatus,
+		    std::optional<Result>>> results{};
+		results.reserve(perShard.size());
+		for (const auto &shardResults : perShard)
+			results.push_back(shardResults[probe]);
+		merged.push_back(mergeResults(results, maxCandidates));
+	}
+
+	return (merged);
+}
+
+template<typename Correspondence>
+static std::optional<Correspondence>
+mergeCorrespondence(
+    const std::vector<std::optional<Correspondence>> &perShard)
+{
+	std::optional<Correspondence> merged{};
+	for (const auto &correspondence : perShard) {
+		if (!correspondence)
+			continue;
+		if (!merged)
+			merged.emplace();
+		merged->insert(correspondence->cbegin(),
+		    correspondence->cend());
+	}
+
+	return (merged);
+}
+
+/**
+ * @brief
+ * Assign each template to a contiguous shard with similar template bytes.
+ *
+ * @param lengths
+ * Length of each template, in archive order.
+ * @param numShards
+ * Number of shards.
+ *
+ * @return
+ * Shard of each template, in archive order.
+ */
+static std::vector<uint16_t>
+assignShards(
+    const std::vector<uint64_t> &lengths,
+    const uint16_t numShards)
+{
+	uint64_t total{};
+	for (const auto &length : lengths)
+		total += length;
+
+	std::vector<uint16_t> shards{};
+	shards.reserve(lengths.size());
+	uint64_t before{};
+	for (std::size_t i{0}; i < lengths.size(); ++i) {
+		/* Split on template count when all templates are empty */
+		const uint64_t shard = (total == 0) ?
+		    ((i * numShards) / lengths.size()) :
+		    ((before * numShards) / total);
+		shards.push_back(static_cast<uint16_t>(std::min<uint64_t>(
+		    shard, numShards - 1U)));
+		before += lengths[i];
+	}
+
+	return (shards);
+}
+
+/**
+ * @return
+ * Empty string if every shard holds at least one template and at most
+ * maxSize template bytes, or a reason why not.
+ */
+static std::string
+checkShards(
+    const std::vector<uint64_t> &lengths,
+    const std::vector<uint16_t> &shards,
+    const uint16_t numShards,
+    const uint64_t maxSize)
+{
+	std::vector<uint64_t> counts(numShards), sizes(numShards);
+	for (std::size_t i{0}; i < lengths.size(); ++i) {
+		++counts[shards[i]];
+		sizes[shards[i]] += lengths[i];
+	}
+
+	for (uint16_t shard{0}; shard < numShards; ++shard) {
+		if (counts[shard] == 0)
+			return ("shard " + FRIF::Util::ts(shard) + " would "
+			    "be empty");
+		if ((maxSize > 0) && (sizes[shard] > maxSize))
+			return ("shard " + FRIF::Util::ts(shard) + " would "
+			    "hold " + FRIF::Util::ts(sizes[shard]) + " bytes, "
+			    "more than " + FRIF::Util::ts(maxSize));
+	}
+
+	return {};
+}
+
+std::filesystem::path
+FRIF::Evaluations::Exemplar1N::Validation::getShardDir(
+    const std::filesystem::path &databaseDir,
+    const uint16_t shard)
+{
+	return (databaseDir / (ShardDirPrefix + Util::ts(shard)));
+}
+
+std::vector<FRIF::TemplateArchive>
+FRIF::Evaluations::Exemplar1N::Validation::splitTemplateArchive(
+    const TemplateArchive &archive,
+    const uint16_t numShards,
+    const uint64_t maxSize)
+{
+	std::ifstream manifest{archive.manifest};
+	if (!manifest)
+		throw std::runtime_error{"Could not open " +
+		    archive.manifest.string()};
+
+	std::vector<std::string> identifiers{};
+	std::vector<uint64_t> lengths{}, offsets{};
+	std::string line{}, identifier{};
+	uint64_t length{}, offset{};
+	while (std::getline(manifest, line)) {
+		if (!(std::istringstream{line} >> identifier >> length >>
+		    offset))
+			throw std::runtime_error{"Could not parse \"" + line +
+			    "\" in " + archive.manifest.string()};
+		identifiers.push_back(identifier);
+		lengths.push_back(length);
+		offsets.push_back(offset);
+	}
+	if (identifiers.empty())
+		throw std::runtime_error{archive.manifest.string() + " is "
+		    "empty"};
+
+	uint16_t count{numShards};
+	std::vector<uint16_t> shards{};
+	std::string problem{};
+	if (numShards == 0) {
+		if (maxSize == 0)
+			throw std::invalid_argument{"A maximum size is "
+			    "required to choose the number of shards"};
+
+		/* Fewest shards such that each fits */
+		uint64_t total{};
+		for (const auto &l : lengths)
+			total += l;
+		const uint64_t fewest{std::max<uint64_t>(1,
+		    (total + maxSize - 1) / maxSize)};
+		const uint64_t most{std::min<uint64_t>(identifiers.size(),
+		    std::numeric_limits<uint16_t>::max())};
+		if (fewest > most)
+			throw std::runtime_error{"Templates in " +
+			    archive.archive.string() + " cannot be split "
+			    "into shards of at most " + Util::ts(maxSize) +
+			    " bytes"};
+		for (count = static_cast<uint16_t>(fewest); ; ++count) {
+			shards = assignShards(lengths, count);
+			problem = checkShards(lengths, shards, count,
+			    maxSize);
+			if (problem.empty() || (count == most))
+				break;
+		}
+	} else {
+		shards = assignShards(lengths, count);
+		problem = checkShards(lengths, shards, count, maxSize);
+	}
+	if (!problem.empty())
+		throw std::runtime_error{"Could not split " +
+		    archive.archive.string() + " into " + Util::ts(count) +
+		    " shards: " + problem};
+
+	std::ifstream in{archive.archive, std::ios_base::binary};
+	if (!in)
+		throw std::runtime_error{"Could not open " +
+		    archive.archive.string()};
+
+	std::vector<TemplateArchive> shardArchives{};
+	std::vector<std::ofstream> archiveStreams{}, manifestStreams{};
+	std::vector<uint64_t> shardOffsets(count);
+	for (uint16_t shard{0}; shard < count; ++shard) {
+		const auto dir = getShardDir(archive.archive.parent_path(),
+		    shard);
+		std::filesystem::create_directories(dir);
+
+		shardArchives.push_back({dir / Data::TemplateArchiveArchiveName,
+		    dir / Data::TemplateArchiveManifestName});
+		archiveStreams.emplace_back(shardArchives.back().archive,
+		    std::ios_base::binary | std::ios_base::trunc);
+		manifestStreams.emplace_back(shardArchives.back().manifest,
+		    std::ios_base::trunc);
+		if (!archiveStreams.back() || !manifestStreams.back())
+			throw std::runtime_error{"Could not open shard " +
+			    Util::ts(shard) + " in " + dir.string()};
+	}
+
+	std::vector<char> buf{};
+	for (std::size_t i{0}; i < identifiers.size(); ++i) {
+		const auto shard = shards[i];
+
+		buf.resize(lengths[i]);
+		in.seekg(static_cast<std::streamoff>(offsets[i]));
+		if (!in.read(buf.data(), static_cast<std::streamsize>(
+		    buf.size())))
+			throw std::runtime_error{"Could not read " +
+			    identifiers[i] + " from " +
+			    archive.archive.string()};
+
+		if (!archiveStreams[shard].write(buf.data(),
+		    static_cast<std::streamsize>(buf.size())))
+			throw std::runtime_error{"Could not write " +
+			    shardArchives[shard].archive.string()};
+		if (!(manifestStreams[shard] << identifiers[i] << ' ' <<
+		    lengths[i] << ' ' << shardOffsets[shard] << '\n'))
+			throw std::runtime_error{"Could not write " +
+			    shardArchives[shard].manifest.string()};
+		shardOffsets[shard] += lengths[i];
+	}
+
+	return (shardArchives);
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::writeShardAssignments(
+    const std::vector<TemplateArchive> &shards,
+    const std::filesystem::path &databaseDir)
+{
+	const auto path = databaseDir / ShardAssignmentsName;
+	std::ofstream out{path, std::ios_base::trunc};
+	if (!out)
+		throw std::runtime_error{"Could not open " + path.string()};
+
+	std::string line{}, identifier{};
+	for (std::size_t shard{0}; shard < shards.size(); ++shard) {
+		std::ifstream manifest{shards[shard].manifest};
+		if (!manifest)
+			throw std::runtime_error{"Could not open " +
+			    shards[shard].manifest.string()};
+
+		while (std::getline(manifest, line)) {
+			std::istringstream{line} >> identifier;
+			out << identifier << ' ' << shard << '\n';
+		}
+	}
+
+	if (!out.flush())
+		throw std::runtime_error{"Could not write " + path.string()};
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectPositionResult>>
+FRIF::Evaluations::Exemplar1N::Validation::mergeSearchResults(
+    const std::vector<std::tuple<ReturnStatus,
+        std::optional<SearchSubjectPositionResult>>> &results,
+    const uint16_t maxCandidates)
+{
+	return (mergeResults(results, maxCandidates));
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectResult>>
+FRIF::Evaluations::Exemplar1N::Validation::mergeSearchResults(
+    const std::vector<std::tuple<ReturnStatus,
+        std::optional<SearchSubjectResult>>> &results,
+    const uint16_t maxCandidates)
+{
+	return (mergeResults(results, maxCandidates));
+}
+
+/******************************************************************************/
+
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    ShardedSearchInterface(
+    const std::filesystem::path &configurationDirectory_,
+    const std::filesystem::path &databaseDirectory_) :
+    SearchInterface(),
+    configurationDirectory{configurationDirectory_},
+    databaseDirectory{databaseDirectory_},
+    concurrent{SearchInterface::getCompatibility().supportsConcurrentSearch}
+{
+
+}
+
+template<typename Fn>
+auto
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::scatter(
+    Fn fn)
+    const
+{
+	using Result = std::invoke_result_t<Fn, const SearchInterface&,
+	    uint16_t>;
+	const auto numShards = static_cast<uint16_t>(this->shards.size());
+
+	std::vector<Result> results(numShards);
+	if (!this->concurrent) {
+		for (uint16_t shard{0}; shard < numShards; ++shard)
+			results[shard] = fn(*this->shards[shard], shard);
+		return (results);
+	}
+
+	std::vector<std::future<Result>> futures{};
+	futures.reserve(numShards);
+	for (uint16_t shard{0}; shard < numShards; ++shard)
+		futures.push_back(std::async(std::launch::async, fn,
+		    std::cref(*this->shards[shard]), shard));
+	for (uint16_t shard{0}; shard < numShards; ++shard)
+		results[shard] = futures[shard].get();
+
+	return (results);
+}
+
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::load(
+    const uint64_t maxSize)
+{
+	if (!this->shards.empty())
+		return {};
+
+	const auto path = this->databaseDirectory / ShardAssignmentsName;
+	std::ifstream in{path};
+	if (!in)
+		return {ReturnStatus::Result::Failure, "Could not open " +
+		    path.string()};
+
+	SubjectIdentifierDictionary shardIdentifiers{};
+	std::vector<uint16_t> shardAssignments{};
+	uint16_t numShards{};
+	std::string line{}, identifier{};
+	uint16_t shard{};
+	while (std::getline(in, line)) {
+		if (!(std::istringstream{line} >> identifier >> shard))
+			return {ReturnStatus::Result::Failure, "Could not "
+			    "parse \"" + line + "\" in " + path.string()};
+		const auto id = shardIdentifiers.intern(identifier);
+		if (id == shardAssignments.size())
+			shardAssignments.push_back(shard);
+		else
+			shardAssignments[id] = shard;
+		numShards = std::max(numShards,
+		    static_cast<uint16_t>(shard + 1));
+	}
+	if (numShards == 0)
+		return {ReturnStatus::Result::Failure, path.string() + " is "
+		    "empty"};
+
+	std::vector<std::shared_ptr<SearchInterface>> shardImpls{};
+	shardImpls.reserve(numShards);
+	for (shard = 0; shard < numShards; ++shard) {
+		const auto impl = SearchInterface::getImplementation(
+		    this->configurationDirectory, getShardDir(
+		    this->databaseDirectory, shard));
+		if (!impl)
+			return {ReturnStatus::Result::Failure, "Shard " +
+			    Util::ts(shard) + ": SearchInterface "
+			    "implementation was null"};
+
+		const auto rs = impl->load(maxSize / numShards);
+		if (!rs)
+			return {rs.result, "Shard " + Util::ts(shard) +
+			    (rs.message ? ": " + *rs.message : "")};
+		shardImpls.push_back(impl);
+	}
+
+	this->shards = std::move(shardImpls);
+	this->identifiers = std::move(shardIdentifiers);
+	this->assignments = std::move(shardAssignments);
+
+	return {};
+}
+
+FRIF::ReturnStatus
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::reload(
+    const uint64_t maxSize)
+{
+	const auto numShards = static_cast<uint16_t>(this->shards.size());
+	for (uint16_t shard{0}; shard < numShards; ++shard) {
+		const auto rs = this->shards[shard]->reload(maxSize /
+		    numShards);
+		if (!rs)
+			return {rs.result, "Shard " + Util::ts(shard) +
+			    (rs.message ? ": " + *rs.message : "")};
+	}
+
+	return {};
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectPositionResult>>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    searchSubjectPosition(
+    const std::vector<std::byte> &probeTemplate,
+    const uint16_t maxCandidates)
+    const
+{
+	return (this->searchSubjectPosition(std::span<const std::byte>(
+	    probeTemplate), maxCandidates));
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectPositionResult>>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    searchSubjectPosition(
+    std::span<const std::byte> probeTemplate,
+    const uint16_t maxCandidates)
+    const
+{
+	return (mergeSearchResults(this->scatter(
+	    [&](const SearchInterface &shard, const uint16_t) {
+		return (shard.searchSubjectPosition(probeTemplate,
+		    maxCandidates));
+	    }), maxCandidates));
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectPositionResult>>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    searchSubjectPosition(
+    std::span<const std::byte> probeTemplate,
+    const uint16_t maxCandidates,
+    const SearchLimits &limits)
+    const
+{
+	return (mergeSearchResults(this->scatter(
+	    [&](const SearchInterface &shard, const uint16_t) {
+		return (shard.searchSubjectPosition(probeTemplate,
+		    maxCandidates, limits));
+	    }), maxCandidates));
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectResult>>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    searchSubject(
+    const std::vector<std::byte> &probeTemplate,
+    const uint16_t maxCandidates)
+    const
+{
+	return (this->searchSubject(std::span<const std::byte>(
+	    probeTemplate), maxCandidates));
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectResult>>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    searchSubject(
+    std::span<const std::byte> probeTemplate,
+    const uint16_t maxCandidates)
+    const
+{
+	return (mergeSearchResults(this->scatter(
+	    [&](const SearchInterface &shard, const uint16_t) {
+		return (shard.searchSubject(probeTemplate, maxCandidates));
+	    }), maxCandidates));
+}
+
+std::tuple<FRIF::ReturnStatus, std::optional<FRIF::SearchSubjectResult>>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    searchSubject(
+    std::span<const std::byte> probeTemplate,
+    const uint16_t maxCandidates,
+    const SearchLimits &limits)
+    const
+{
+	return (mergeSearchResults(this->scatter(
+	    [&](const SearchInterface &shard, const uint16_t) {
+		return (shard.searchSubject(probeTemplate, maxCandidates,
+		    limits));
+	    }), maxCandidates));
+}
+
+std::vector<std::tuple<FRIF::ReturnStatus,
+    std::optional<FRIF::SearchSubjectPositionResult>>>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    searchSubjectPositionBatch(
+    const std::vector<std::span<const std::byte>> &probeTemplates,
+    const uint16_t maxCandidates)
+    const
+{
+	return (mergeBatchResults(this->scatter(
+	    [&](const SearchInterface &shard, const uint16_t) {
+		return (shard.searchSubjectPositionBatch(probeTemplates,
+		    maxCandidates));
+	    }), probeTemplates.size(), maxCandidates));
+}
+
+std::vector<std::tuple<FRIF::ReturnStatus,
+    std::optional<FRIF::SearchSubjectResult>>>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    searchSubjectBatch(
+    const std::vector<std::span<const std::byte>> &probeTemplates,
+    const uint16_t maxCandidates)
+    const
+{
+	return (mergeBatchResults(this->scatter(
+	    [&](const SearchInterface &shard, const uint16_t) {
+		return (shard.searchSubjectBatch(probeTemplates,
+		    maxCandidates));
+	    }), probeTemplates.size(), maxCandidates));
+}
+
+std::optional<FRIF::SubjectPositionCandidateListCorrespondence>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    extractCorrespondenceSubjectPosition(
+    const std::vector<std::byte> &probeTemplate,
+    const SearchSubjectPositionResult &searchResult)
+    const
+{
+	return (this->extractCorrespondenceSubjectPosition(
+	    std::span<const std::byte>(probeTemplate), searchResult));
+}
+
+std::optional<FRIF::SubjectPositionCandidateListCorrespondence>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    extractCorrespondenceSubjectPosition(
+    std::span<const std::byte> probeTemplate,
+    const SearchSubjectPositionResult &searchResult)
+    const
+{
+	/* Ask each shard only about the candidates it returned */
+	std::vector<SearchSubjectPositionResult> perShard(this->shards.size(),
+	    SearchSubjectPositionResult{searchResult.decision, {}, {}});
+	for (const auto &[candidate, similarity] : searchResult.candidateList)
+		if (const auto id = this->identifiers.find(
+		    candidate.identifier); id)
+			perShard.at(this->assignments[*id]).candidateList.
+			    emplace(candidate, similarity);
+
+	return (mergeCorrespondence(this->scatter(
+	    [&](const SearchInterface &shard, const uint16_t index) ->
+	    std::optional<SubjectPositionCandidateListCorrespondence> {
+		if (perShard[index].candidateList.empty())
+			return (std::nullopt);
+		return (shard.extractCorrespondenceSubjectPosition(
+		    probeTemplate, perShard[index]));
+	    })));
+}
+
+std::optional<FRIF::SubjectCandidateListCorrespondence>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    extractCorrespondenceSubject(
+    const std::vector<std::byte> &probeTemplate,
+    const SearchSubjectResult &searchResult)
+    const
+{
+	return (this->extractCorrespondenceSubject(
+	    std::span<const std::byte>(probeTemplate), searchResult));
+}
+
+std::optional<FRIF::SubjectCandidateListCorrespondence>
+FRIF::Evaluations::Exemplar1N::Validation::ShardedSearchInterface::
+    extractCorrespondenceSubject(
+    std::span<const std::byte> probeTemplate,
+    const SearchSubjectResult &searchResult)
+    const
+{
+	/* Ask each shard only about the candidates it returned */
+	std::vector<SearchSubjectResult> perShard(this->shards.size(),
+	    SearchSubjectResult{searchResult.decision, {}, {}});
+	for (const auto &[identifier, similarity] : searchResult.candidateList)
+		if (const auto id = this->identifiers.find(identifier); id)
+			perShard.at(this->assignments[*id]).candidateList.
+			    emplace(identifier, similarity);
+
+	return (mergeCorrespondence(this->scatter(
+	    [&](const SearchInterface &shard, const uint16_t index) ->
+	    std::optional<SubjectCandidateListCorrespondence> {
+		if (perShard[index].candidateList.empty())
+			return (std::nullopt);
+		return (shard.extractCorrespondenceSubject(probeTemplate,
+		    perShard[index]));
+	    })));
+}
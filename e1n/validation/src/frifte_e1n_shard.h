@@ -0,0 +1,300 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#ifndef FRIF_E1N_SHARD_H_
+#define FRIF_E1N_SHARD_H_
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <frifte/e1n.h>
+
+namespace FRIF::Evaluations::Exemplar1N::Validation
+{
+	/** Prefix of each shard's directory within a sharded database. */
+	const std::string ShardDirPrefix{"shard-"};
+	/**
+	 * File within a sharded database whose lines are in the form
+	 * `identifier shard`.
+	 */
+	const std::string ShardAssignmentsName{"shard_assignments"};
+
+	/**
+	 * @brief
+	 * Obtain the directory of one shard of a sharded database.
+	 *
+	 * @param databaseDir
+	 * Directory containing all shards.
+	 * @param shard
+	 * Index of the shard.
+	 *
+	 * @return
+	 * Path to the directory of `shard`.
+	 */
+	std::filesystem::path
+	getShardDir(
+	    const std::filesystem::path &databaseDir,
+	    const uint16_t shard);
+
+	/**
+	 * @brief
+	 * Split a TemplateArchive into contiguous shards of similar size.
+	 *
+	 * @param archive
+	 * TemplateArchive to split.
+	 * @param numShards
+	 * Number of shards to create, or 0 to create the fewest shards whose
+	 * templates each fit in `maxSize` bytes.
+	 * @param maxSize
+	 * Maximum number of template bytes in each shard, or 0 for no limit.
+	 *
+	 * @return
+	 * One TemplateArchive per shard, written to a directory named with
+	 * ShardDirPrefix alongside `archive`.
+	 *
+	 * @throw
+	 * Error reading `archive`, a shard would be empty, a shard would
+	 * exceed `maxSize`, or error writing shards.
+	 */
+	std::vector<TemplateArchive>
+	splitTemplateArchive(
+	    const TemplateArchive &archive,
+	    const uint16_t numShards,
+	    const uint64_t maxSize);
+
+	/**
+	 * @brief
+	 * Record which shard holds each identifier.
+	 *
+	 * @param shards
+	 * TemplateArchive for each shard, as returned from
+	 * splitTemplateArchive().
+	 * @param databaseDir
+	 * Directory containing all shards, where ShardAssignmentsName will
+	 * be written.
+	 *
+	 * @throw
+	 * Error reading manifests or writing ShardAssignmentsName.
+	 */
+	void
+	writeShardAssignments(
+	    const std::vector<TemplateArchive> &shards,
+	    const std::filesystem::path &databaseDir);
+
+	/**
+	 * @brief
+	 * Combine results of searching each shard into one result.
+	 *
+	 * @param results
+	 * Result of searching each shard, in shard order.
+	 * @param maxCandidates
+	 * Maximum number of candidates in the combined candidate list.
+	 *
+	 * @return
+	 * The first failing ReturnStatus, or the `maxCandidates` most similar
+	 * candidates from all shards. Decisions are `true` if any shard's
+	 * decision was `true`, and termination is that of the first shard
+	 * that did not run to completion.
+	 */
+	std::tuple<ReturnStatus, std::optional<SearchSubjectPositionResult>>
+	mergeSearchResults(
+	    const std::vector<std::tuple<ReturnStatus,
+	        std::optional<SearchSubjectPositionResult>>> &results,
+	    const uint16_t maxCandidates);
+
+	/**
+	 * @brief
+	 * Combine results of searching each shard into one result.
+	 *
+	 * @param results
+	 * Result of searching each shard, in shard order.
+	 * @param maxCandidates
+	 * Maximum number of candidates in the combined candidate list.
+	 *
+	 * @return
+	 * The first failing ReturnStatus, or the `maxCandidates` most similar
+	 * candidates from all shards. Decisions are `true` if any shard's
+	 * decision was `true`, and termination is that of the first shard
+	 * that did not run to completion.
+	 */
+	std::tuple<ReturnStatus, std::optional<SearchSubjectResult>>
+	mergeSearchResults(
+	    const std::vector<std::tuple<ReturnStatus,
+	        std::optional<SearchSubjectResult>>> &results,
+	    const uint16_t maxCandidates);
+
+	/**
+	 * @brief
+	 * SearchInterface that scatters each call to one SearchInterface per
+	 * shard of a sharded database and gathers the results.
+	 *
+	 * @note
+	 * Shards are searched in parallel only if the implementation sets
+	 * SearchInterface::Compatibility::supportsConcurrentSearch, and
+	 * sequentially otherwise.
+	 */
+	class ShardedSearchInterface : public SearchInterface
+	{
+	public:
+		ReturnStatus
+		load(
+		    const uint64_t maxSize)
+		    override;
+
+		ReturnStatus
+		reload(
+		    const uint64_t maxSize)
+		    override;
+
+		std::tuple<ReturnStatus,
+		    std::optional<SearchSubjectPositionResult>>
+		searchSubjectPosition(
+		    const std::vector<std::byte> &probeTemplate,
+		    const uint16_t maxCandidates)
+		    const
+		    override;
+
+		std::tuple<ReturnStatus,
+		    std::optional<SearchSubjectPositionResult>>
+		searchSubjectPosition(
+		    std::span<const std::byte> probeTemplate,
+		    const uint16_t maxCandidates)
+		    const
+		    override;
+
+		std::tuple<ReturnStatus,
+		    std::optional<SearchSubjectPositionResult>>
+		searchSubjectPosition(
+		    std::span<const std::byte> probeTemplate,
+		    const uint16_t maxCandidates,
+		    const SearchLimits &limits)
+		    const
+		    override;
+
+		std::tuple<ReturnStatus, std::optional<SearchSubjectResult>>
+		searchSubject(
+		    const std::vector<std::byte> &probeTemplate,
+		    const uint16_t maxCandidates)
+		    const
+		    override;
+
+		std::tuple<ReturnStatus, std::optional<SearchSubjectResult>>
+		searchSubject(
+		    std::span<const std::byte> probeTemplate,
+		    const uint16_t maxCandidates)
+		    const
+		    override;
+
+		std::tuple<ReturnStatus, std::optional<SearchSubjectResult>>
+		searchSubject(
+		    std::span<const std::byte> probeTemplate,
+		    const uint16_t maxCandidates,
+		    const SearchLimits &limits)
+		    const
+		    override;
+
+		std::vector<std::tuple<ReturnStatus,
+		    std::optional<SearchSubjectPositionResult>>>
+		searchSubjectPositionBatch(
+		    const std::vector<std::span<const std::byte>>
+		        &probeTemplates,
+		    const uint16_t maxCandidates)
+		    const
+		    override;
+
+		std::vector<std::tuple<ReturnStatus,
+		    std::optional<SearchSubjectResult>>>
+		searchSubjectBatch(
+		    const std::vector<std::span<const std::byte>>
+		        &probeTemplates,
+		    const uint16_t maxCandidates)
+		    const
+		    override;
+
+		std::optional<SubjectPositionCandidateListCorrespondence>
+		extractCorrespondenceSubjectPosition(
+		    const std::vector<std::byte> &probeTemplate,
+		    const SearchSubjectPositionResult &searchResult)
+		    const
+		    override;
+
+		std::optional<SubjectPositionCandidateListCorrespondence>
+		extractCorrespondenceSubjectPosition(
+		    std::span<const std::byte> probeTemplate,
+		    const SearchSubjectPositionResult &searchResult)
+		    const
+		    override;
+
+		std::optional<SubjectCandidateListCorrespondence>
+		extractCorrespondenceSubject(
+		    const std::vector<std::byte> &probeTemplate,
+		    const SearchSubjectResult &searchResult)
+		    const
+		    override;
+
+		std::optional<SubjectCandidateListCorrespondence>
+		extractCorrespondenceSubject(
+		    std::span<const std::byte> probeTemplate,
+		    const SearchSubjectResult &searchResult)
+		    const
+		    override;
+
+		/**
+		 * @brief
+		 * ShardedSearchInterface constructor.
+		 *
+		 * @param configurationDirectory
+		 * Configuration directory passed to each shard's
+		 * SearchInterface.
+		 * @param databaseDirectory
+		 * Directory containing ShardAssignmentsName and one
+		 * directory per shard.
+		 */
+		ShardedSearchInterface(
+		    const std::filesystem::path &configurationDirectory,
+		    const std::filesystem::path &databaseDirectory);
+
+	private:
+		/**
+		 * @brief
+		 * Call a function with each shard's SearchInterface.
+		 *
+		 * @param fn
+		 * Function to call with a const SearchInterface.
+		 *
+		 * @return
+		 * Value returned from `fn` for each shard, in shard order.
+		 */
+		template<typename Fn>
+		auto
+		scatter(
+		    Fn fn)
+		    const;
+
+		const std::filesystem::path configurationDirectory{};
+		const std::filesystem::path databaseDirectory{};
+		/** Whether shards may be searched at the same time. */
+		const bool concurrent{};
+
+		/** SearchInterface for each shard, in shard order. */
+		std::vector<std::shared_ptr<SearchInterface>> shards{};
+		/** SubjectID of each identifier in any shard. */
+		SubjectIdentifierDictionary identifiers{};
+		/** Shard holding each SubjectID, indexed by SubjectID. */
+		std::vector<uint16_t> assignments{};
+	};
+}
+
+#endif /* FRIF_E1N_SHARD_H_ */
@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <exception>
 #include <fstream>
 #include <iostream>
 #include <random>
@@ -18,6 +19,7 @@
 #include <stdexcept>
 #include <thread>
 #include <tuple>
+#include <unordered_map>
 
 #include <getopt.h>
 #include <sys/wait.h>
@@ -27,8 +29,244 @@
 #include <frifte/util.h>
 
 #include "frifte_e1n_data.h"
+#include "frifte_e1n_latency.h"
+#include "frifte_e1n_shard.h"
 #include "frifte_e1n_validation.h"
 
+void
+FRIF::Evaluations::Exemplar1N::Validation::asyncSearch(
+    std::shared_ptr<SearchInterface> impl,
+    const Data::Dataset &dataset,
+    const ClaimFunction &claim,
+    const Arguments &args,
+    const std::function<void(const std::vector<std::pair<std::string,
+        std::optional<std::string>>>&)> &logFn)
+{
+	/* Checked in parseArguments */
+	const uint16_t maxCandidates = static_cast<uint16_t>(args.maximum);
+
+	/* Probe templates must outlive their search */
+	struct InFlightSearch
+	{
+		uint64_t datasetIndex{};
+		Util::FileContents probe;
+		std::chrono::steady_clock::time_point start{};
+	};
+	std::unordered_map<SearchTicket, InFlightSearch> inFlight{};
+
+	/* Searches stay in flight while the next chunk is claimed */
+	std::vector<uint64_t> claimed{claim()};
+	auto next = claimed.cbegin();
+	while ((next != claimed.cend()) || !inFlight.empty()) {
+		/* Fill the queue */
+		while ((inFlight.size() < args.queueDepth) &&
+		    (next != claimed.cend())) {
+			auto probe = readProbeTemplate(dataset, *next, args);
+
+			SearchTicket ticket{};
+			const auto start = std::chrono::steady_clock::now();
+			try {
+				if (args.operation == Operation::SearchSubject)
+					ticket = impl->submitSearchSubject(
+					    probe.data, maxCandidates);
+				else
+					ticket = impl->
+					    submitSearchSubjectPosition(
+					    probe.data, maxCandidates);
+			} catch (const std::exception &e) {
+				throw std::runtime_error{"Exception from "
+				    "submitting search (max = " +
+				    std::to_string(maxCandidates) + "): " +
+				    e.what()};
+			} catch (...) {
+				throw std::runtime_error{"Unknown exception "
+				    "from submitting search (max = " +
+				    std::to_string(maxCandidates) + ")"};
+			}
+
+			if (!inFlight.emplace(ticket, InFlightSearch{*next,
+			    std::move(probe), start}).second)
+				throw std::runtime_error{"Search ticket " +
+				    Util::ts(ticket) + " was issued while "
+				    "already in flight"};
+			if (++next == claimed.cend()) {
+				claimed = claim();
+				next = claimed.cbegin();
+			}
+		}
+
+		/* Drain completed searches */
+		std::vector<SearchCompletion> completions{};
+		try {
+			completions = impl->completeSearches(true);
+		} catch (const std::exception &e) {
+			throw std::runtime_error{"Exception from "
+			    "completeSearches(): " + std::string{e.what()}};
+		} catch (...) {
+			throw std::runtime_error{"Unknown exception from "
+			    "completeSearches()"};
+		}
+		const auto stop = std::chrono::steady_clock::now();
+
+		if (completions.empty())
+			throw std::runtime_error{"completeSearches() returned "
+			    "no results while waiting on " +
+			    Util::ts(inFlight.size()) + " searches"};
+
+		std::vector<std::pair<std::string, std::optional<std::string>>>
+		    logLines{};
+		logLines.reserve(completions.size());
+		for (const auto &completion : completions) {
+			const auto it = inFlight.find(completion.ticket);
+			if (it == inFlight.end())
+				throw std::runtime_error{"completeSearches() "
+				    "returned unknown ticket " +
+				    Util::ts(completion.ticket)};
+
+			const auto &search = it->second;
+			recordLatency("search", std::get<std::string>(dataset),
+			    search.start, stop, args);
+			logLines.push_back(makeSearchLogLine(impl, dataset,
+			    search.datasetIndex, search.probe.data,
+			    search.start, stop, {}, completion.status,
+			    completion.result, 1, args));
+			inFlight.erase(it);
+		}
+
+		logFn(logLines);
+	}
+}
+
+std::vector<std::pair<std::string, std::optional<std::string>>>
+FRIF::Evaluations::Exemplar1N::Validation::batchCreateTemplate(
+    std::shared_ptr<ExtractionInterface> impl,
+    const Data::Dataset &dataset,
+    const std::vector<uint64_t> &datasetIndices,
+    const Arguments &args)
+{
+	const std::string &datasetName{std::get<std::string>(dataset)};
+
+	std::vector<std::tuple<std::string, std::vector<Sample>>> jobs{};
+	jobs.reserve(datasetIndices.size());
+	for (const auto &n : datasetIndices) {
+		const auto &[identifier, metadatas] =
+		    std::get<std::vector<Data::ImageSet>>(dataset).at(n);
+		try {
+			jobs.emplace_back(identifier, makeSamples(metadatas,
+			    args));
+		} catch (const std::exception &e) {
+			throw std::runtime_error{"Exception while creating "
+			    "samples from ID = " + identifier + ",  dataset "
+			    "= " + datasetName + ", index = " + Util::ts(n) +
+			    " (" + e.what() + ")"};
+		}
+	}
+
+	std::vector<std::tuple<ReturnStatus,
+	    std::optional<CreateTemplateResult>>> ret{};
+	std::chrono::steady_clock::time_point start{}, stop{};
+	startPerfCounters(args.perfCounters);
+	try {
+		start = std::chrono::steady_clock::now();
+		ret = impl->createTemplateBatch(*args.templateType, jobs);
+		stop = std::chrono::steady_clock::now();
+	} catch (const std::exception &e) {
+		throw std::runtime_error{"Exception while creating batch of " +
+		    Util::ts(jobs.size()) + " templates starting with ID = " +
+		    std::get<std::string>(jobs.front()) + ",  dataset = " +
+		    datasetName + " (" + e.what() + ")"};
+	} catch (...) {
+		throw std::runtime_error{"Unknown exception while creating "
+		    "batch of " + Util::ts(jobs.size()) + " templates starting "
+		    "with ID = " + std::get<std::string>(jobs.front()) +
+		    ",  dataset = " + datasetName};
+	}
+	const auto counts = stopPerfCounters(args.perfCounters);
+
+	recordLatency("createTemplateBatch", datasetName, start, stop, args);
+
+	if (ret.size() != jobs.size())
+		throw std::runtime_error{"createTemplateBatch() returned " +
+		    Util::ts(ret.size()) + " results for " +
+		    Util::ts(jobs.size()) + " jobs"};
+
+	std::vector<std::pair<std::string, std::optional<std::string>>>
+	    logLines{};
+	logLines.reserve(jobs.size());
+	for (std::vector<uint64_t>::size_type i{0}; i < jobs.size(); ++i) {
+		auto arena = makeRequestArena();
+		const auto &[rv, ctr] = ret[i];
+		const std::tuple<ReturnStatus,
+		    std::optional<pmr::CreateTemplateResult>> result{rv, ctr ?
+		    std::make_optional<pmr::CreateTemplateResult>(*ctr,
+		    &arena) : std::nullopt};
+
+		logLines.push_back(makeCreateTemplateLogLine(impl, dataset,
+		    datasetIndices[i], start, stop, counts,
+		    std::get<std::vector<Sample>>(jobs[i]).size(), result,
+		    jobs.size(), args));
+	}
+
+	return (logLines);
+}
+
+std::vector<std::pair<std::string, std::optional<std::string>>>
+FRIF::Evaluations::Exemplar1N::Validation::batchSearch(
+    std::shared_ptr<SearchInterface> impl,
+    const Data::Dataset &dataset,
+    const std::vector<uint64_t> &datasetIndices,
+    const Arguments &args)
+{
+	/* Views into contents, which stay mapped until logged */
+	std::vector<Util::FileContents> contents{};
+	std::vector<std::span<const std::byte>> probes{};
+	contents.reserve(datasetIndices.size());
+	probes.reserve(datasetIndices.size());
+	for (const auto &n : datasetIndices) {
+		contents.push_back(readProbeTemplate(dataset, n, args));
+		probes.push_back(contents.back().data);
+	}
+
+	/* Checked in parseArguments */
+	const uint16_t maxCandidates = static_cast<uint16_t>(args.maximum);
+
+	std::vector<std::pair<std::string, std::optional<std::string>>>
+	    logLines{};
+	logLines.reserve(datasetIndices.size());
+	if (args.operation == Operation::SearchSubject) {
+		const auto [start, stop, counts, results] =
+		    executeBatchSearchSubject(impl, probes, maxCandidates,
+		    args.perfCounters);
+		recordLatency("searchBatch", std::get<std::string>(dataset),
+		    start, stop, args);
+		for (std::vector<uint64_t>::size_type i{0};
+		    i < datasetIndices.size(); ++i)
+			logLines.push_back(makeSearchLogLine(impl, dataset,
+			    datasetIndices[i], probes[i], start, stop,
+			    counts, std::get<ReturnStatus>(results[i]),
+			    std::get<std::optional<SearchSubjectResult>>(
+			    results[i]), datasetIndices.size(), args));
+	} else if (args.operation == Operation::SearchSubjectPosition) {
+		const auto [start, stop, counts, results] =
+		    executeBatchSearchSubjectPosition(impl, probes,
+		    maxCandidates, args.perfCounters);
+		recordLatency("searchBatch", std::get<std::string>(dataset),
+		    start, stop, args);
+		for (std::vector<uint64_t>::size_type i{0};
+		    i < datasetIndices.size(); ++i)
+			logLines.push_back(makeSearchLogLine(impl, dataset,
+			    datasetIndices[i], probes[i], start, stop,
+			    counts, std::get<ReturnStatus>(results[i]),
+			    std::get<std::optional<
+			    SearchSubjectPositionResult>>(results[i]),
+			    datasetIndices.size(), args));
+	} else
+		throw std::runtime_error{"Unsupported operation sent to "
+		    "batchSearch()"};
+
+	return (logLines);
+}
+
 void
 FRIF::Evaluations::Exemplar1N::Validation::dispatchCreateTemplates(
     const Arguments &args)
@@ -65,9 +303,39 @@ FRIF::Evaluations::Exemplar1N::Validation::dispatchCreateTemplates(
 		    std::get<std::vector<Data::ImageSet>>(
 		    dataset).size(), args.randomSeed);
 
-		forkOperation(args, dataset, indices,
+		/* Mapped before forking so that children share pages */
+		Arguments argsOverride{args};
+		if (args.packedImages)
+			argsOverride.imagePack =
+			    std::make_shared<const Data::ImagePack>(
+			    args.imageDir / (std::get<std::string>(dataset) +
+			    Data::ImagePackSuffix));
+
+		forkOperation(argsOverride, dataset, indices,
 		    &runPartialCreateTemplates);
 	}
+
+	writeLatencyLogs(args, false);
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::dispatchPackImages(
+    const Arguments &args)
+{
+	if (args.operation && !(*args.operation == Operation::PackImages))
+		throw std::runtime_error{"Unsupported operation was sent to "
+		    "dispatchPackImages()"};
+
+	std::vector<std::string> names(Data::ProbeNames.cbegin(),
+	    Data::ProbeNames.cend());
+	names.insert(names.cend(), Data::ReferenceNames.cbegin(),
+	    Data::ReferenceNames.cend());
+	for (const auto &name : names) {
+		const std::string csvName{name + ".csv"};
+		Data::writeImagePack(Data::readCSV(args.imageDir / csvName),
+		    args.imageDir, args.imageDir / (name +
+		    Data::ImagePackSuffix));
+	}
 }
 
 void
@@ -79,6 +347,10 @@ FRIF::Evaluations::Exemplar1N::Validation::dispatchCreateDatabases(
 		throw std::runtime_error{"Unsupported operation was sent to "
 		    "dispatchCreateDatabases()"};
 
+	/* Opened first, so threads the implementation creates count */
+	if (args.perfCounters)
+		getPerfCounters();
+
 	auto iv = instantiateImplementation(args);
 	std::shared_ptr<ExtractionInterface> impl{};
 	if (!std::get_if<std::shared_ptr<ExtractionInterface>>(&iv))
@@ -91,6 +363,8 @@ FRIF::Evaluations::Exemplar1N::Validation::dispatchCreateDatabases(
 
 	for (const auto &datasetName : Data::ReferenceNames)
 		singleCreateDatabase(impl, datasetName, args);
+
+	writeLatencyLogs(args, false);
 }
 
 void
@@ -124,25 +398,33 @@ FRIF::Evaluations::Exemplar1N::Validation::dispatchSearch(
 
 		forkOperation(argsOverride, probes, indices, &runPartialSearch);
 	}
+
+	writeLatencyLogs(args, false);
 }
 
 std::tuple<std::chrono::steady_clock::time_point,
-    std::chrono::steady_clock::time_point, FRIF::ReturnStatus,
+    std::chrono::steady_clock::time_point,
+    FRIF::Util::PerfCounters::Counts, FRIF::ReturnStatus,
     std::optional<FRIF::SearchSubjectResult>>
 FRIF::Evaluations::Exemplar1N::Validation::executeSingleSearchSubject(
     std::shared_ptr<SearchInterface> impl,
-    const std::vector<std::byte> &probe,
-    const uint16_t maxCandidates)
+    std::span<const std::byte> probe,
+    const uint16_t maxCandidates,
+    const std::optional<std::chrono::milliseconds> &timeLimit,
+    const std::optional<double> &minSimilarity,
+    const bool countEvents)
 {
 	std::chrono::steady_clock::time_point start{}, stop{};
+	std::tuple<ReturnStatus, std::optional<SearchSubjectResult>> ret{};
+	startPerfCounters(countEvents);
 	try {
 		start = std::chrono::steady_clock::now();
-		const auto ret = impl->searchSubject(probe,
-		    maxCandidates);
+		ret = (timeLimit || minSimilarity) ?
+		    impl->searchSubject(probe, maxCandidates,
+		    SearchLimits{timeLimit ? std::optional{start + *timeLimit} :
+		    std::nullopt, minSimilarity}) :
+		    impl->searchSubject(probe, maxCandidates);
 		stop = std::chrono::steady_clock::now();
-
-		return {start, stop, std::get<ReturnStatus>(ret),
-		    std::get<std::optional<FRIF::SearchSubjectResult>>(ret)};
 	} catch (const std::exception &e) {
 		throw std::runtime_error{"Exception from searchSubject(max = " +
 		    std::to_string(maxCandidates) + "): " + e.what()};
@@ -150,26 +432,36 @@ FRIF::Evaluations::Exemplar1N::Validation::executeSingleSearchSubject(
 		throw std::runtime_error{"Unknown exception from searchSubject("
 		    "max = " + std::to_string(maxCandidates) + ")"};
 	}
+	const auto counts = stopPerfCounters(countEvents);
+
+	return {start, stop, counts, std::get<ReturnStatus>(ret),
+	    std::get<std::optional<SearchSubjectResult>>(ret)};
 }
 
 std::tuple<std::chrono::steady_clock::time_point,
-    std::chrono::steady_clock::time_point, FRIF::ReturnStatus,
+    std::chrono::steady_clock::time_point,
+    FRIF::Util::PerfCounters::Counts, FRIF::ReturnStatus,
     std::optional<FRIF::SearchSubjectPositionResult>>
 FRIF::Evaluations::Exemplar1N::Validation::executeSingleSearchSubjectPosition(
     std::shared_ptr<SearchInterface> impl,
-    const std::vector<std::byte> &probe,
-    const uint16_t maxCandidates)
+    std::span<const std::byte> probe,
+    const uint16_t maxCandidates,
+    const std::optional<std::chrono::milliseconds> &timeLimit,
+    const std::optional<double> &minSimilarity,
+    const bool countEvents)
 {
 	std::chrono::steady_clock::time_point start{}, stop{};
+	std::tuple<ReturnStatus, std::optional<SearchSubjectPositionResult>>
+	    ret{};
+	startPerfCounters(countEvents);
 	try {
 		start = std::chrono::steady_clock::now();
-		const auto ret = impl->searchSubjectPosition(probe,
-		    maxCandidates);
+		ret = (timeLimit || minSimilarity) ?
+		    impl->searchSubjectPosition(probe, maxCandidates,
+		    SearchLimits{timeLimit ? std::optional{start + *timeLimit} :
+		    std::nullopt, minSimilarity}) :
+		    impl->searchSubjectPosition(probe, maxCandidates);
 		stop = std::chrono::steady_clock::now();
-
-		return {start, stop, std::get<ReturnStatus>(ret),
-		    std::get<std::optional<FRIF::SearchSubjectPositionResult>>(
-		    ret)};
 	} catch (const std::exception &e) {
 		throw std::runtime_error{"Exception from searchSubjectPosition("
 		    "max = " +  std::to_string(maxCandidates) + "): " +
@@ -178,6 +470,90 @@ FRIF::Evaluations::Exemplar1N::Validation::executeSingleSearchSubjectPosition(
 		throw std::runtime_error{"Unknown exception from searchSubject"
 		    "Position(max = " + std::to_string(maxCandidates) + ")"};
 	}
+	const auto counts = stopPerfCounters(countEvents);
+
+	return {start, stop, counts, std::get<ReturnStatus>(ret),
+	    std::get<std::optional<SearchSubjectPositionResult>>(ret)};
+}
+
+std::tuple<std::chrono::steady_clock::time_point,
+    std::chrono::steady_clock::time_point,
+    FRIF::Util::PerfCounters::Counts,
+    std::vector<std::tuple<FRIF::ReturnStatus,
+    std::optional<FRIF::SearchSubjectResult>>>>
+FRIF::Evaluations::Exemplar1N::Validation::executeBatchSearchSubject(
+    std::shared_ptr<SearchInterface> impl,
+    const std::vector<std::span<const std::byte>> &probes,
+    const uint16_t maxCandidates,
+    const bool countEvents)
+{
+	std::chrono::steady_clock::time_point start{}, stop{};
+	std::vector<std::tuple<ReturnStatus,
+	    std::optional<SearchSubjectResult>>> ret{};
+	startPerfCounters(countEvents);
+	try {
+		start = std::chrono::steady_clock::now();
+		ret = impl->searchSubjectBatch(probes, maxCandidates);
+		stop = std::chrono::steady_clock::now();
+	} catch (const std::exception &e) {
+		throw std::runtime_error{"Exception from searchSubjectBatch("
+		    "num_probes = " + std::to_string(probes.size()) + ", "
+		    "max = " + std::to_string(maxCandidates) + "): " +
+		    e.what()};
+	} catch (...) {
+		throw std::runtime_error{"Unknown exception from "
+		    "searchSubjectBatch(num_probes = " +
+		    std::to_string(probes.size()) + ", max = " +
+		    std::to_string(maxCandidates) + ")"};
+	}
+	const auto counts = stopPerfCounters(countEvents);
+
+	if (ret.size() != probes.size())
+		throw std::runtime_error{"searchSubjectBatch() returned " +
+		    std::to_string(ret.size()) + " results for " +
+		    std::to_string(probes.size()) + " probes"};
+
+	return {start, stop, counts, ret};
+}
+
+std::tuple<std::chrono::steady_clock::time_point,
+    std::chrono::steady_clock::time_point,
+    FRIF::Util::PerfCounters::Counts,
+    std::vector<std::tuple<FRIF::ReturnStatus,
+    std::optional<FRIF::SearchSubjectPositionResult>>>>
+FRIF::Evaluations::Exemplar1N::Validation::executeBatchSearchSubjectPosition(
+    std::shared_ptr<SearchInterface> impl,
+    const std::vector<std::span<const std::byte>> &probes,
+    const uint16_t maxCandidates,
+    const bool countEvents)
+{
+	std::chrono::steady_clock::time_point start{}, stop{};
+	std::vector<std::tuple<ReturnStatus,
+	    std::optional<SearchSubjectPositionResult>>> ret{};
+	startPerfCounters(countEvents);
+	try {
+		start = std::chrono::steady_clock::now();
+		ret = impl->searchSubjectPositionBatch(probes, maxCandidates);
+		stop = std::chrono::steady_clock::now();
+	} catch (const std::exception &e) {
+		throw std::runtime_error{"Exception from searchSubjectPosition"
+		    "Batch(num_probes = " + std::to_string(probes.size()) +
+		    ", max = " + std::to_string(maxCandidates) + "): " +
+		    e.what()};
+	} catch (...) {
+		throw std::runtime_error{"Unknown exception from "
+		    "searchSubjectPositionBatch(num_probes = " +
+		    std::to_string(probes.size()) + ", max = " +
+		    std::to_string(maxCandidates) + ")"};
+	}
+	const auto counts = stopPerfCounters(countEvents);
+
+	if (ret.size() != probes.size())
+		throw std::runtime_error{"searchSubjectPositionBatch() "
+		    "returned " + std::to_string(ret.size()) + " results for " +
+		    std::to_string(probes.size()) + " probes"};
+
+	return {start, stop, counts, ret};
 }
 
 void
@@ -188,20 +564,81 @@ FRIF::Evaluations::Exemplar1N::Validation::forkOperation(
     const std::function<void(InterfaceVariant, const Data::Dataset&,
         const std::vector<uint64_t>&, const Arguments&)> &fn)
 {
+	/* Workers log how long startup took */
+	Arguments workerArgs{args};
+	workerArgs.loadStart = std::chrono::steady_clock::now();
+	/* Opened first, so threads the implementation creates count */
+	if (args.perfCounters)
+		getPerfCounters();
 	auto impl = instantiateImplementation(args);
+	workerArgs.loadStop = std::chrono::steady_clock::now();
+
+	const bool logMemory{(args.operation == Operation::SearchSubject) ||
+	    (args.operation == Operation::SearchSubjectPosition)};
+
+	/*
+	 * Overlapping calls cannot be told apart, so count the whole run.
+	 * Every worker, prefetcher, and search in flight starts after the
+	 * counters were opened above, and so is counted.
+	 */
+	const bool countRun{args.perfCounters && ((args.numThreads > 1) ||
+	    (args.prefetchDepth > 0) || (args.queueDepth > 0))};
+	if (countRun) {
+		workerArgs.perfCounters = false;
+		getPerfCounters().start();
+	}
+
+	/* Workers claim chunks of whole batches until none remain */
+	const uint64_t numWorkers{std::max(args.numProcs, args.numThreads)};
+	const uint64_t numBatches{(indices.size() + args.batchSize - 1) /
+	    args.batchSize};
+	const uint64_t batchesPerChunk{std::max<uint64_t>(1,
+	    numBatches / (numWorkers * ChunksPerWorker))};
+	workerArgs.workQueue = std::make_shared<Util::WorkQueue>(
+	    indices.size(), batchesPerChunk * args.batchSize);
+
+	if (args.numThreads > 1) {
+		threadOperation(impl, workerArgs, dataset, indices, fn);
+		if (countRun)
+			writePerfCountersLog(args, dataset, indices.size(),
+			    getPerfCounters().stop());
+		if (logMemory)
+			writeMemoryLog(args, dataset, "thread",
+			    args.numThreads);
+		return;
+	}
 
 	if (args.numProcs == 1) {
-		fn(impl, dataset, indices, args);
+		fn(impl, dataset, indices, workerArgs);
+		if (countRun)
+			writePerfCountersLog(args, dataset, indices.size(),
+			    getPerfCounters().stop());
+		if (logMemory)
+			writeMemoryLog(args, dataset, "single", 1);
 		return;
 	}
 
-	const auto splits = Util::splitSet(indices, args.numProcs);
-	for (const auto &split : splits) {
+	std::vector<pid_t> children{};
+	children.reserve(args.numProcs);
+	for (uint8_t i{0}; i < args.numProcs; ++i) {
 		const auto pid = fork();
 		switch (pid) {
 		case 0:		/* Child */
 			try {
-				fn(impl, dataset, split, args);
+				/* Reopened before the implementation runs */
+				if (workerArgs.perfCounters)
+					getPerfCounters();
+
+				/* Only this child's latencies, for merging */
+				Arguments childArgs{workerArgs};
+				childArgs.latencies =
+				    std::make_shared<LatencyRecorder>();
+
+				fn(impl, dataset, indices, childArgs);
+				writeLatencyLogs(childArgs, true);
+				if (logMemory)
+					writeMemoryLog(args, dataset, "fork",
+					    args.numProcs);
 			} catch (const std::exception &e) {
 				std::cerr << e.what() << '\n';
 				std::exit(EXIT_FAILURE);
@@ -214,12 +651,27 @@ FRIF::Evaluations::Exemplar1N::Validation::forkOperation(
 		case -1:	/* Error */
 			throw std::runtime_error{"Error during fork()"};
 		default:	/* Parent */
+			children.push_back(pid);
 			break;
 		}
 	}
 
 	/* Parent only */
 	waitForExit(args.numProcs);
+	/* Exited children's counts were added to the parent's */
+	if (countRun)
+		writePerfCountersLog(args, dataset, indices.size(),
+		    getPerfCounters().stop());
+
+	/* Children that failed wrote no histograms */
+	for (const auto &child : children) {
+		const auto histogramPath = getLatencyHistogramPath(
+		    args.outputDir, child);
+		if (!std::filesystem::exists(histogramPath))
+			continue;
+		args.latencies->merge(histogramPath);
+		std::filesystem::remove(histogramPath);
+	}
 }
 
 int
@@ -267,6 +719,18 @@ FRIF::Evaluations::Exemplar1N::Validation::dispatchOperation(
 			    "exception\n";
 		}
 		break;
+	case Operation::PackImages:
+		try {
+			dispatchPackImages(args);
+			rv = EXIT_SUCCESS;
+		} catch (const std::exception &e) {
+			std::cerr << "dispatchPackImages(): " <<
+			    e.what() << '\n';
+		} catch (...) {
+			std::cerr << "dispatchPackImages(): Non-standard "
+			    "exception\n";
+		}
+		break;
 	case Operation::Usage:
 		std::cout << getUsageString(args.executableName) << '\n';
 		rv = EXIT_SUCCESS;
@@ -333,6 +797,9 @@ FRIF::Evaluations::Exemplar1N::Validation::
 	    "Exemplar Feature Extraction Algorithm Supports Reference Template "
 	    "Introspection? = " << std::boolalpha <<
 	    compat.supportsReferenceTemplateIntrospection << '\n' <<
+	    "Exemplar Feature Extraction Algorithm Supports Incremental "
+	    "Reference Database? = " << std::boolalpha <<
+	    compat.supportsIncrementalReferenceDatabase << '\n' <<
 	    "Exemplar Feature Extraction Algorithm Supported Probe Template "
 	    "Versions = ";
 	if (!compat.probeTemplateVersions.contains(thisVersion))
@@ -434,6 +901,12 @@ FRIF::Evaluations::Exemplar1N::Validation::
 
 	ss << "Search Algorithm Supports Correspondence? = " << std::boolalpha <<
 	    compat.supportsCorrespondence << '\n' <<
+	    "Search Algorithm Supports Concurrent Search? = " <<
+	    compat.supportsConcurrentSearch << '\n' <<
+	    "Search Algorithm Supports Reload? = " <<
+	    compat.supportsReload << '\n' <<
+	    "Search Algorithm Supports Search Limits? = " <<
+	    compat.supportsSearchLimits << '\n' <<
 	    "Search Algorithm Supported Probe Template Versions = ";
 	if (!compat.probeTemplateVersions.contains(thisVersion))
 		ss << "0x" << std::setw(4) << std::hex << std::setfill('0') <<
@@ -495,6 +968,46 @@ FRIF::Evaluations::Exemplar1N::Validation::
 	return (ss.str());
 }
 
+std::filesystem::path
+FRIF::Evaluations::Exemplar1N::Validation::getLatencyHistogramPath(
+    const std::filesystem::path &outputDir,
+    const pid_t pid)
+{
+	return (outputDir / ("latency-" + Util::ts(pid) + ".hist"));
+}
+
+FRIF::Util::PerfCounters&
+FRIF::Evaluations::Exemplar1N::Validation::getPerfCounters()
+{
+	/*
+	 * Counters count the thread that opened them and threads it creates
+	 * afterwards, not a forked copy.
+	 */
+	thread_local std::unique_ptr<Util::PerfCounters> counters{};
+	thread_local pid_t owner{};
+
+	if (!counters || (owner != getpid())) {
+		counters = std::make_unique<Util::PerfCounters>();
+		owner = getpid();
+	}
+
+	return (*counters);
+}
+
+std::string
+FRIF::Evaluations::Exemplar1N::Validation::getPerfCountersHeader(
+    const Arguments &args)
+{
+	if (!args.perfCounters)
+		return {};
+
+	std::string header{};
+	for (const auto &event : Util::PerfCounters::Events)
+		header += ',' + Util::PerfCounters::getName(event);
+
+	return (header);
+}
+
 std::string
 FRIF::Evaluations::Exemplar1N::Validation::getUsageString(
     const std::string &name)
@@ -511,29 +1024,53 @@ FRIF::Evaluations::Exemplar1N::Validation::getUsageString(
 
 	s += "\n\n";
 
+	s += prefix + "# Pack Images of Each Dataset\n" +
+	    prefix + "-p [-I <image_dir>]";
+
+	s += "\n\n";
+
 	s += prefix + "# Create Probe Templates + Extract Data\n" +
 	    prefix + "-e p -z <config_dir> [-r <random_seed> -o <output_dir> "
-	    "-I <image_dir>\n" + prefix + "-j <num_processes>]\n";
+	    "-I <image_dir>\n" + prefix + "{-P | -f <prefetch_depth>} "
+	    "-j <num_processes> -b <batch_size> -C]\n";
 	s += prefix + "# Create Reference Templates + Extract Data\n" +
 	    prefix + "-e r -z <config_dir> [-r <random_seed> -o <output_dir> "
-	    "-I <image_dir>\n" + prefix + "-j <num_processes>]";
+	    "-I <image_dir>\n" + prefix + "{-P | -f <prefetch_depth>} "
+	    "-j <num_processes> -b <batch_size> -C]";
 
 	s += "\n\n";
 
 	s += prefix + "# Create Enrollment Databases\n" +
-	    prefix + "-c -z <config_dir> [-d <database_dir> -o <output_dir>]";
+	    prefix + "-c -z <config_dir> [-d <database_dir> -o <output_dir>\n" +
+	    prefix + "-m <max_size> {-k <num_shards> | -u} -C]";
 
 	s += "\n\n";
 
 	s += prefix + "# Search, returning subject ID + extract "
 	    "correspondence\n" +
 	    prefix + "-s s -z <config_dir> [-d <database_dir> -o "
-	    "<output_dir>\n" + prefix + "-j <num_processes>]\n";
+	    "<output_dir>\n" + prefix + "-l <load_budget> "
+	    "-f <prefetch_depth> -C {-j <num_processes> | -t <num_threads>}\n" +
+	    prefix +
+	    "{-b <batch_size> | -a <num_in_flight> | "
+	    "-L <time_limit_ms> -S <min_similarity>}]\n";
 
 	s += prefix + "# Search, returning subject ID and position + "
 	    "extract correspondence\n" +
 	    prefix + "-s p -z <config_dir> [-d <database_dir> "
-	    "-o <output_dir>\n" + prefix + "-j <num_processes>]";
+	    "-o <output_dir>\n" + prefix + "-l <load_budget> "
+	    "-f <prefetch_depth> -C {-j <num_processes> | -t <num_threads>}\n" +
+	    prefix +
+	    "{-b <batch_size> | -a <num_in_flight> | "
+	    "-L <time_limit_ms> -S <min_similarity>}]";
+
+	s += "\n\n";
+
+	s += prefix + "# Counters (-C) count the driver and threads the "
+	    "implementation\n" +
+	    prefix + "# creates while loaded, including between calls. "
+	    "With -a, -f, or -t,\n" +
+	    prefix + "# calls overlap, so the whole run is counted instead.";
 	return (s);
 }
 
@@ -563,12 +1100,17 @@ FRIF::Evaluations::Exemplar1N::Validation::instantiateImplementation(
 			throw std::runtime_error{"Database dir does not "
 			    "exist: " + args.dbDir->string()};
 
-		impl = SearchInterface::getImplementation(
-		    args.configDir, args.outputDir / *args.dbDir);
+		/* Sharded databases are searched through a gather layer */
+		const auto dbDir = args.outputDir / *args.dbDir;
+		if (std::filesystem::exists(dbDir / ShardAssignmentsName))
+			impl = std::make_shared<ShardedSearchInterface>(
+			    args.configDir, dbDir);
+		else
+			impl = SearchInterface::getImplementation(
+			    args.configDir, dbDir);
 
-		constexpr uint64_t oneGB{1 * (1024 * 1024 * 1024)};
 		const auto status = std::get<std::shared_ptr<SearchInterface>>(
-		    impl)->load(oneGB);
+		    impl)->load(args.loadBudget);
 		if (!status) {
 			std::string err{"Error on SearchInterface::load()"};
 			if (status.message)
@@ -633,10 +1175,14 @@ std::string
 FRIF::Evaluations::Exemplar1N::Validation::makeLog(
     const std::string &prefix,
     const std::string &header,
-    const std::filesystem::path &outputDir)
+    const std::filesystem::path &outputDir,
+    const std::optional<uint8_t> &threadNum)
 {
+	std::string suffix{Util::ts(getpid())};
+	if (threadNum)
+		suffix += '-' + Util::ts(*threadNum);
 	const std::string logName = std::filesystem::path{outputDir /
-	    std::string{prefix + '-' + Util::ts(getpid()) + ".log"}}.string();
+	    std::string{prefix + '-' + suffix + ".log"}}.string();
 	std::ofstream file{logName, std::ios_base::out | std::ios_base::trunc};
 	if (!file)
 		throw std::runtime_error{Util::ts(getpid()) + ": Error "
@@ -650,143 +1196,179 @@ FRIF::Evaluations::Exemplar1N::Validation::makeLog(
 	return (logName);
 }
 
+std::pair<std::string, std::optional<std::string>>
+FRIF::Evaluations::Exemplar1N::Validation::makeCreateTemplateLogLine(
+    std::shared_ptr<ExtractionInterface> impl,
+    const Data::Dataset &dataset,
+    const uint64_t datasetIndex,
+    const std::chrono::steady_clock::time_point &start,
+    const std::chrono::steady_clock::time_point &stop,
+    const Util::PerfCounters::Counts &counts,
+    const uint64_t numSamples,
+    const std::tuple<ReturnStatus, std::optional<pmr::CreateTemplateResult>>
+        &ret,
+    const uint64_t batchSize,
+    const Arguments &args)
+{
+	const std::string &datasetName{std::get<std::string>(dataset)};
+	const std::string &identifier = std::get<std::string>(
+	    std::get<std::vector<Data::ImageSet>>(dataset).at(datasetIndex));
+
+	const auto &[rv, ctr] = ret;
+	std::string logLineCreate{'"' + identifier + "\"," +
+	    Util::duration(start, stop) + ',' + Util::e2i2s(rv.result) + ',' +
+	    Util::sanitizeMessage(rv.message ? *rv.message : "") + ',' +
+	    Util::e2i2s(*args.templateType) + ',' + Util::ts(numSamples) +
+	    ','};
+	std::optional<std::string> logLineExtractData{};
+
+	const bool doExtract = *args.templateType ==
+	    TemplateType::Probe ? impl->getCompatibility().
+	    supportsProbeTemplateIntrospection : impl->getCompatibility().
+	    supportsReferenceTemplateIntrospection;
+
+	/* Write template */
+	const auto dir = args.outputDir /
+	    Data::getTemplateDir(*args.templateType) / datasetName;
+	if (rv && ctr) {
+		Util::writeFile(ctr->data,
+		    dir / (identifier + Data::TemplateSuffix));
+		logLineCreate += Util::ts(ctr->data.size()) + ',' +
+		    Util::ts(batchSize);
+
+		if (ctr->extractedData) {
+			logLineExtractData = makeExtractTemplateDataLogLine(
+			    identifier, Util::duration(start, stop), counts,
+			    ctr->extractedData, rv, args);
+		} else if (doExtract) {
+			logLineExtractData = singleExtractTemplateData(impl,
+			    dataset, datasetIndex, ctr.value(), args);
+		}
+
+	} else {
+		Util::writeFile({}, dir / (identifier + Data::TemplateSuffix));
+		logLineCreate += Util::NA + ',' + Util::ts(batchSize);
+	}
+	logLineCreate += makePerfCountersColumns(counts, args);
+
+	return {logLineCreate, logLineExtractData};
+}
+
 std::string
 FRIF::Evaluations::Exemplar1N::Validation::makeExtractCorrespondenceLogLine(
     const std::string &identifier,
     const std::string &duration,
+    const Util::PerfCounters::Counts &counts,
     const std::variant<SearchSubjectResult, SearchSubjectPositionResult>
         &searchResult,
     const Arguments &args)
 {
-	std::string logLine{};
+	static const std::string NAFull = Util::splice(
+	    std::vector<std::string>(14, Util::NA), ",");
+	const std::string countsColumns{makePerfCountersColumns(counts, args)};
+
+	/* Reused across calls to avoid reallocating for every line */
+	thread_local Util::LogBuffer logLine{};
+	logLine.clear();
+
+	/* Append one line per relationship of a candidate */
+	const auto appendCorrespondence = [&](const auto numCorrespondences,
+	    const auto correspondenceIdx, const std::string &candidateID,
+	    const std::optional<EFS::FrictionRidgeGeneralizedPosition> &fgp,
+	    const Correspondence &correspondence) {
+		std::vector<EFS::CorrespondenceRelationship>::size_type
+		    relIdx{};
+		const auto numRels = correspondence.relationships.size();
+		for (const auto &rel : correspondence.relationships) {
+			logLine << '"' << identifier << "\"," << duration <<
+			    ',' << numCorrespondences << ',' <<
+			    correspondenceIdx << ',' <<
+			    '"' << candidateID << "\"," << fgp << ',' <<
+			    numRels << ',' << ++relIdx << ',' <<
+			    correspondence.complex << ',' << rel.type << ',' <<
+			    '"' << rel.probeIdentifier << "\"," <<
+			    rel.probeInputIdentifier << ',';
+			Util::splice(logLine, std::span{&rel.probeMinutia, 1});
+			logLine << ',' << '"' << rel.referenceIdentifier <<
+			    "\"," << rel.referenceInputIdentifier << ',';
+			if ((rel.type == EFS::CorrespondenceType::Definite) ||
+			    (rel.type == EFS::CorrespondenceType::Possible))
+				Util::splice(logLine,
+				    std::span{&rel.referenceMinutia, 1});
+			else
+				logLine << Util::NA;
+			logLine << countsColumns << '\n';
+		}
+	};
 
 	if (args.operation == Operation::SearchSubject) {
 		const auto &correspondences = std::get<SearchSubjectResult>(
 		    searchResult).correspondence;
 		if (!correspondences.has_value())
 			return {'"' + identifier + "\"," +
-			   duration + ',' + Util::splice({14, Util::NA}, ",")};
+			   duration + ',' + NAFull + countsColumns};
 		if (std::get<SearchSubjectResult>(searchResult).candidateList.
 		    size() != correspondences->size())
 			throw std::runtime_error{"There is not a "
 			    "correspondence entry for each candidate in the "
 			    "candidate list"};
 
-		const std::string logLinePrefix{'"' + identifier + "\"," +
-		   duration + ',' + Util::ts(correspondences->size()) + ','};
-
 		std::unordered_map<std::string,FRIF::Correspondence>::size_type
 		    correspondenceIdx{};
-		for (const auto &entry : *correspondences) {
-			++correspondenceIdx;
-
-			const auto &[candidateID, correspondence] = entry;
-
-			std::vector<EFS::CorrespondenceRelationship>::size_type
-			    relIdx{};
-			const auto numRels = correspondence.relationships.
-			    size();
-			for (const auto &rel : correspondence.relationships) {
-				logLine += logLinePrefix +
-				    Util::ts(correspondenceIdx) + ',' +
-				    '"' + candidateID + "\"," +
-				    Util::NA + ',' +
-				    Util::ts(numRels) + ',' +
-				    Util::ts(++relIdx) + ',' +
-				    (correspondence.complex ?
-					Util::ts(*correspondence.complex) :
-					Util::NA) +
-				    ',' + Util::e2i2s(rel.type) + ',' +
-				    '"' + rel.probeIdentifier + "\"," +
-				    Util::ts(rel.probeInputIdentifier) + ',' +
-				    Util::splice({rel.probeMinutia}) + ',' +
-				    '"' + rel.referenceIdentifier + "\"," +
-				    Util::ts(rel.referenceInputIdentifier) +
-				    ',';
-				if ((rel.type == EFS::
-				    CorrespondenceType::Definite) ||
-				    (rel.type == EFS::
-				    CorrespondenceType::Possible))
-					logLine += Util::splice(
-					    {rel.referenceMinutia}) + '\n';
-				else
-					logLine += Util::NA + '\n';
-			}
-		}
+		for (const auto &[candidateID, correspondence] :
+		    *correspondences)
+			appendCorrespondence(correspondences->size(),
+			    ++correspondenceIdx, candidateID, std::nullopt,
+			    correspondence);
 	} else if (args.operation == Operation::SearchSubjectPosition) {
 		const auto &correspondences =
 		    std::get<SearchSubjectPositionResult>(searchResult).
 		    correspondence;
 		if (!correspondences.has_value())
 			return {'"' + identifier + "\"," +
-			   duration + ',' + Util::splice({14, Util::NA}, ",")};
+			   duration + ',' + NAFull + countsColumns};
 		if (std::get<SearchSubjectPositionResult>(searchResult).
 		    candidateList.size() != correspondences->size())
 			throw std::runtime_error{"There is not a "
 			    "correspondence entry for each candidate in the "
 			    "candidate list"};
 
-		const std::string logLinePrefix{'"' + identifier + "\"," +
-		   duration + ',' + Util::ts(correspondences->size()) + ','};
-
 		std::unordered_map<std::string,FRIF::Correspondence>::size_type
 		    correspondenceIdx{};
-		for (const auto &entry : *correspondences) {
-			++correspondenceIdx;
-
-			const auto &[candidate, correspondence] = entry;
-
-			std::vector<EFS::CorrespondenceRelationship>::size_type
-			    relIdx{};
-			const auto numRels = correspondence.relationships.
-			    size();
-			for (const auto &rel : correspondence.relationships) {
-				logLine += logLinePrefix +
-				    Util::ts(correspondenceIdx) + ',' +
-				    '"' + candidate.identifier + "\"," +
-				    Util::e2i2s(candidate.fgp) + ',' +
-				    Util::ts(numRels) + ',' +
-				    Util::ts(++relIdx) + ',' +
-				    (correspondence.complex ?
-					Util::ts(*correspondence.complex) :
-					Util::NA) +
-				    ',' + Util::e2i2s(rel.type) + ',' +
-				    '"' + rel.probeIdentifier + "\"," +
-				    Util::ts(rel.probeInputIdentifier) + ',' +
-				    Util::splice({rel.probeMinutia}) + ',' +
-				    '"' + rel.referenceIdentifier + "\"," +
-				    Util::ts(rel.referenceInputIdentifier) +
-				    ',';
-				if ((rel.type == EFS::
-				    CorrespondenceType::Definite) ||
-				    (rel.type == EFS::
-				    CorrespondenceType::Possible))
-					logLine += Util::splice(
-					    {rel.referenceMinutia}) + '\n';
-				else
-					logLine += Util::NA + '\n';
-			}
-		}
+		for (const auto &[candidate, correspondence] :
+		    *correspondences)
+			appendCorrespondence(correspondences->size(),
+			    ++correspondenceIdx, candidate.identifier,
+			    candidate.fgp, correspondence);
 	} else
 		throw std::runtime_error{"Unsupported operation sent to "
 		    "makeExtractCorrespondenceLogLine()"};
 
 	/* Remove last newline */
-	logLine.pop_back();
+	logLine.removeSuffix("\n");
 
-	return (logLine);
+	return (logLine.str());
 }
 
 std::string
 FRIF::Evaluations::Exemplar1N::Validation::makeExtractTemplateDataLogLine(
     const std::string &identifier,
     const std::string &duration,
-    const std::optional<std::vector<TemplateData>> &extractedData,
+    const Util::PerfCounters::Counts &counts,
+    const std::optional<std::pmr::vector<pmr::TemplateData>> &extractedData,
     const std::optional<ReturnStatus> &rs,
     const Arguments &args)
 {
-	const std::string logLinePrefix{'"' + identifier + "\"," +  duration +
-	    ',' + Util::e2i2s(*args.templateType) + ','};
+	const std::string countsColumns{makePerfCountersColumns(counts, args)};
+
+	/* Reused across calls to avoid reallocating for every line */
+	thread_local Util::LogBuffer logLine{};
+	logLine.clear();
+
+	const auto appendPrefix = [&]() {
+		logLine << '"' << identifier << "\"," << duration << ',' <<
+		    *args.templateType << ',';
+	};
 
 	if (!rs.has_value() || !extractedData.has_value() ||
 	    (rs.has_value() && !rs.value()) ||
@@ -794,94 +1376,113 @@ FRIF::Evaluations::Exemplar1N::Validation::makeExtractTemplateDataLogLine(
 		static const uint8_t numElements{20};
 		static const std::string NAFull = Util::splice(
 		    std::vector<std::string>(numElements, Util::NA), ",");
-		return (logLinePrefix + NAFull);
+		appendPrefix();
+		logLine << NAFull << countsColumns;
+		return (logLine.str());
 	}
 
-	std::string logLine{};
-	for (std::vector<TemplateData>::size_type i{};
+	/* Append quoted splice() of an optional vector, or NA */
+	const auto appendQuoted = [&](const auto &v) {
+		if (v) {
+			logLine << '"';
+			Util::splice(logLine, *v);
+			logLine << '"';
+		} else
+			logLine << Util::NA;
+		logLine << ',';
+	};
+
+	for (std::pmr::vector<pmr::TemplateData>::size_type i{};
 	    i < extractedData->size(); ++i) {
 		const auto &td = extractedData->at(i);
-		if (td.identifier != identifier)
+		if (std::string_view{td.identifier} != identifier)
 			throw std::runtime_error{"Inconsistency in identifier"};
 
-		logLine += logLinePrefix + Util::ts(i) + ',' +
-		    Util::ts(extractedData->size()) + ',' +
-		    Util::ts(td.inputIdentifier) + ',';
+		appendPrefix();
+		logLine << i << ',' << extractedData->size() << ',' <<
+		    td.inputIdentifier << ',';
 
 		static const uint8_t efsElements{17};
 		static const std::string NAEFS = Util::splice(
 		    std::vector<std::string>(efsElements, Util::NA), ",");
 		if (!td.features) {
-			logLine += NAEFS + '\n';
+			logLine << NAEFS << countsColumns << '\n';
 			continue;
 		}
 
 		const auto &efs = td.features.value();
 
-		logLine += (efs.quality ?
-		    Util::splice(*efs.quality) : Util::NA) + ',';
-		logLine += Util::e2i2s(efs.imp) + ',' + Util::e2i2s(efs.frct) +
-		    ',' + Util::e2i2s(efs.frgp) + ',';
-		if (efs.orientation) {
-			logLine += Util::ts(efs.orientation->direction) +
-			    ';' + (efs.orientation->uncertainty ?
-			    Util::ts(*efs.orientation->uncertainty) :
-			    Util::NA) + ',';
-		} else
-			logLine += Util::NA + ',';
-		logLine += (efs.lpm ? Util::splice(*efs.lpm) : Util::NA) + ',';
-		logLine += (efs.valueAssessment ?
-		    Util::e2i2s(*efs.valueAssessment) : Util::NA) + ',';
-		logLine += (efs.lsb ? Util::e2i2s(*efs.lsb) : Util::NA) + ',';
+		if (efs.quality)
+			Util::splice(logLine, *efs.quality);
+		else
+			logLine << Util::NA;
+		logLine << ',';
+		logLine << efs.imp << ',' << efs.frct << ',' << efs.frgp << ',';
+		if (efs.orientation)
+			logLine << efs.orientation->direction << ';' <<
+			    efs.orientation->uncertainty << ',';
+		else
+			logLine << Util::NA << ',';
+		if (efs.lpm)
+			Util::splice(logLine, *efs.lpm);
+		else
+			logLine << Util::NA;
+		logLine << ',';
+		logLine << efs.valueAssessment << ',' << efs.lsb << ',';
 
 		if (efs.pat) {
-			logLine += Util::e2i2s(efs.pat->
-			    getPatternGeneralClassification()) + ';';
+			logLine << efs.pat->getPatternGeneralClassification() <<
+			    ';';
 
 			if (efs.pat->getPatternSubclassification()) {
 				const auto ps = *efs.pat->
 				    getPatternSubclassification();
 				if (const auto *aps = std::get_if<
 				    EFS::ArchPatternSubclassification>(&ps))
-					logLine += Util::e2i2s(*aps);
+					logLine << *aps;
 				else if (const auto *wps = std::get_if<
 				    EFS::WhorlPatternSubclassification>(&ps))
-					logLine += Util::e2i2s(*wps);
+					logLine << *wps;
 				else
-					logLine += Util::NA;
+					logLine << Util::NA;
 			} else
-				logLine += Util::NA + ';' + Util::NA + ';' +
+				logLine << Util::NA << ';' << Util::NA << ';' <<
 				    Util::NA;
 
-			logLine += ';' + (efs.pat->getWhorlDeltaRelationship() ?
-			    Util::e2i2s(*efs.pat->getWhorlDeltaRelationship()) :
-			    Util::NA) + ',';
+			logLine << ';' <<
+			    efs.pat->getWhorlDeltaRelationship() << ',';
 		} else
-			logLine += Util::NA + ',';
-
-		logLine += (efs.plr ? Util::ts(*efs.plr) : Util::NA) + ',';
-		logLine += (efs.trv ? Util::ts(*efs.trv) : Util::NA) + ',';
-		logLine += (efs.cores ?
-		    '"' + Util::splice(*efs.cores) + '"' : Util::NA) + ',';
-		logLine += (efs.deltas ?
-		    '"' + Util::splice(*efs.deltas)  + '"': Util::NA) + ',';
-		logLine += (efs.minutiae ?
-		    '"' + Util::splice(*efs.minutiae) + '"' : Util::NA) + ',';
-		logLine += (efs.creases ?
-		    '"' + Util::splice(*efs.creases) + '"' : Util::NA) + ',';
-		logLine += (efs.roi ?
-		    '"' + Util::splice(*efs.roi)  + '"': Util::NA) + ',';
-		logLine += (efs.rqm ?
-		    '"' + Util::splice(*efs.rqm)  + '"': Util::NA) + ',';
-		logLine += (efs.complex ? Util::ts(*efs.complex) : Util::NA);
-
-		logLine += '\n';
+			logLine << Util::NA << ',';
+
+		logLine << efs.plr << ',' << efs.trv << ',';
+		appendQuoted(efs.cores);
+		appendQuoted(efs.deltas);
+		appendQuoted(efs.minutiae);
+		appendQuoted(efs.creases);
+		appendQuoted(efs.roi);
+		appendQuoted(efs.rqm);
+		logLine << efs.complex << countsColumns << '\n';
 	}
 
 	/* Remove last newline */
-	logLine.pop_back();
+	logLine.removeSuffix("\n");
+
+	return (logLine.str());
+}
+
+std::string
+FRIF::Evaluations::Exemplar1N::Validation::makePerfCountersColumns(
+    const Util::PerfCounters::Counts &counts,
+    const Arguments &args)
+{
+	if (!args.perfCounters)
+		return {};
+
+	std::string columns{};
+	for (const auto &count : counts)
+		columns += ',' + (count ? Util::ts(*count) : Util::NA);
 
-	return (logLine);
+	return (columns);
 }
 
 void
@@ -925,7 +1526,16 @@ FRIF::Evaluations::Exemplar1N::Validation::makeReferenceTemplateArchive(
 	}
 	std::sort(entries.begin(), entries.end());
 
+	/* Line n of the manifest is SubjectID n */
+	SubjectIdentifierDictionary identifiers{};
 	for (const auto &entry : entries) {
+		const auto identifier = entry.path().filename().
+		    replace_extension().string();
+		if (identifiers.find(identifier))
+			throw std::runtime_error{"Multiple templates for " +
+			    identifier + " in " + dir.string()};
+		identifiers.intern(identifier);
+
 		std::ifstream tmpl{entry.path(), std::ios_base::in |
 		    std::ios_base::binary | std::ios_base::ate};
 		if (!tmpl)
@@ -963,9 +1573,8 @@ FRIF::Evaluations::Exemplar1N::Validation::makeReferenceTemplateArchive(
 			throw std::runtime_error{"Could not write " +
 			    (dir / Data::TemplateArchiveArchiveName).string()};
 
-		manifest << entry.path().filename().replace_extension().
-		    string() << ' ' << tmplDataSize << ' ' << currentOffset <<
-		    '\n';
+		manifest << identifier << ' ' << tmplDataSize << ' ' <<
+		    currentOffset << '\n';
 		if (!manifest)
 			throw std::runtime_error{"Could not write " +
 			    (dir / Data::TemplateArchiveManifestName).string()};
@@ -974,6 +1583,15 @@ FRIF::Evaluations::Exemplar1N::Validation::makeReferenceTemplateArchive(
 
 }
 
+std::pmr::monotonic_buffer_resource
+FRIF::Evaluations::Exemplar1N::Validation::makeRequestArena()
+{
+	/* Large enough for most templates and their TemplateData */
+	thread_local std::vector<std::byte> buffer(1024 * 1024);
+
+	return {buffer.data(), buffer.size()};
+}
+
 std::vector<FRIF::Sample>
 FRIF::Evaluations::Exemplar1N::Validation::makeSamples(
     const std::vector<Data::Input> &metadatas,
@@ -1000,12 +1618,31 @@ FRIF::Evaluations::Exemplar1N::Validation::makeSamples(
 				throw std::runtime_error{"Missing image meta"
 				    "data"};
 
-			samples.emplace_back(Image(
-			    static_cast<uint8_t>(sampleIndex),
-			    *md.image->width, *md.image->height, *md.image->ppi,
-			    *md.image->colorspace,
-			    *md.image->bpc, *md.image->bpp, Util::readFile(
-			    args.imageDir / *md.image->filename)), md.features);
+			if (args.imagePack)
+				samples.emplace_back(args.imagePack->makeImage(
+				    static_cast<uint8_t>(sampleIndex),
+				    *md.image), md.features);
+			else {
+				/* Pixels are used in place from the file */
+				const auto pathName = args.imageDir /
+				    *md.image->filename;
+				Util::FileContents file{};
+				if (args.prefetcher)
+					file = args.prefetcher->next(pathName);
+				else {
+					const auto mapping = std::make_shared<
+					    const Util::MappedFile>(pathName,
+					    Util::MappedFile::Access::
+					    Sequential);
+					file = {mapping->data(), mapping};
+				}
+				samples.emplace_back(Image(
+				    static_cast<uint8_t>(sampleIndex),
+				    *md.image->width, *md.image->height,
+				    *md.image->ppi, *md.image->colorspace,
+				    *md.image->bpc, *md.image->bpp,
+				    file.data, file.owner), md.features);
+			}
 
 			const auto &image = std::get<std::optional<Image>>(
 			    samples.back());
@@ -1018,21 +1655,307 @@ FRIF::Evaluations::Exemplar1N::Validation::makeSamples(
 	return (samples);
 }
 
-FRIF::Evaluations::Exemplar1N::Validation::Arguments
-FRIF::Evaluations::Exemplar1N::Validation::parseArguments(
-    const int argc,
-    char * const argv[])
+std::pair<std::string, std::optional<std::string>>
+FRIF::Evaluations::Exemplar1N::Validation::makeSearchLogLine(
+    std::shared_ptr<SearchInterface> impl,
+    const Data::Dataset &dataset,
+    const uint64_t datasetIndex,
+    std::span<const std::byte> probe,
+    const std::chrono::steady_clock::time_point &start,
+    const std::chrono::steady_clock::time_point &stop,
+    const Util::PerfCounters::Counts &counts,
+    const ReturnStatus &rs,
+    const std::variant<std::optional<SearchSubjectResult>,
+        std::optional<SearchSubjectPositionResult>> &result,
+    const uint64_t batchSize,
+    const Arguments &args)
 {
-	static const char options[] {"cd:e:i:j:m:r:o:s:z:I:"};
-	Arguments args{};
-	args.executableName = argv[0];
+	const auto identifier = std::get<std::string>(
+	    std::get<std::vector<Data::ImageSet>>(dataset).at(datasetIndex));
+	const bool doCorrespondence =
+	    impl->getCompatibility().supportsCorrespondence;
 
-	int c{};
-	while ((c = getopt(argc, argv, options)) != -1) {
-		switch (c) {
-		case 'c':	/* Create databases */
-			if (args.operation)
-				throw std::logic_error{"Multiple operations "
+	/* Record whether the search stopped early */
+	std::string termination{Util::NA};
+	if (rs)
+		std::visit([&](const auto &optRes) {
+			if (optRes)
+				termination = Util::e2i2s(optRes->termination);
+		}, result);
+	const std::string logLineSuffix{',' + Util::ts(batchSize) + ',' +
+	    termination + makePerfCountersColumns(counts, args)};
+	const std::string logLinePrefix{'"' + identifier + "\"," +
+	    Util::ts(args.maximum) + ',' + Util::duration(start, stop) + ',' +
+	    Util::e2i2s(rs.result) + ',' +
+	    Util::sanitizeMessage(rs.message ? *rs.message : "") + ','};
+
+	std::string logLine{};
+	const bool includeFGP{
+	    args.operation == Operation::SearchSubjectPosition};
+	if (!rs) {
+		logLine += logLinePrefix + std::to_string(includeFGP) + ',' +
+		    Util::splice(std::vector<std::string>(7, Util::NA), ",") +
+		    logLineSuffix;
+		return {logLine, std::nullopt};
+	}
+
+	if (args.operation == Operation::SearchSubject) {
+		const auto &optRes = std::get<std::optional<
+		    SearchSubjectResult>>(result);
+		if (!optRes.has_value()) {
+			logLine += logLinePrefix + std::to_string(includeFGP) +
+			    ',' + std::to_string(optRes.has_value()) + ',' +
+			    Util::splice(std::vector<std::string>(6, Util::NA),
+			    ",") + logLineSuffix;
+			return {logLine, std::nullopt};
+		}
+		if (optRes->candidateList.empty()) {
+			logLine += logLinePrefix + std::to_string(includeFGP) +
+			    ',' + std::to_string(optRes.has_value()) + ',' +
+			    Util::splice(std::vector<std::string>(6, Util::NA),
+			    ",") + logLineSuffix;
+			return {logLine, std::nullopt};
+		}
+
+		/* Every candidate returned is logged, in rank order */
+		RankedSubjectCandidateList ranked(optRes->candidateList,
+		    optRes->candidateList.size());
+		const auto sorted = ranked.rank();
+
+		std::size_t rank{};
+		for (const auto &[candidateID, similarity] : sorted) {
+			logLine += logLinePrefix + std::to_string(includeFGP) +
+			    ',' + std::to_string(optRes.has_value()) + ',' +
+			    Util::ts(optRes->decision) + ',' +
+			    Util::ts(optRes->candidateList.size()) + ',' +
+			    Util::ts(++rank) + ",\"" + candidateID + "\"," +
+			    Util::NA + "," + Util::ts(similarity) +
+			    logLineSuffix;
+			if (rank < sorted.size())
+				logLine += '\n';
+		}
+
+		/* Log or call correspondence */
+		if (optRes->correspondence.has_value())
+			return {logLine, makeExtractCorrespondenceLogLine(
+			    identifier, Util::duration(start, stop), counts,
+			    *optRes, args)};
+		else if (doCorrespondence)
+			return {logLine, singleExtractCorrespondence(
+			    impl, dataset, datasetIndex, probe, *optRes,
+			    args)};
+		else
+			return {logLine, std::nullopt};
+	} else if (args.operation == Operation::SearchSubjectPosition) {
+		const auto &optRes = std::get<std::optional<
+		    SearchSubjectPositionResult>>(result);
+		if (!optRes.has_value()) {
+			logLine += logLinePrefix + std::to_string(includeFGP) +
+			    ',' + std::to_string(optRes.has_value()) + ',' +
+			    Util::splice(std::vector<std::string>(6, Util::NA),
+			    ",") + logLineSuffix;
+			return {logLine, std::nullopt};
+		}
+		if (optRes->candidateList.empty()) {
+			logLine += logLinePrefix + std::to_string(includeFGP) +
+			    ',' + std::to_string(optRes.has_value()) + ',' +
+			    Util::splice(std::vector<std::string>(6, Util::NA),
+			    ",") + logLineSuffix;
+			return {logLine, std::nullopt};
+		}
+
+		/* Every candidate returned is logged, in rank order */
+		RankedSubjectPositionCandidateList ranked(
+		    optRes->candidateList, optRes->candidateList.size());
+		const auto sorted = ranked.rank();
+
+		std::size_t rank{};
+		for (const auto &[c, similarity] : sorted) {
+			logLine += logLinePrefix + std::to_string(includeFGP) +
+			    ',' + std::to_string(optRes.has_value()) + ',' +
+			    Util::ts(optRes->decision) + ',' +
+			    Util::ts(optRes->candidateList.size()) + ',' +
+			    Util::ts(++rank) + ",\"" + c.identifier + "\"," +
+			    Util::e2i2s(c.fgp) + "," + Util::ts(similarity) +
+			    logLineSuffix;
+			if (rank < sorted.size())
+				logLine += '\n';
+		}
+
+		/* Log or call correspondence */
+		if (optRes->correspondence.has_value())
+			return {logLine, makeExtractCorrespondenceLogLine(
+			    identifier, Util::duration(start, stop), counts,
+			    *optRes, args)};
+		else if (doCorrespondence)
+			return {logLine, singleExtractCorrespondence(
+			    impl, dataset, datasetIndex, probe, *optRes,
+			    args)};
+		else
+			return {logLine, std::nullopt};
+	} else
+		throw std::runtime_error{"Unsupported operation sent to "
+		    "makeSearchLogLine()"};
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::modifyDatabase(
+    std::shared_ptr<ExtractionInterface> impl,
+    const TemplateArchive &additions,
+    const std::filesystem::path &databaseDir,
+    const std::string &databaseName,
+    const Arguments &args)
+{
+	if (!ExtractionInterface::getCompatibility().
+	    supportsIncrementalReferenceDatabase)
+		throw std::runtime_error{"ExtractionInterface does not support "
+		    "incremental reference databases (-u)"};
+
+	std::ifstream manifest{additions.manifest};
+	if (!manifest)
+		throw std::runtime_error{"Could not open " +
+		    additions.manifest.string()};
+	std::vector<std::string> identifiers{};
+	std::string line{}, identifier{};
+	while (std::getline(manifest, line)) {
+		if (!(std::istringstream{line} >> identifier))
+			throw std::runtime_error{"Could not parse \"" + line +
+			    "\" in " + additions.manifest.string()};
+		identifiers.push_back(identifier);
+	}
+
+	const std::filesystem::path logFilePath = args.outputDir /
+	    ("modifyDatabase-" + databaseName + ".log");
+	auto logFile = std::ofstream{logFilePath,
+	    std::ios_base::out | std::ios_base::trunc};
+	logFile << "\"databaseName\",\"method\",duration,result,\"message\"" <<
+	    getPerfCountersHeader(args) << '\n';
+	if (!logFile)
+		throw std::runtime_error{"Failed to write modify database "
+		    "header to " + logFilePath.string()};
+
+	/* Changes must be visible to an already-loaded SearchInterface */
+	const auto search = SearchInterface::getImplementation(args.configDir,
+	    databaseDir);
+	if (!search)
+		throw std::runtime_error{"SearchInterface implementation was "
+		    "null"};
+	const auto loadStatus = search->load(args.loadBudget);
+	if (!loadStatus)
+		throw std::runtime_error{"Failed to load database for "
+		    "dataset = " + databaseName + (loadStatus.message ?
+		    ": (" + *loadStatus.message + ")" : "")};
+	const bool reload{SearchInterface::getCompatibility().supportsReload};
+
+	const auto call = [&](const std::string &method,
+	    const std::function<ReturnStatus()> &fn) {
+		ReturnStatus rs{};
+		std::chrono::steady_clock::time_point start{}, stop{};
+		startPerfCounters(args.perfCounters);
+		try {
+			start = std::chrono::steady_clock::now();
+			rs = fn();
+			stop = std::chrono::steady_clock::now();
+		} catch (const std::exception &e) {
+			throw std::runtime_error{"Exception from " + method +
+			    "() for dataset = " + databaseName + " (" +
+			    e.what() + ")"};
+		} catch (...) {
+			throw std::runtime_error{"Exception from " + method +
+			    "() for dataset = " + databaseName};
+		}
+		const auto counts = stopPerfCounters(args.perfCounters);
+		recordLatency(method, databaseName, start, stop, args);
+
+		logFile << '"' << databaseName << "\",\"" << method << "\"," <<
+		    Util::duration(start, stop) << ',' <<
+		    Util::e2i2s(rs.result) << ',' <<
+		    Util::sanitizeMessage(rs.message ? *rs.message : "") <<
+		    makePerfCountersColumns(counts, args) << '\n';
+		if (!logFile)
+			throw std::runtime_error{"Failed to write to modify "
+			    "database log " + logFilePath.string()};
+
+		if (!rs)
+			throw std::runtime_error{"Failure from " + method +
+			    "() for dataset = " + databaseName + (rs.message ?
+			    ": (" + *rs.message + ")" : "")};
+	};
+	const auto change = [&](const std::string &method,
+	    const std::function<ReturnStatus()> &fn) {
+		call(method, fn);
+		if (reload)
+			call("reload", [&]() {
+				return (search->reload(args.loadBudget));
+			});
+	};
+
+	const auto insert = [&]() {
+		return (impl->insertIntoReferenceDatabase(additions,
+		    databaseDir, args.maximum));
+	};
+	change("insertIntoReferenceDatabase", insert);
+	change("updateReferenceDatabase", [&]() {
+		return (impl->updateReferenceDatabase(additions, databaseDir,
+		    args.maximum));
+	});
+	change("removeFromReferenceDatabase", [&]() {
+		return (impl->removeFromReferenceDatabase(identifiers,
+		    databaseDir));
+	});
+	change("insertIntoReferenceDatabase", insert);
+}
+
+FRIF::Evaluations::Exemplar1N::Validation::Arguments
+FRIF::Evaluations::Exemplar1N::Validation::parseArguments(
+    const int argc,
+    char * const argv[])
+{
+	static const char options[] {
+	    "a:b:cd:e:f:i:j:k:l:m:pr:o:s:t:uz:CI:L:PS:"};
+	Arguments args{};
+	args.executableName = argv[0];
+
+	int c{};
+	while ((c = getopt(argc, argv, options)) != -1) {
+		switch (c) {
+		case 'a': {	/* Asynchronous queue depth */
+			uint64_t queueDepth{};
+			try {
+				queueDepth = std::stoull(optarg);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Searches in "
+				    "flight (-a): an error occurred when "
+				    "parsing \"" + std::string(optarg) + "\""};
+			}
+			if (queueDepth > std::numeric_limits<uint16_t>::max())
+				throw std::invalid_argument{"Searches in "
+				    "flight (-a): must be no more than " +
+				    std::to_string(std::numeric_limits<
+				    uint16_t>::max())};
+			args.queueDepth = static_cast<uint16_t>(queueDepth);
+			break;
+		}
+		case 'b': {	/* Batch size */
+			uint64_t batchSize{};
+			try {
+				batchSize = std::stoull(optarg);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Batch size (-b): "
+				    "an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			if ((batchSize == 0) || (batchSize >
+			    std::numeric_limits<uint16_t>::max()))
+				throw std::invalid_argument{"Batch size (-b): "
+				    "must be between 1 and " + std::to_string(
+				    std::numeric_limits<uint16_t>::max())};
+			args.batchSize = static_cast<uint16_t>(batchSize);
+			break;
+		}
+		case 'c':	/* Create databases */
+			if (args.operation)
+				throw std::logic_error{"Multiple operations "
 				    "specified"};
 			args.operation = Operation::CreateDatabases;
 			break;
@@ -1061,6 +1984,25 @@ FRIF::Evaluations::Exemplar1N::Validation::parseArguments(
 			}
 			break;
 
+		case 'f': {	/* Prefetch depth */
+			uint64_t prefetchDepth{};
+			try {
+				prefetchDepth = std::stoull(optarg);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Prefetch depth "
+				    "(-f): an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			if (prefetchDepth >
+			    std::numeric_limits<uint16_t>::max())
+				throw std::invalid_argument{"Prefetch depth "
+				    "(-f): must be no more than " +
+				    std::to_string(std::numeric_limits<
+				    uint16_t>::max())};
+			args.prefetchDepth = static_cast<uint16_t>(
+			    prefetchDepth);
+			break;
+		}
 		case 'i':	/* Identification */
 			if (std::string(optarg).length() != 1)
 				throw std::logic_error{"Invalid -i argument"};
@@ -1118,6 +2060,32 @@ FRIF::Evaluations::Exemplar1N::Validation::parseArguments(
 			}
 			break;
 		}
+		case 'k': {	/* Number of shards */
+			uint64_t numShards{};
+			try {
+				numShards = std::stoull(optarg);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Number of shards "
+				    "(-k): an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			if (numShards > std::numeric_limits<uint16_t>::max())
+				throw std::invalid_argument{"Number of shards "
+				    "(-k): must be no more than " +
+				    std::to_string(std::numeric_limits<
+				    uint16_t>::max())};
+			args.numShards = static_cast<uint16_t>(numShards);
+			break;
+		}
+		case 'l':	/* Load budget */
+			try {
+				args.loadBudget = std::stoull(optarg);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Load budget (-l): "
+				    "an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			break;
 		case 'm':	/* Maximum size */
 			try {
 				args.maximum = std::stoull(optarg);
@@ -1151,6 +2119,13 @@ FRIF::Evaluations::Exemplar1N::Validation::parseArguments(
 			args.outputDir = optarg;
 			break;
 
+		case 'p':	/* Pack images */
+			if (args.operation)
+				throw std::logic_error{"Multiple operations "
+				    "specified"};
+			args.operation = Operation::PackImages;
+			break;
+
 		case 'r':	/* Random seed */
 			try {
 				args.randomSeed = std::stoull(optarg);
@@ -1161,12 +2136,56 @@ FRIF::Evaluations::Exemplar1N::Validation::parseArguments(
 			}
 			break;
 
+		case 't':	/* Number of threads */
+			try {
+				args.numThreads = static_cast<uint8_t>(
+				    std::stoul(optarg));
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Number of threads "
+				    "(-t): an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			if (args.numThreads == 0)
+				throw std::invalid_argument{"Number of threads "
+				    "(-t): must be at least 1"};
+			break;
+
+		case 'u':	/* Create databases incrementally */
+			args.incremental = true;
+			break;
 		case 'z':	/* Config dir */
 			args.configDir = optarg;
 			break;
 		case 'I':
 			args.imageDir = optarg;
 			break;
+		case 'P':	/* Read images from ImagePack */
+			args.packedImages = true;
+			break;
+		case 'C':	/* Count hardware events */
+			args.perfCounters = true;
+			break;
+		case 'L': {	/* Time limit */
+			uint64_t timeLimit{};
+			try {
+				timeLimit = std::stoull(optarg);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Time limit (-L): "
+				    "an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			args.timeLimit = std::chrono::milliseconds(timeLimit);
+			break;
+		}
+		case 'S':	/* Minimum similarity */
+			try {
+				args.minSimilarity = std::stod(optarg);
+			} catch (const std::exception&) {
+				throw std::invalid_argument{"Minimum similarity "
+				    "(-S): an error occurred when parsing \"" +
+				    std::string(optarg) + "\""};
+			}
+			break;
 		}
 	}
 
@@ -1177,10 +2196,46 @@ FRIF::Evaluations::Exemplar1N::Validation::parseArguments(
 	    (args.operation == Operation::Usage) ||
 	    (args.operation == Operation::IdentifyExtraction) ||
 	    (args.operation == Operation::IdentifyLibrary) ||
-	    (args.operation == Operation::IdentifySearch)))
+	    (args.operation == Operation::IdentifySearch) ||
+	    (args.operation == Operation::PackImages)))
 		throw std::invalid_argument{"Must provide path to "
 		     "configuration directory"};
 
+	if (args.packedImages &&
+	    (args.operation != Operation::CreateTemplates))
+		throw std::invalid_argument{"Packed images (-P) are only "
+		    "supported when creating templates"};
+
+	if (args.prefetchDepth > 0) {
+		if (!((args.operation == Operation::CreateTemplates) ||
+		    (args.operation == Operation::SearchSubject) ||
+		    (args.operation == Operation::SearchSubjectPosition)))
+			throw std::invalid_argument{"Prefetch depth (-f) is "
+			    "only supported when creating templates or "
+			    "searching"};
+		if (args.packedImages)
+			throw std::invalid_argument{"Cannot combine prefetch "
+			    "depth (-f) with packed images (-P)"};
+	}
+
+	if (args.perfCounters) {
+		if (!((args.operation == Operation::CreateTemplates) ||
+		    (args.operation == Operation::CreateDatabases) ||
+		    (args.operation == Operation::SearchSubject) ||
+		    (args.operation == Operation::SearchSubjectPosition)))
+			throw std::invalid_argument{"Hardware counters (-C) "
+			    "are only supported when creating templates, "
+			    "creating databases, or searching"};
+		const Util::PerfCounters counters{};
+		if (std::none_of(Util::PerfCounters::Events.cbegin(),
+		    Util::PerfCounters::Events.cend(), [&](const auto event) {
+			return (counters.isCounting(event));
+		    }))
+			throw std::invalid_argument{"Hardware counters (-C): "
+			    "no events can be counted (check "
+			    "/proc/sys/kernel/perf_event_paranoid)"};
+	}
+
 	if ((args.operation == Operation::SearchSubject) ||
 	    (args.operation == Operation::SearchSubjectPosition)) {
 		if (args.maximum > std::numeric_limits<uint16_t>::max())
@@ -1190,11 +2245,213 @@ FRIF::Evaluations::Exemplar1N::Validation::parseArguments(
 
 		if (!args.dbDir)
 			throw std::invalid_argument{"No database set with -d"};
+
+		if ((args.queueDepth > 0) && (args.batchSize > 1))
+			throw std::invalid_argument{"Cannot combine searches "
+			    "in flight (-a) with batch size (-b)"};
+		if ((args.numThreads > 1) && (args.numProcs > 1))
+			throw std::invalid_argument{"Cannot combine number of "
+			    "threads (-t) with number of processes (-j)"};
+		if ((args.numThreads > 1) && (args.queueDepth > 0))
+			throw std::invalid_argument{"Cannot combine number of "
+			    "threads (-t) with searches in flight (-a)"};
+		if ((args.timeLimit || args.minSimilarity) &&
+		    ((args.queueDepth > 0) || (args.batchSize > 1)))
+			throw std::invalid_argument{"Cannot combine search "
+			    "limits (-L, -S) with searches in flight (-a) or "
+			    "batch size (-b)"};
+	} else if (args.numThreads > 1) {
+		throw std::invalid_argument{"Number of threads (-t) is only "
+		    "supported when searching"};
+	} else if (args.loadBudget != Arguments{}.loadBudget) {
+		throw std::invalid_argument{"Load budget (-l) is only "
+		    "supported when searching"};
+	} else if (args.timeLimit || args.minSimilarity) {
+		throw std::invalid_argument{"Search limits (-L, -S) are only "
+		    "supported when searching"};
+	}
+
+	if (args.operation == Operation::CreateDatabases) {
+		if ((args.numShards == 0) && (args.maximum == 0))
+			throw std::invalid_argument{"Choosing the number of "
+			    "shards (-k 0) requires a maximum size (-m)"};
+		if (args.incremental && (args.numShards != 1))
+			throw std::invalid_argument{"Cannot combine number of "
+			    "shards (-k) with incremental databases (-u)"};
+	} else if (args.numShards != 1) {
+		throw std::invalid_argument{"Number of shards (-k) is only "
+		    "supported when creating databases"};
+	} else if (args.incremental) {
+		throw std::invalid_argument{"Incremental databases (-u) are "
+		    "only supported when creating databases"};
 	}
 
 	return (args);
 }
 
+std::filesystem::path
+FRIF::Evaluations::Exemplar1N::Validation::getProbeTemplatePath(
+    const std::string &datasetName,
+    const std::string &identifier,
+    const Arguments &args)
+{
+	return (args.outputDir / Data::ProbeTemplateDir / datasetName /
+	    (identifier + ".tmpl"));
+}
+
+std::vector<std::filesystem::path>
+FRIF::Evaluations::Exemplar1N::Validation::getPrefetchPaths(
+    const Data::Dataset &dataset,
+    const std::vector<uint64_t> &indices,
+    const Arguments &args)
+{
+	const auto &imageSets = std::get<std::vector<Data::ImageSet>>(
+	    dataset);
+
+	std::vector<std::filesystem::path> pathNames{};
+	pathNames.reserve(indices.size());
+	switch (args.operation.value()) {
+	case Operation::CreateTemplates:
+		/* Same order as makeSamples() */
+		for (const auto &n : indices)
+			for (const auto &md : std::get<std::vector<
+			    Data::Input>>(imageSets.at(n)))
+				if (md.image && md.image->filename)
+					pathNames.push_back(args.imageDir /
+					    *md.image->filename);
+		break;
+	case Operation::SearchSubject:
+		[[fallthrough]];
+	case Operation::SearchSubjectPosition:
+		for (const auto &n : indices)
+			pathNames.push_back(getProbeTemplatePath(
+			    std::get<std::string>(dataset),
+			    std::get<std::string>(imageSets.at(n)), args));
+		break;
+	default:
+		throw std::runtime_error{"Unsupported operation sent to "
+		    "getPrefetchPaths()"};
+	}
+
+	return (pathNames);
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::processClaims(
+    const Data::Dataset &dataset,
+    const std::vector<uint64_t> &indices,
+    const Arguments &args,
+    const std::function<void(const ClaimFunction&,
+        const Arguments&)> &fn)
+{
+	/* One prefetcher per worker, fed the files of each claim */
+	Arguments workerArgs{args};
+	if (args.prefetchDepth > 0)
+		workerArgs.prefetcher = std::make_shared<Util::FilePrefetcher>(
+		    std::vector<std::filesystem::path>{}, args.prefetchDepth);
+
+	uint64_t numClaims{}, numItems{};
+	const auto claimChunk = [&]() -> std::vector<uint64_t> {
+		std::vector<uint64_t> chunk{};
+		if (!args.workQueue) {
+			if (numClaims == 0)
+				chunk = indices;
+		} else if (const auto claimed = args.workQueue->claim()) {
+			const auto &[first, last] = *claimed;
+			chunk.assign(std::next(indices.cbegin(),
+			    static_cast<std::ptrdiff_t>(first)),
+			    std::next(indices.cbegin(),
+			    static_cast<std::ptrdiff_t>(last)));
+		}
+		if (chunk.empty())
+			return (chunk);
+
+		++numClaims;
+		numItems += chunk.size();
+		if (workerArgs.prefetcher)
+			workerArgs.prefetcher->extend(getPrefetchPaths(dataset,
+			    chunk, args));
+		return (chunk);
+	};
+
+	/* Claim one chunk ahead when prefetching so reads don't stall */
+	std::vector<uint64_t> ahead{};
+	if (workerArgs.prefetcher)
+		ahead = claimChunk();
+	const ClaimFunction claim = [&]() -> std::vector<uint64_t> {
+		if (!workerArgs.prefetcher)
+			return (claimChunk());
+
+		auto chunk = std::exchange(ahead, {});
+		if (!chunk.empty())
+			ahead = claimChunk();
+		return (chunk);
+	};
+
+	const auto start = std::chrono::steady_clock::now();
+	fn(claim, workerArgs);
+	const auto busy = std::chrono::steady_clock::now() - start;
+
+	writeUtilizationLog(args, dataset, numClaims, numItems, busy);
+}
+
+FRIF::Util::FileContents
+FRIF::Evaluations::Exemplar1N::Validation::readProbeTemplate(
+    const Data::Dataset &dataset,
+    const uint64_t datasetIndex,
+    const Arguments &args)
+{
+	const std::string &datasetName{std::get<std::string>(dataset)};
+	const auto identifier = std::get<std::string>(
+	    std::get<std::vector<Data::ImageSet>>(dataset).at(datasetIndex));
+
+	try {
+		const auto pathName = getProbeTemplatePath(datasetName,
+		    identifier, args);
+		if (args.prefetcher)
+			return (args.prefetcher->next(pathName));
+
+		/* Implementations may read the template in any order */
+		const auto mapping = std::make_shared<const Util::MappedFile>(
+		    pathName, Util::MappedFile::Access::WillNeed);
+		return {mapping->data(), mapping};
+	} catch (const std::exception &e) {
+		throw std::runtime_error{"Could not read probe template for "
+		    "id = " + identifier + " in dataset = " + datasetName +
+		    ": " + e.what()};
+	}
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::recordLatency(
+    const std::string &method,
+    const std::string &datasetName,
+    const std::chrono::steady_clock::time_point &start,
+    const std::chrono::steady_clock::time_point &stop,
+    const Arguments &args)
+{
+	std::string operation{method};
+	std::string dataset{datasetName};
+	switch (args.operation.value()) {
+	case Operation::CreateTemplates:
+		operation += *args.templateType == TemplateType::Probe ?
+		    "-probe" : "-reference";
+		break;
+	case Operation::SearchSubject:
+		[[fallthrough]];
+	case Operation::SearchSubjectPosition:
+		operation += args.operation == Operation::SearchSubject ?
+		    "-subject" : "-subject+position";
+		dataset += "_v_" + (args.dbDir ?
+		    args.dbDir->filename().string() : Util::NA);
+		break;
+	default:
+		break;
+	}
+
+	args.latencies->record(operation, dataset, start, stop);
+}
+
 void
 FRIF::Evaluations::Exemplar1N::Validation::runPartialCreateTemplates(
     const InterfaceVariant &iv,
@@ -1212,13 +2469,14 @@ FRIF::Evaluations::Exemplar1N::Validation::runPartialCreateTemplates(
 		    "was null"};
 
 	static const std::string header{"\"identifier\",elapsed,result,"
-	    "\"message\",type,num_images,size"};
+	    "\"message\",type,num_images,size,batch_size"};
 	static std::string typeStr = (*args.templateType ==
 	    TemplateType::Probe ? "probe" : "reference");
 
 	std::string prefix{"createTemplate-" + typeStr + '-' +
 	    std::get<std::string>(dataset)};
-	const auto createLogPath = makeLog(prefix, header, args.outputDir);
+	const auto createLogPath = makeLog(prefix, header +
+	    getPerfCountersHeader(args), args.outputDir);
 
 	std::ofstream createLog{createLogPath,
 	    std::ios_base::out | std::ios_base::app};
@@ -1242,8 +2500,8 @@ FRIF::Evaluations::Exemplar1N::Validation::runPartialCreateTemplates(
 
 		std::string extractPrefix{"extractTemplateData-" + typeStr +
 		    '-' + std::get<std::string>(dataset)};
-		extractDataLogPath = makeLog(extractPrefix, extractHeader,
-		    args.outputDir);
+		extractDataLogPath = makeLog(extractPrefix, extractHeader +
+		    getPerfCountersHeader(args), args.outputDir);
 		extractDataLog = std::ofstream{extractDataLogPath,
 		    std::ios_base::out | std::ios_base::app};
 		if (!extractDataLog)
@@ -1252,25 +2510,58 @@ FRIF::Evaluations::Exemplar1N::Validation::runPartialCreateTemplates(
 			    extractDataLogPath};
 	}
 
-	for (const auto &n : indices) {
-		const auto [createLogLine,  extractDataLogLine] =
-		    singleCreateTemplate(impl, dataset, n, args);
-		createLog << createLogLine << '\n';
-		if (!createLog)
-			throw std::runtime_error{Util::ts(getpid()) + ": Error "
-			    "writing to create log"};
-
-		/*
-		 * Perform template data extraction.
-		 */
-		if (doExtract && extractDataLogLine) {
-			extractDataLog << *extractDataLogLine << '\n';
-			if (!extractDataLog)
-				throw std::runtime_error{Util::ts(getpid()) +
-				    ": Error writing to extract template data "
-				    "log"};
+	/* Create templates for one chunk of claimed indices */
+	const auto createChunk = [&](const std::vector<uint64_t> &claimed,
+	    const Arguments &workerArgs) {
+		for (std::vector<uint64_t>::size_type i{0}; i < claimed.size();
+		    i += workerArgs.batchSize) {
+			std::vector<std::pair<std::string,
+			    std::optional<std::string>>> logLines{};
+			if (workerArgs.batchSize == 1) {
+				logLines.push_back(singleCreateTemplate(impl,
+				    dataset, claimed[i], workerArgs));
+			} else {
+				const auto first = std::next(claimed.begin(),
+				    static_cast<std::ptrdiff_t>(i));
+				const auto last = std::next(first,
+				    static_cast<std::ptrdiff_t>(
+				    std::min<uint64_t>(workerArgs.batchSize,
+				    claimed.size() - i)));
+				logLines = batchCreateTemplate(impl, dataset,
+				    {first, last}, workerArgs);
+			}
+
+			for (const auto &[createLogLine, extractDataLogLine] :
+			    logLines) {
+				createLog << createLogLine << '\n';
+				if (!createLog)
+					throw std::runtime_error{Util::ts(
+					    getpid()) + ": Error writing to "
+					    "create log"};
+
+				/*
+				 * Perform template data extraction.
+				 */
+				if (doExtract && extractDataLogLine) {
+					extractDataLog << *extractDataLogLine <<
+					    '\n';
+					if (!extractDataLog)
+						throw std::runtime_error{
+						    Util::ts(getpid()) +
+						    ": Error writing to "
+						    "extract template data "
+						    "log"};
+				}
+			}
 		}
-	}
+	};
+
+	processClaims(dataset, indices, args, [&](const ClaimFunction &claim,
+	    const Arguments &workerArgs) {
+		for (auto claimed = claim(); !claimed.empty();
+		    claimed = claim())
+			createChunk(claimed, workerArgs);
+	});
 }
 
 void
@@ -1298,9 +2589,9 @@ FRIF::Evaluations::Exemplar1N::Validation::runPartialSearch(
 	static const std::string searchHeader = "\"probe_identifier\","
 	    "max_candidates,elapsed,result,\"message\",include_fgp,cl_present,"
 	    "decision,num_candidates,rank,\"candidate_id\",candidate_fgp,"
-	    "similarity";
-	const auto searchLogPath = makeLog(searchPrefix, searchHeader,
-	    args.outputDir);
+	    "similarity,batch_size,termination";
+	const auto searchLogPath = makeLog(searchPrefix, searchHeader +
+	    getPerfCountersHeader(args), args.outputDir, args.threadNum);
 	std::ofstream searchLog{searchLogPath,
 	    std::ios_base::out | std::ios_base::app};
 	if (!searchLog)
@@ -1323,8 +2614,9 @@ FRIF::Evaluations::Exemplar1N::Validation::runPartialSearch(
 		const std::string correspondencePrefix{
 		    "extractCorrespondence-" + searchType + '-' +
 		    std::get<std::string>(probes) + "_v_" + databaseName};
-		correspondenceLogPath = makeLog(correspondencePrefix, header,
-		    args.outputDir);
+		correspondenceLogPath = makeLog(correspondencePrefix, header +
+		    getPerfCountersHeader(args), args.outputDir,
+		    args.threadNum);
 		correspondenceLog = std::ofstream{correspondenceLogPath,
 		    std::ios_base::out | std::ios_base::app};
 		if (!correspondenceLog)
@@ -1333,24 +2625,68 @@ FRIF::Evaluations::Exemplar1N::Validation::runPartialSearch(
 			    correspondenceLogPath};
 	}
 
-	for (const auto &n : probeIndicies) {
-		const auto [searchLogLine, correspondenceLogLine] =
-		    singleSearch(impl, probes, n, args);
-		searchLog << searchLogLine << '\n';
-		if (!searchLog)
-			throw std::runtime_error{Util::ts(getpid()) + ": Error "
-			    "writing to search log"};
-
-		/*
-		 * Perform correspondence extraction.
-		 */
-		if (doCorrespondence && correspondenceLogLine) {
-			correspondenceLog << *correspondenceLogLine << '\n';
-			if (!correspondenceLog)
+	std::optional<std::chrono::steady_clock::time_point> firstResult{};
+	const auto writeLogLines = [&](const std::vector<std::pair<std::string,
+	    std::optional<std::string>>> &logLines) {
+		if (!firstResult)
+			firstResult = std::chrono::steady_clock::now();
+
+		for (const auto &[searchLogLine, correspondenceLogLine] :
+		    logLines) {
+			searchLog << searchLogLine << '\n';
+			if (!searchLog)
 				throw std::runtime_error{Util::ts(getpid()) +
-				    ": Error writing to correspondence log"};
+				    ": Error writing to search log"};
+
+			/*
+			 * Perform correspondence extraction.
+			 */
+			if (doCorrespondence && correspondenceLogLine) {
+				correspondenceLog << *correspondenceLogLine <<
+				    '\n';
+				if (!correspondenceLog)
+					throw std::runtime_error{Util::ts(
+					    getpid()) + ": Error writing to "
+					    "correspondence log"};
+			}
 		}
-	}
+	};
+
+	/* Search one chunk of claimed indices */
+	const auto searchChunk = [&](const std::vector<uint64_t> &claimed,
+	    const Arguments &workerArgs) {
+		for (std::vector<uint64_t>::size_type i{0}; i < claimed.size();
+		    i += workerArgs.batchSize) {
+			if (workerArgs.batchSize == 1) {
+				writeLogLines({singleSearch(impl, probes,
+				    claimed[i], workerArgs)});
+			} else {
+				const auto first = std::next(claimed.begin(),
+				    static_cast<std::ptrdiff_t>(i));
+				const auto last = std::next(first,
+				    static_cast<std::ptrdiff_t>(
+				    std::min<uint64_t>(workerArgs.batchSize,
+				    claimed.size() - i)));
+				writeLogLines(batchSearch(impl, probes,
+				    {first, last}, workerArgs));
+			}
+		}
+	};
+
+	processClaims(probes, probeIndicies, args, [&](
+	    const ClaimFunction &claim, const Arguments &workerArgs) {
+		if (workerArgs.queueDepth > 0) {
+			asyncSearch(impl, probes, claim, workerArgs,
+			    writeLogLines);
+			return;
+		}
+
+		for (auto claimed = claim(); !claimed.empty();
+		    claimed = claim())
+			searchChunk(claimed, workerArgs);
+	});
+
+	writeLoadLog(args, probes, firstResult);
 }
 
 void
@@ -1369,40 +2705,74 @@ FRIF::Evaluations::Exemplar1N::Validation::singleCreateDatabase(
 	    ("createDatabase-" + datasetName + ".log");
 	auto logFile = std::ofstream{logFilePath,
 	    std::ios_base::out | std::ios_base::trunc};
-	logFile << "\"databaseName\",duration,result,\"message\"\n";
+	logFile << "\"databaseName\",duration,result,\"message\"" <<
+	    getPerfCountersHeader(args) << '\n';
 	if (!logFile)
 		throw std::runtime_error{"Failed to write create database "
 		    "header to " + logFilePath.string()};
 
-	ReturnStatus rs{};
-	std::chrono::steady_clock::time_point start{}, stop{};
-	try {
-
-		start = std::chrono::steady_clock::now();
-		rs = impl->createReferenceDatabase(archive,
-		    args.outputDir / Data::DatabaseDir / datasetName,
-		    args.maximum);
-		stop = std::chrono::steady_clock::now();
-	} catch (const std::exception &e) {
-		throw std::runtime_error{"Exception while creating database "
-		    "for dataset = " + datasetName + " (" + e.what() +
-		    ")"};
-	} catch (...) {
-		throw std::runtime_error{"Exception while creating database "
-		    "for dataset = " + datasetName};
+	const auto createDatabase = [&](const TemplateArchive &templates,
+	    const std::filesystem::path &databaseDir,
+	    const std::string &databaseName) {
+		ReturnStatus rs{};
+		std::chrono::steady_clock::time_point start{}, stop{};
+		startPerfCounters(args.perfCounters);
+		try {
+			start = std::chrono::steady_clock::now();
+			rs = impl->createReferenceDatabase(templates,
+			    databaseDir, args.maximum);
+			stop = std::chrono::steady_clock::now();
+		} catch (const std::exception &e) {
+			throw std::runtime_error{"Exception while creating "
+			    "database for dataset = " + databaseName + " (" +
+			    e.what() + ")"};
+		} catch (...) {
+			throw std::runtime_error{"Exception while creating "
+			    "database for dataset = " + databaseName};
+		}
+		const auto counts = stopPerfCounters(args.perfCounters);
+		recordLatency("createReferenceDatabase", databaseName, start,
+		    stop, args);
+
+		logFile << '"' << databaseName << "\"," <<
+		    Util::duration(start, stop) << ',' <<
+		    Util::e2i2s(rs.result) << ',' <<
+		    Util::sanitizeMessage(rs.message ? *rs.message : "") <<
+		    makePerfCountersColumns(counts, args) << '\n';
+		if (!logFile)
+			throw std::runtime_error{"Failed to write to create "
+			    "database log " + logFilePath.string()};
+
+		if (!rs)
+			throw std::runtime_error{"Failed to create database "
+			    "for dataset = " + databaseName + (rs.message ?
+			    ": (" + *rs.message + ")" : "")};
+	};
+
+	const auto databaseDir = args.outputDir / Data::DatabaseDir /
+	    datasetName;
+	if (args.incremental) {
+		/* Checked in parseArguments that there is a single shard */
+		const auto halves = splitTemplateArchive(archive, 2, 0);
+		createDatabase(halves.front(), databaseDir, datasetName);
+		modifyDatabase(impl, halves.back(), databaseDir, datasetName,
+		    args);
+		return;
+	}
+	if (args.numShards == 1) {
+		createDatabase(archive, databaseDir, datasetName);
+		return;
 	}
 
-	logFile << '"' << datasetName << "\"," <<
-	    Util::duration(start, stop) << ',' << Util::e2i2s(rs.result) <<
-	    ',' << Util::sanitizeMessage(rs.message ? *rs.message : "");
-	if (!logFile)
-		throw std::runtime_error{"Failed to write to create database "
-		    "log " + logFilePath.string()};
-
-	if (!rs)
-		throw std::runtime_error{"Failed to create database for "
-		    "dataset = " + datasetName + (rs.message ?
-		    ": (" + *rs.message + ")" : "")};
+	const auto shards = splitTemplateArchive(archive, args.numShards,
+	    args.maximum);
+	for (uint16_t shard{0}; shard < shards.size(); ++shard) {
+		const auto shardDir = getShardDir(databaseDir, shard);
+		std::filesystem::create_directories(shardDir);
+		createDatabase(shards[shard], shardDir, datasetName + '/' +
+		    shardDir.filename().string());
+	}
+	writeShardAssignments(shards, databaseDir);
 }
 
 std::pair<std::string, std::optional<std::string>>
@@ -1426,13 +2796,17 @@ FRIF::Evaluations::Exemplar1N::Validation::singleCreateTemplate(
 		    ")"};
 	}
 
-	std::tuple<ReturnStatus, std::optional< CreateTemplateResult>> ret{};
+	/* Everything built for this template is released at once on return */
+	auto arena = makeRequestArena();
+	std::tuple<ReturnStatus, std::optional<pmr::CreateTemplateResult>>
+	    ret{};
 	std::chrono::steady_clock::time_point start{}, stop{};
+	startPerfCounters(args.perfCounters);
 	try {
 
 		start = std::chrono::steady_clock::now();
 		ret = impl->createTemplate(*args.templateType, identifier,
-		    samples);
+		    samples, &arena);
 		stop = std::chrono::steady_clock::now();
 	} catch (const std::exception &e) {
 		throw std::runtime_error{"Exception while creating template "
@@ -1444,43 +2818,12 @@ FRIF::Evaluations::Exemplar1N::Validation::singleCreateTemplate(
 		    "template from ID = " + identifier + ",  dataset = " +
 		    datasetName + ", index = " + Util::ts(datasetIndex)};
 	}
+	const auto counts = stopPerfCounters(args.perfCounters);
 
-	const auto &[rv, ctr] = ret;
-	std::string logLineCreate{'"' + identifier + "\"," +
-	    Util::duration(start, stop) + ',' + Util::e2i2s(rv.result) + ',' +
-	    Util::sanitizeMessage(rv.message ? *rv.message : "") + ',' +
-	    Util::e2i2s(*args.templateType) + ',' + Util::ts(samples.size()) +
-	    ','};
-	std::optional<std::string> logLineExtractData{};
-
-	const bool doExtract = *args.templateType ==
-	    TemplateType::Probe ? impl->getCompatibility().
-	    supportsProbeTemplateIntrospection : impl->getCompatibility().
-	    supportsReferenceTemplateIntrospection;
-
-	/* Write template */
-	const auto dir = args.outputDir /
-	    Data::getTemplateDir(*args.templateType) / datasetName;
-	if (rv && ctr) {
-		Util::writeFile(ctr->data,
-		    dir / (identifier + Data::TemplateSuffix));
-		logLineCreate += Util::ts(ctr->data.size());
-
-		if (ctr->extractedData) {
-			logLineExtractData = makeExtractTemplateDataLogLine(
-			    identifier, Util::duration(start, stop),
-			    ctr->extractedData, rv, args);
-		} else if (doExtract) {
-			logLineExtractData = singleExtractTemplateData(impl,
-			    dataset, datasetIndex, ctr.value(), args);
-		}
-
-	} else {
-		Util::writeFile({}, dir / (identifier + Data::TemplateSuffix));
-		logLineCreate += Util::NA;
-	}
+	recordLatency("createTemplate", datasetName, start, stop, args);
 
-	return {logLineCreate, logLineExtractData};
+	return (makeCreateTemplateLogLine(impl, dataset, datasetIndex, start,
+	    stop, counts, samples.size(), ret, 1, args));
 }
 
 std::string
@@ -1488,7 +2831,7 @@ FRIF::Evaluations::Exemplar1N::Validation::singleExtractTemplateData(
     std::shared_ptr<ExtractionInterface> impl,
     const Data::Dataset &dataset,
     const uint64_t datasetIndex,
-    const CreateTemplateResult &templateResult,
+    const pmr::CreateTemplateResult &templateResult,
     const Arguments &args)
 {
 	if (!args.templateType)
@@ -1506,14 +2849,15 @@ FRIF::Evaluations::Exemplar1N::Validation::singleExtractTemplateData(
 	const std::string &identifier = std::get<std::string>(
 	    std::get<std::vector<Data::ImageSet>>(dataset).at(datasetIndex));
 
-	std::optional<std::tuple<ReturnStatus, std::vector<TemplateData>>>
-	    ret{};
+	std::optional<std::tuple<ReturnStatus,
+	    std::pmr::vector<pmr::TemplateData>>> ret{};
 	std::chrono::steady_clock::time_point start{}, stop{};
+	startPerfCounters(args.perfCounters);
 	try {
 
 		start = std::chrono::steady_clock::now();
 		ret = impl->extractTemplateData(*args.templateType,
-		    templateResult);
+		    templateResult, templateResult.get_allocator().resource());
 		stop = std::chrono::steady_clock::now();
 	} catch (const std::exception &e) {
 		throw std::runtime_error{"Exception while extracting template "
@@ -1525,12 +2869,16 @@ FRIF::Evaluations::Exemplar1N::Validation::singleExtractTemplateData(
 		    "template data from ID = " + identifier + ",  dataset = " +
 		    datasetName + ", index = " + Util::ts(datasetIndex)};
 	}
+	const auto counts = stopPerfCounters(args.perfCounters);
+	recordLatency("extractTemplateData", datasetName, start, stop, args);
 
 	return (makeExtractTemplateDataLogLine(
 	    identifier,
 	    Util::duration(start, stop),
-	    ret ? std::optional<std::vector<TemplateData>>{
-	        std::get<std::vector<TemplateData>>(*ret)} : std::nullopt,
+	    counts,
+	    ret ? std::optional<std::pmr::vector<pmr::TemplateData>>{
+	        std::get<std::pmr::vector<pmr::TemplateData>>(
+	        std::move(*ret))} : std::nullopt,
 	    ret ? std::optional<ReturnStatus>{
 	        std::get<ReturnStatus>(*ret)} : std::nullopt,
 	    args));
@@ -1543,20 +2891,7 @@ FRIF::Evaluations::Exemplar1N::Validation::singleSearch(
     const uint64_t datasetIndex,
     const Arguments &args)
 {
-	const std::string &datasetName{std::get<std::string>(dataset)};
-	const auto identifier = std::get<std::string>(
-	    std::get<std::vector<Data::ImageSet>>(dataset).at(datasetIndex));
-
-	std::vector<std::byte> probe{};
-	try {
-		const std::string tmplName{identifier + ".tmpl"};
-		probe = Util::readFile(args.outputDir / Data::ProbeTemplateDir /
-		    datasetName / tmplName);
-	} catch (const std::exception &e) {
-		throw std::runtime_error{"Could not read probe template for "
-		    "id = " + identifier + " in dataset = " + datasetName +
-		    ": " + e.what()};
-	}
+	const auto probe = readProbeTemplate(dataset, datasetIndex, args);
 
 	/*
 	 * NOTE: We don't search 0-byte templates, even if that's what was
@@ -1570,151 +2905,39 @@ FRIF::Evaluations::Exemplar1N::Validation::singleSearch(
 	/* Checked in parseArguments */
 	const uint16_t maxCandidates = static_cast<uint16_t>(args.maximum);
 
-	const bool doCorrespondence =
-	    impl->getCompatibility().supportsCorrespondence;
-
 	std::chrono::steady_clock::time_point start{}, stop{};
+	Util::PerfCounters::Counts counts{};
 	ReturnStatus rs{};
 	std::variant<std::optional<SearchSubjectResult>,
 	    std::optional<SearchSubjectPositionResult>> result{};
 	if (args.operation == Operation::SearchSubject) {
-		auto ret = executeSingleSearchSubject(impl, probe,
-		    maxCandidates);
+		auto ret = executeSingleSearchSubject(impl, probe.data,
+		    maxCandidates, args.timeLimit, args.minSimilarity,
+		    args.perfCounters);
 		rs = std::get<ReturnStatus>(ret);
 		result = std::get<std::optional<SearchSubjectResult>>(ret);
 		start = std::get<0>(ret);
 		stop = std::get<1>(ret);
+		counts = std::get<2>(ret);
 	} else if (args.operation == Operation::SearchSubjectPosition) {
-		auto ret = executeSingleSearchSubjectPosition(impl, probe,
-		    maxCandidates);
+		auto ret = executeSingleSearchSubjectPosition(impl,
+		    probe.data, maxCandidates, args.timeLimit,
+		    args.minSimilarity, args.perfCounters);
 		rs = std::get<ReturnStatus>(ret);
 		result = std::get<std::optional<SearchSubjectPositionResult>>(
 		    ret);
 		start = std::get<0>(ret);
 		stop = std::get<1>(ret);
+		counts = std::get<2>(ret);
 	} else
 		throw std::runtime_error{"Unsupported operation sent to "
 		    "singleSearch()"};
 
-	const std::string logLinePrefix{'"' + identifier + "\"," +
-	    Util::ts(args.maximum) + ',' + Util::duration(start, stop) + ',' +
-	    Util::e2i2s(rs.result) + ',' +
-	    Util::sanitizeMessage(rs.message ? *rs.message : "") + ','};
-
-	std::string logLine{};
-	const bool includeFGP{
-	    args.operation == Operation::SearchSubjectPosition};
-	if (!rs) {
-		logLine += logLinePrefix + std::to_string(includeFGP) + ',' +
-		    Util::splice(std::vector<std::string>(7, Util::NA), ",");
-		return {logLine, std::nullopt};
-	}
-
-	if (args.operation == Operation::SearchSubject) {
-		const auto &optRes = std::get<std::optional<
-		    SearchSubjectResult>>(result);
-		if (!optRes.has_value()) {
-			logLine += logLinePrefix + std::to_string(includeFGP) +
-			    ',' + std::to_string(optRes.has_value()) + ',' +
-			    Util::splice(std::vector<std::string>(6, Util::NA),
-			    ",");
-			return {logLine, std::nullopt};
-		}
-		if (optRes->candidateList.empty()) {
-			logLine += logLinePrefix + std::to_string(includeFGP) +
-			    ',' + std::to_string(optRes.has_value()) + ',' +
-			    Util::splice(std::vector<std::string>(6, Util::NA),
-			    ",");
-			return {logLine, std::nullopt};
-		}
-
-		/* Order by descending similarity */
-		std::vector<std::pair<std::string, double>> sorted{};
-		for (const auto &[k,v] : optRes->candidateList)
-			sorted.emplace_back(k, v);
-		std::stable_sort(sorted.begin(), sorted.end(), [](
-		    const SubjectCandidateList::value_type &a,
-		    const SubjectCandidateList::value_type &b) {
-			return (std::get<double>(a) > std::get<double>(b));
-		});
-
-		std::vector<SubjectCandidateList::value_type>::size_type rank{};
-		for (const auto &[candidateID, similarity] : sorted) {
-			logLine += logLinePrefix + std::to_string(includeFGP) +
-			    ',' + std::to_string(optRes.has_value()) + ',' +
-			    Util::ts(optRes->decision) + ',' +
-			    Util::ts(optRes->candidateList.size()) + ',' +
-			    Util::ts(++rank) + ",\"" + candidateID + "\"," +
-			    Util::NA + "," + Util::ts(similarity);
-			if (rank < optRes->candidateList.size())
-				logLine += '\n';
-		}
-
-		/* Log or call correspondence */
-		if (optRes->correspondence.has_value())
-			return {logLine, makeExtractCorrespondenceLogLine(
-			    identifier, Util::duration(start, stop), *optRes,
-			    args)};
-		else if (doCorrespondence)
-			return {logLine, singleExtractCorrespondence(
-			    impl, dataset, datasetIndex, *optRes, args)};
-		else
-			return {logLine, std::nullopt};
-	} else if (args.operation == Operation::SearchSubjectPosition) {
-		const auto &optRes = std::get<std::optional<
-		    SearchSubjectPositionResult>>(result);
-		if (!optRes.has_value()) {
-			logLine += logLinePrefix + std::to_string(includeFGP) +
-			    ',' + std::to_string(optRes.has_value()) + ',' +
-			    Util::splice(std::vector<std::string>(6, Util::NA),
-			    ",");
-			return {logLine, std::nullopt};
-		}
-		if (optRes->candidateList.empty()) {
-			logLine += logLinePrefix + std::to_string(includeFGP) +
-			    ',' + std::to_string(optRes.has_value()) + ',' +
-			    Util::splice(std::vector<std::string>(6, Util::NA),
-			    ",");
-			return {logLine, std::nullopt};
-		}
-
-		/* Order by descending similarity */
-		std::vector<std::pair<SubjectPositionCandidate, double>>
-		    sorted{};
-		for (const auto &[k, v] : optRes->candidateList)
-			sorted.emplace_back(k, v);
-		std::stable_sort(sorted.begin(), sorted.end(), [](
-		    const SubjectPositionCandidateList::value_type &a,
-		    const SubjectPositionCandidateList::value_type &b) {
-			return (std::get<double>(a) > std::get<double>(b));
-		});
-
-		std::vector<SubjectPositionCandidateList::value_type>::size_type
-		    rank{};
-		for (const auto &[c, similarity] : sorted) {
-			logLine += logLinePrefix + std::to_string(includeFGP) +
-			    ',' + std::to_string(optRes.has_value()) + ',' +
-			    Util::ts(optRes->decision) + ',' +
-			    Util::ts(optRes->candidateList.size()) + ',' +
-			    Util::ts(++rank) + ",\"" + c.identifier + "\"," +
-			    Util::e2i2s(c.fgp) + "," + Util::ts(similarity);
-			if (rank < optRes->candidateList.size())
-				logLine += '\n';
-		}
+	recordLatency("search", std::get<std::string>(dataset), start, stop,
+	    args);
 
-		/* Log or call correspondence */
-		if (optRes->correspondence.has_value())
-			return {logLine, makeExtractCorrespondenceLogLine(
-			    identifier, Util::duration(start, stop), *optRes,
-			    args)};
-		else if (doCorrespondence)
-			return {logLine, singleExtractCorrespondence(
-			    impl, dataset, datasetIndex, *optRes, args)};
-		else
-			return {logLine, std::nullopt};
-	} else
-		throw std::runtime_error{"Unsupported operation sent to "
-		    "singleSearch()"};
+	return (makeSearchLogLine(impl, dataset, datasetIndex, probe.data,
+	    start, stop, counts, rs, result, 1, args));
 }
 
 std::string
@@ -1722,6 +2945,7 @@ FRIF::Evaluations::Exemplar1N::Validation::singleExtractCorrespondence(
     std::shared_ptr<SearchInterface> impl,
     const Data::Dataset &dataset,
     const uint64_t datasetIndex,
+    std::span<const std::byte> probe,
     const std::variant<SearchSubjectResult, SearchSubjectPositionResult>
         &result,
     const Arguments &args)
@@ -1730,32 +2954,13 @@ FRIF::Evaluations::Exemplar1N::Validation::singleExtractCorrespondence(
 		throw std::runtime_error{"Implementation does not support "
 		    "correspondence"};
 
-	const std::string &datasetName{std::get<std::string>(dataset)};
 	const auto identifier = std::get<std::string>(
 	    std::get<std::vector<Data::ImageSet>>(dataset).at(datasetIndex));
 
-	std::vector<std::byte> probe{};
-	try {
-		probe = Util::readFile(args.outputDir / Data::TemplateDir /
-		    datasetName / identifier);
-	} catch (const std::exception &e) {
-		throw std::runtime_error{"Could not read probe template for "
-		    "id = " + identifier + " in dataset = " + datasetName +
-		    ": " + e.what()};
-	}
-
-	/*
-	 * NOTE: We don't search 0-byte templates, even if that's what was
-	 *       returned, but we also don't want your submission to crash.
-	 *       Hopefully passing a 0-byte template during validation will
-	 *       encourage you to validate templates first.
-	 */
-//	if (probeTemplate.size() == 0) {
-//	}
-
 	std::chrono::steady_clock::time_point start{}, stop{};
 	std::variant<std::optional<SubjectCandidateListCorrespondence>,
 	    std::optional<SubjectPositionCandidateListCorrespondence>> corr{};
+	startPerfCounters(args.perfCounters);
 	if (args.operation == Operation::SearchSubject) {
 		auto ssr = std::get<SearchSubjectResult>(result);
 		try {
@@ -1789,9 +2994,72 @@ FRIF::Evaluations::Exemplar1N::Validation::singleExtractCorrespondence(
 	} else
 		throw std::runtime_error{"Unsupported operation sent to "
 		    "singleExtractCorrespondence()"};
+	const auto counts = stopPerfCounters(args.perfCounters);
+
+	recordLatency("extractCorrespondence", std::get<std::string>(dataset),
+	    start, stop, args);
 
 	return (makeExtractCorrespondenceLogLine(identifier,
-	    Util::duration(start, stop), result, args));
+	    Util::duration(start, stop), counts, result, args));
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::startPerfCounters(
+    const bool enabled)
+{
+	if (enabled)
+		getPerfCounters().start();
+}
+
+FRIF::Util::PerfCounters::Counts
+FRIF::Evaluations::Exemplar1N::Validation::stopPerfCounters(
+    const bool enabled)
+{
+	if (!enabled)
+		return {};
+
+	return (getPerfCounters().stop());
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::threadOperation(
+    const InterfaceVariant &impl,
+    const Arguments &args,
+    const Data::Dataset &dataset,
+    const std::vector<uint64_t> &indices,
+    const std::function<void(InterfaceVariant, const Data::Dataset&,
+        const std::vector<uint64_t>&, const Arguments&)> &fn)
+{
+	if (!std::get_if<std::shared_ptr<SearchInterface>>(&impl))
+		throw std::runtime_error{"Threads (-t) are only supported when "
+		    "searching"};
+	if (!SearchInterface::getCompatibility().supportsConcurrentSearch)
+		throw std::runtime_error{"SearchInterface does not support "
+		    "concurrent search. Use processes (-j) instead of threads "
+		    "(-t)."};
+
+	std::vector<std::exception_ptr> errors(args.numThreads);
+	std::vector<std::thread> threads{};
+	threads.reserve(args.numThreads);
+	for (uint8_t i{0}; i < args.numThreads; ++i) {
+		/* Give each thread its own log files */
+		Arguments threadArgs{args};
+		threadArgs.threadNum = i;
+
+		threads.emplace_back([&, i, threadArgs]() {
+			try {
+				fn(impl, dataset, indices, threadArgs);
+			} catch (...) {
+				errors[i] = std::current_exception();
+			}
+		});
+	}
+
+	for (auto &thread : threads)
+		thread.join();
+	for (const auto &error : errors)
+		if (error)
+			std::rethrow_exception(error);
 }
 
 void
@@ -1831,6 +3099,217 @@ FRIF::Evaluations::Exemplar1N::Validation::waitForExit(
 	}
 }
 
+void
+FRIF::Evaluations::Exemplar1N::Validation::writeLatencyLogs(
+    const Arguments &args,
+    const bool forMerge)
+{
+	if (args.latencies->empty())
+		return;
+
+	if (forMerge) {
+		args.latencies->write(getLatencyHistogramPath(args.outputDir,
+		    getpid()));
+		return;
+	}
+
+	const auto logPath = makeLog("latency",
+	    LatencyRecorder::getSummaryHeader(), args.outputDir);
+	args.latencies->writeSummary(logPath);
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::writeLoadLog(
+    const Arguments &args,
+    const Data::Dataset &dataset,
+    const std::optional<std::chrono::steady_clock::time_point> &firstResult)
+{
+	static const std::string header{"\"dataset\",\"database\","
+	    "load_budget,load_elapsed,first_result_elapsed"};
+
+	const std::string searchType =
+	    args.operation == Operation::SearchSubject ? "subject" :
+	    "subject+position";
+	const std::string datasetName{std::get<std::string>(dataset)};
+	const std::string databaseName{args.dbDir ?
+	    args.dbDir->filename().string() : Util::NA};
+	const auto logPath = makeLog("load-search-" + searchType + '-' +
+	    datasetName + "_v_" + databaseName, header, args.outputDir,
+	    args.threadNum);
+	std::ofstream log{logPath, std::ios_base::out | std::ios_base::app};
+	log << '"' << datasetName << "\",\"" << databaseName << "\"," <<
+	    Util::ts(args.loadBudget) << ',' <<
+	    Util::duration(args.loadStart, args.loadStop) << ',' <<
+	    (firstResult ? Util::duration(args.loadStart, *firstResult) :
+	    Util::NA) << '\n';
+	if (!log)
+		throw std::runtime_error{Util::ts(getpid()) + ": Error "
+		    "writing to load log"};
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::writeMemoryLog(
+    const Arguments &args,
+    const Data::Dataset &dataset,
+    const std::string &mode,
+    const uint8_t numWorkers)
+{
+	static const std::string header{"\"dataset\",\"database\",mode,"
+	    "num_workers,rss_kib,pss_kib,shared_kib,private_kib"};
+
+	/* Sum the kB fields we need from the rollup of all mappings */
+	uint64_t rss{}, pss{}, shared{}, priv{};
+	bool havePSS{false};
+	std::ifstream smaps{"/proc/self/smaps_rollup"};
+	std::string line{};
+	while (std::getline(smaps, line)) {
+		std::istringstream fields{line};
+		std::string key{};
+		uint64_t value{};
+		if (!(fields >> key >> value))
+			continue;
+
+		if (key == "Rss:")
+			rss = value;
+		else if (key == "Pss:") {
+			pss = value;
+			havePSS = true;
+		} else if ((key == "Shared_Clean:") ||
+		    (key == "Shared_Dirty:"))
+			shared += value;
+		else if ((key == "Private_Clean:") ||
+		    (key == "Private_Dirty:"))
+			priv += value;
+	}
+
+	const std::string searchType =
+	    args.operation == Operation::SearchSubject ? "subject" :
+	    "subject+position";
+	const std::string datasetName{std::get<std::string>(dataset)};
+	const std::string databaseName{args.dbDir ?
+	    args.dbDir->filename().string() : Util::NA};
+	const auto logPath = makeLog("memory-search-" + searchType + '-' +
+	    datasetName + "_v_" + databaseName, header, args.outputDir);
+	std::ofstream log{logPath, std::ios_base::out | std::ios_base::app};
+	log << '"' << datasetName << "\",\"" << databaseName << "\"," <<
+	    mode << ',' << Util::ts(numWorkers) << ',' <<
+	    (havePSS ? Util::ts(rss) : Util::NA) << ',' <<
+	    (havePSS ? Util::ts(pss) : Util::NA) << ',' <<
+	    (havePSS ? Util::ts(shared) : Util::NA) << ',' <<
+	    (havePSS ? Util::ts(priv) : Util::NA) << '\n';
+	if (!log)
+		throw std::runtime_error{Util::ts(getpid()) + ": Error "
+		    "writing to memory log"};
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::writePerfCountersLog(
+    const Arguments &args,
+    const Data::Dataset &dataset,
+    const uint64_t numItems,
+    const Util::PerfCounters::Counts &counts)
+{
+	const std::string header{"\"dataset\",mode,num_workers,num_items" +
+	    getPerfCountersHeader(args)};
+
+	std::string prefix{"counters-"};
+	switch (args.operation.value()) {
+	case Operation::CreateTemplates:
+		prefix += "createTemplate-" + std::string{*args.templateType ==
+		    TemplateType::Probe ? "probe" : "reference"} + '-' +
+		    std::get<std::string>(dataset);
+		break;
+	case Operation::SearchSubject:
+		[[fallthrough]];
+	case Operation::SearchSubjectPosition:
+		prefix += "search-" + std::string{args.operation ==
+		    Operation::SearchSubject ? "subject" :
+		    "subject+position"} + '-' + std::get<std::string>(dataset) +
+		    "_v_" + (args.dbDir ? args.dbDir->filename().string() :
+		    Util::NA);
+		break;
+	default:
+		throw std::runtime_error{"Unsupported operation sent to "
+		    "writePerfCountersLog()"};
+	}
+
+	std::string mode{"single"};
+	uint8_t numWorkers{1};
+	if (args.numThreads > 1) {
+		mode = "thread";
+		numWorkers = args.numThreads;
+	} else if (args.numProcs > 1) {
+		mode = "fork";
+		numWorkers = args.numProcs;
+	}
+
+	const auto logPath = makeLog(prefix, header, args.outputDir);
+	std::ofstream log{logPath, std::ios_base::out | std::ios_base::app};
+	log << '"' << std::get<std::string>(dataset) << "\"," << mode << ',' <<
+	    Util::ts(numWorkers) << ',' << Util::ts(numItems) <<
+	    makePerfCountersColumns(counts, args) << '\n';
+	if (!log)
+		throw std::runtime_error{Util::ts(getpid()) + ": Error "
+		    "writing to counters log"};
+}
+
+void
+FRIF::Evaluations::Exemplar1N::Validation::writeUtilizationLog(
+    const Arguments &args,
+    const Data::Dataset &dataset,
+    const uint64_t numClaims,
+    const uint64_t numItems,
+    const std::chrono::steady_clock::duration &busy)
+{
+	static const std::string header{"\"dataset\",mode,num_workers,"
+	    "chunk_size,num_claims,num_items,busy_elapsed,finish_elapsed"};
+	const auto finish = std::chrono::steady_clock::now();
+
+	std::string prefix{"utilization-"};
+	switch (args.operation.value()) {
+	case Operation::CreateTemplates:
+		prefix += "createTemplate-" + std::string{*args.templateType ==
+		    TemplateType::Probe ? "probe" : "reference"} + '-' +
+		    std::get<std::string>(dataset);
+		break;
+	case Operation::SearchSubject:
+		[[fallthrough]];
+	case Operation::SearchSubjectPosition:
+		prefix += "search-" + std::string{args.operation ==
+		    Operation::SearchSubject ? "subject" :
+		    "subject+position"} + '-' + std::get<std::string>(dataset) +
+		    "_v_" + (args.dbDir ? args.dbDir->filename().string() :
+		    Util::NA);
+		break;
+	default:
+		throw std::runtime_error{"Unsupported operation sent to "
+		    "writeUtilizationLog()"};
+	}
+
+	std::string mode{"single"};
+	uint8_t numWorkers{1};
+	if (args.numThreads > 1) {
+		mode = "thread";
+		numWorkers = args.numThreads;
+	} else if (args.numProcs > 1) {
+		mode = "fork";
+		numWorkers = args.numProcs;
+	}
+
+	const auto logPath = makeLog(prefix, header, args.outputDir,
+	    args.threadNum);
+	std::ofstream log{logPath, std::ios_base::out | std::ios_base::app};
+	log << '"' << std::get<std::string>(dataset) << "\"," << mode << ',' <<
+	    Util::ts(numWorkers) << ',' << (args.workQueue ?
+	    Util::ts(args.workQueue->getChunkSize()) : Util::NA) << ',' <<
+	    Util::ts(numClaims) << ',' << Util::ts(numItems) << ',' <<
+	    Util::duration(finish - busy, finish) << ',' <<
+	    Util::duration(args.loadStop, finish) << '\n';
+	if (!log)
+		throw std::runtime_error{Util::ts(getpid()) + ": Error "
+		    "writing to utilization log"};
+}
+
 int
 main(
     int argc,
@@ -1839,8 +3318,8 @@ main(
 	/*
 	 * Check FRIF API version.
 	 */
-	static const uint16_t expectedFRIFMajor{1};
-	static const uint16_t expectedFRIFMinor{2};
+	static const uint16_t expectedFRIFMajor{2};
+	static const uint16_t expectedFRIFMinor{0};
 	static const uint16_t expectedFRIFPatch{0};
 	if (!((FRIF::API_MAJOR_VERSION == expectedFRIFMajor) &&
 	    (FRIF::API_MINOR_VERSION == expectedFRIFMinor) &&
@@ -1859,8 +3338,8 @@ main(
 	/*
 	 * Check E1N API version.
 	 */
-	static const uint16_t expectedE1NMajor{1};
-	static const uint16_t expectedE1NMinor{2};
+	static const uint16_t expectedE1NMajor{2};
+	static const uint16_t expectedE1NMinor{0};
 	static const uint16_t expectedE1NPatch{0};
 	if (!((FRIF::Evaluations::Exemplar1N::API_MAJOR_VERSION ==
 	    expectedE1NMajor) &&
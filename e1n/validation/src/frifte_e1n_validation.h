@@ -11,13 +11,18 @@
 #ifndef FRIF_E1N_VALIDATION_H_
 #define FRIF_E1N_VALIDATION_H_
 
+#include <chrono>
 #include <filesystem>
 #include <memory>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <string>
 #include <utility>
 #include <variant>
 
+#include <sys/types.h>
+
 #include <frifte/e1n.h>
 
 namespace FRIF::Evaluations::Exemplar1N::Validation
@@ -26,6 +31,21 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	    std::shared_ptr<ExtractionInterface>,
 	    std::shared_ptr<SearchInterface>>;
 
+	/**
+	 * Number of chunks each worker would claim if work were divided
+	 * evenly. More chunks balance slow subjects better, at the cost of
+	 * more claims.
+	 */
+	const uint64_t ChunksPerWorker{16};
+
+	/**
+	 * Function returning the next chunk of indices claimed by a worker,
+	 * or an empty vector once all have been claimed.
+	 *
+	 * @see processClaims()
+	 */
+	using ClaimFunction = std::function<std::vector<uint64_t>()>;
+
 	/** Operations that this executable can perform. */
 	enum class Operation
 	{
@@ -39,6 +59,8 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 		IdentifyExtraction,
 		/** Print identification provided by SearchInterface. */
 		IdentifySearch,
+		/** Pack the images of each dataset into an ImagePack. */
+		PackImages,
 		/** Search, returning subject identifier only. */
 		SearchSubject,
 		/** Search, returning subject identifier and position. */
@@ -64,11 +86,89 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 		std::filesystem::path outputDir{"output"};
 		/** Directory containing images named in ImageSet. */
 		std::filesystem::path imageDir{"images"};
+		/**
+		 * Read images from each dataset's ImagePack within #imageDir
+		 * (Operation::CreateTemplates only).
+		 */
+		bool packedImages{false};
+		/** ImagePack of the dataset being processed, if any. */
+		std::shared_ptr<const Data::ImagePack> imagePack{};
 
 		/** Number of processes to fork. */
 		uint8_t numProcs{1};
+		/**
+		 * Number of threads sharing one SearchInterface (instead of
+		 * forking processes).
+		 */
+		uint8_t numThreads{1};
+		/** Index of the thread performing an operation, if threaded. */
+		std::optional<uint8_t> threadNum{};
+		/**
+		 * Positions in the indices being processed, claimed by all
+		 * workers of an operation.
+		 */
+		std::shared_ptr<Util::WorkQueue> workQueue{};
+		/** Latency of calls to the implementation in this process. */
+		std::shared_ptr<LatencyRecorder> latencies{
+		    std::make_shared<LatencyRecorder>()};
 		/** Maximum number of {candidates, DB size}. */
 		uint64_t maximum{};
+		/** Suggested bytes of memory for SearchInterface::load(). */
+		uint64_t loadBudget{1024 * 1024 * 1024};
+		/** When instantiating SearchInterface began (search only). */
+		std::chrono::steady_clock::time_point loadStart{};
+		/** When SearchInterface::load() returned (search only). */
+		std::chrono::steady_clock::time_point loadStop{};
+		/**
+		 * Number of shards to split each reference database into, or
+		 * 0 for the fewest that fit in #maximum
+		 * (Operation::CreateDatabases only).
+		 */
+		uint16_t numShards{1};
+		/**
+		 * Create each reference database from half of its templates
+		 * and change it in place to hold the rest
+		 * (Operation::CreateDatabases only).
+		 */
+		bool incremental{false};
+		/**
+		 * Number of searches kept in flight with SearchInterface's
+		 * asynchronous methods, or 0 to use the blocking methods.
+		 */
+		uint16_t queueDepth{};
+		/**
+		 * Number of subjects (Operation::CreateTemplates) or probe
+		 * templates (Operation::SearchSubject and
+		 * Operation::SearchSubjectPosition) sent with each call.
+		 */
+		uint16_t batchSize{1};
+		/**
+		 * Time after which each search should return its best
+		 * candidates so far (Operation::SearchSubject and
+		 * Operation::SearchSubjectPosition only).
+		 */
+		std::optional<std::chrono::milliseconds> timeLimit{};
+		/**
+		 * Similarity at which each search may stop early
+		 * (Operation::SearchSubject and
+		 * Operation::SearchSubjectPosition only).
+		 */
+		std::optional<double> minSimilarity{};
+		/**
+		 * Number of images (Operation::CreateTemplates) or probe
+		 * templates (Operation::SearchSubject and
+		 * Operation::SearchSubjectPosition) read ahead of their use,
+		 * or 0 to read each when needed.
+		 */
+		uint16_t prefetchDepth{};
+		/** Reader of upcoming files, if #prefetchDepth is set. */
+		std::shared_ptr<Util::FilePrefetcher> prefetcher{};
+		/**
+		 * Count hardware events around each call to the
+		 * implementation, logged as extra columns, or around the
+		 * whole run when calls overlap (see writePerfCountersLog()).
+		 */
+		bool perfCounters{false};
 
 		/**
 		 * Type of template to make (Operation::CreateTemplates only).
@@ -76,6 +176,97 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 		std::optional<TemplateType> templateType{};
 	};
 
+	/**
+	 * @brief
+	 * Run searches of probe templates, keeping several submitted to
+	 * SearchInterface's asynchronous methods at once.
+	 *
+	 * @param impl
+	 * Initialized SearchInterface implementation.
+	 * @param dataset
+	 * Dataset of samples.
+	 * @param claim
+	 * Function returning the next indices into `dataset` to search.
+	 * Searches stay in flight while more indices are claimed.
+	 * @param args
+	 * Arguments parsed from command line. At most `args.queueDepth`
+	 * searches will be in flight.
+	 * @param logFn
+	 * Function called with log strings, as returned from
+	 * makeSearchLogLine(), each time searches complete.
+	 *
+	 * @throw
+	 * Error reading templates, inconsistent tickets, or exception thrown
+	 * from implementation.
+	 *
+	 * @note
+	 * Elapsed time for each search is measured from submission until the
+	 * completion is returned.
+	 */
+	void
+	asyncSearch(
+	    std::shared_ptr<SearchInterface> impl,
+	    const Data::Dataset &dataset,
+	    const ClaimFunction &claim,
+	    const Arguments &args,
+	    const std::function<void(const std::vector<std::pair<std::string,
+		std::optional<std::string>>>&)> &logFn);
+
+	/**
+	 * @brief
+	 * Create templates for several samples with a single call.
+	 *
+	 * @param impl
+	 * Initialized ExtractionInterface implementation.
+	 * @param dataset
+	 * Dataset of samples.
+	 * @param datasetIndices
+	 * Indices into `dataset` corresponding to the samples to process.
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @return
+	 * One pair of strings for each of `datasetIndices`, as returned from
+	 * makeCreateTemplateLogLine().
+	 *
+	 * @throw
+	 * Data inconsistency observed, error writing data, or exception thrown
+	 * from implementation.
+	 */
+	std::vector<std::pair<std::string, std::optional<std::string>>>
+	batchCreateTemplate(
+	    std::shared_ptr<ExtractionInterface> impl,
+	    const Data::Dataset &dataset,
+	    const std::vector<uint64_t> &datasetIndices,
+	    const Arguments &args);
+
+	/**
+	 * @brief
+	 * Run a search of several probe templates with a single call.
+	 *
+	 * @param impl
+	 * Initialized SearchInterface implementation.
+	 * @param dataset
+	 * Dataset of samples.
+	 * @param datasetIndices
+	 * Indices into `dataset` corresponding to the samples to search.
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @return
+	 * One pair of strings for each of `datasetIndices`, as returned from
+	 * makeSearchLogLine().
+	 *
+	 * @throw
+	 * Error reading templates or exception thrown from implementation.
+	 */
+	std::vector<std::pair<std::string, std::optional<std::string>>>
+	batchSearch(
+	    std::shared_ptr<SearchInterface> impl,
+	    const Data::Dataset &dataset,
+	    const std::vector<uint64_t> &datasetIndices,
+	    const Arguments &args);
+
 	/**
 	 * @brief
 	 * Configure and run database creation.
@@ -109,6 +300,21 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	dispatchCreateTemplates(
 	    const Arguments &args);
 
+	/**
+	 * @brief
+	 * Pack the images of each dataset into an ImagePack alongside the
+	 * dataset's CSV.
+	 *
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @throw
+	 * Numerous propaged reasons, consult message.
+	 */
+	void
+	dispatchPackImages(
+	    const Arguments &args);
+
 	/**
 	 * @brief
 	 * Call the appropriate starting method based on the operation argument
@@ -138,6 +344,68 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	dispatchSearch(
 	    const Arguments &args);
 
+	/**
+	 * @brief
+	 * Execute a single call to searchSubjectBatch.
+	 *
+	 * @param impl
+	 * Initialized SearchInterface implementation.
+	 * @param probes
+	 * Views of the contents of probe templates.
+	 * @param maxCandidates
+	 * Maximum number of candidate list entries to return per probe.
+	 * @param countEvents
+	 * Whether to count hardware events during the call.
+	 *
+	 * @return
+	 * Tuple with call start time, stop time, events counted, and values
+	 * returned from searchSubjectBatch.
+	 *
+	 * @throw
+	 * Rethrown exception from searchSubjectBatch, or number of results
+	 * does not match number of probes.
+	 */
+	std::tuple<std::chrono::steady_clock::time_point,
+	std::chrono::steady_clock::time_point, Util::PerfCounters::Counts,
+	std::vector<std::tuple<ReturnStatus,
+	std::optional<SearchSubjectResult>>>>
+	executeBatchSearchSubject(
+	    std::shared_ptr<SearchInterface> impl,
+	    const std::vector<std::span<const std::byte>> &probes,
+	    const uint16_t maxCandidates,
+	    const bool countEvents);
+
+	/**
+	 * @brief
+	 * Execute a single call to searchSubjectPositionBatch.
+	 *
+	 * @param impl
+	 * Initialized SearchInterface implementation.
+	 * @param probes
+	 * Views of the contents of probe templates.
+	 * @param maxCandidates
+	 * Maximum number of candidate list entries to return per probe.
+	 * @param countEvents
+	 * Whether to count hardware events during the call.
+	 *
+	 * @return
+	 * Tuple with call start time, stop time, events counted, and values
+	 * returned from searchSubjectPositionBatch.
+	 *
+	 * @throw
+	 * Rethrown exception from searchSubjectPositionBatch, or number of
+	 * results does not match number of probes.
+	 */
+	std::tuple<std::chrono::steady_clock::time_point,
+	std::chrono::steady_clock::time_point, Util::PerfCounters::Counts,
+	std::vector<std::tuple<ReturnStatus,
+	std::optional<SearchSubjectPositionResult>>>>
+	executeBatchSearchSubjectPosition(
+	    std::shared_ptr<SearchInterface> impl,
+	    const std::vector<std::span<const std::byte>> &probes,
+	    const uint16_t maxCandidates,
+	    const bool countEvents);
+
 	/**
 	 * @brief
 	 * Execute a single call to searchSubject.
@@ -148,21 +416,35 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	 * Contents of probe template.
 	 * @param maxCandidates
 	 * Maximum number of candidate list entries to return.
+	 * @param timeLimit
+	 * Time after the call starts at which the search should return, if
+	 * any.
+	 * @param minSimilarity
+	 * Similarity at which the search may return early, if any.
+	 * @param countEvents
+	 * Whether to count hardware events during the call.
 	 *
 	 * @return
-	 * Tuple with call start time, stop time and values returned from
-	 * searchSubject.
+	 * Tuple with call start time, stop time, events counted, and values
+	 * returned from searchSubject.
 	 *
 	 * @throw
 	 * Rethrown exception from searchSubject.
+	 *
+	 * @note
+	 * The SearchLimits overload of searchSubject is only called
+	 * when `timeLimit` or `minSimilarity` is set.
 	 */
 	std::tuple<std::chrono::steady_clock::time_point,
-	std::chrono::steady_clock::time_point, ReturnStatus,
-	std::optional<SearchSubjectResult>>
+	std::chrono::steady_clock::time_point, Util::PerfCounters::Counts,
+	ReturnStatus, std::optional<SearchSubjectResult>>
 	executeSingleSearchSubject(
 	    std::shared_ptr<SearchInterface> impl,
-	    const std::vector<std::byte> &probe,
-	    const uint16_t maxCandidates);
+	    std::span<const std::byte> probe,
+	    const uint16_t maxCandidates,
+	    const std::optional<std::chrono::milliseconds> &timeLimit,
+	    const std::optional<double> &minSimilarity,
+	    const bool countEvents);
 
 	/**
 	 * @brief
@@ -174,21 +456,35 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	 * Contents of probe template.
 	 * @param maxCandidates
 	 * Maximum number of candidate list entries to return.
+	 * @param timeLimit
+	 * Time after the call starts at which the search should return, if
+	 * any.
+	 * @param minSimilarity
+	 * Similarity at which the search may return early, if any.
+	 * @param countEvents
+	 * Whether to count hardware events during the call.
 	 *
 	 * @return
-	 * Tuple with call start time, stop time and values returned from
-	 * searchSubjectPosition.
+	 * Tuple with call start time, stop time, events counted, and values
+	 * returned from searchSubjectPosition.
 	 *
 	 * @throw
 	 * Rethrown exception from searchSubjectPosition.
+	 *
+	 * @note
+	 * The SearchLimits overload of searchSubjectPosition is only called
+	 * when `timeLimit` or `minSimilarity` is set.
 	 */
 	std::tuple<std::chrono::steady_clock::time_point,
-	std::chrono::steady_clock::time_point, ReturnStatus,
-	std::optional<SearchSubjectPositionResult>>
+	std::chrono::steady_clock::time_point, Util::PerfCounters::Counts,
+	ReturnStatus, std::optional<SearchSubjectPositionResult>>
 	executeSingleSearchSubjectPosition(
 	    std::shared_ptr<SearchInterface> impl,
-	    const std::vector<std::byte> &probe,
-	    const uint16_t maxCandidates);
+	    std::span<const std::byte> probe,
+	    const uint16_t maxCandidates,
+	    const std::optional<std::chrono::milliseconds> &timeLimit,
+	    const std::optional<double> &minSimilarity,
+	    const bool countEvents);
 
 	/**
 	 * @brief
@@ -210,6 +506,17 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	 * @note
 	 * When `args.numProcs` == 1, no new processes are forked. `fn` will be
 	 * called in the current process.
+	 *
+	 * @note
+	 * Every worker is passed all of `indices`, along with a
+	 * Util::WorkQueue in `args.workQueue` from which to claim chunks of
+	 * them with processClaims().
+	 *
+	 * @note
+	 * When `args.perfCounters` is set and calls overlap (threads,
+	 * prefetching, or searches in flight), hardware events of the whole
+	 * run are logged with writePerfCountersLog() instead of around each
+	 * call.
 	 */
 	void
 	forkOperation(
@@ -277,6 +584,53 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	std::string
 	getSearchInterfaceIdentificationString();
 
+	/**
+	 * @brief
+	 * Obtain the path of the latency histograms of a process.
+	 *
+	 * @param outputDir
+	 * Directory where all output is written.
+	 * @param pid
+	 * Process whose latencies are written.
+	 *
+	 * @return
+	 * Path written by writeLatencyLogs() in process `pid`.
+	 */
+	std::filesystem::path
+	getLatencyHistogramPath(
+	    const std::filesystem::path &outputDir,
+	    const pid_t pid);
+
+	/**
+	 * @brief
+	 * Obtain the hardware event counters of the calling thread.
+	 *
+	 * @return
+	 * Counters opened by the first call on this thread, reopened if the
+	 * process has forked since.
+	 *
+	 * @note
+	 * Counters include threads created after the first call, so callers
+	 * open them before instantiating the implementation.
+	 */
+	Util::PerfCounters&
+	getPerfCounters();
+
+	/**
+	 * @brief
+	 * Obtain the log header columns of hardware event counts.
+	 *
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @return
+	 * Comma and the name of each counted event, or an empty string if
+	 * `args.perfCounters` is not set.
+	 */
+	std::string
+	getPerfCountersHeader(
+	    const Arguments &args);
+
 	/**
 	 * @brief
 	 * Obtain the validation driver's usage string.
@@ -339,9 +693,11 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	 * Line to log immediately to the newly created file.
 	 * @param outputDir
 	 * Output directory passed from command line arguments.
+	 * @param threadNum
+	 * Index of the calling thread, when threads share this process.
 	 *
 	 * @return
-	 * Path to log file to append to for this process.
+	 * Path to log file to append to for this process (and thread).
 	 *
 	 * @throw
 	 * Error creating log file.
@@ -350,7 +706,58 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	makeLog(
 	    const std::string &prefix,
 	    const std::string &header,
-	    const std::filesystem::path &outputDir);
+	    const std::filesystem::path &outputDir,
+	    const std::optional<uint8_t> &threadNum = {});
+
+	/**
+	 * @brief
+	 * Record the result of creating a template for one sample.
+	 *
+	 * @param impl
+	 * Initialized ExtractionInterface implementation.
+	 * @param dataset
+	 * Dataset of samples.
+	 * @param datasetIndex
+	 * Index into `dataset` corresponding to the single sample.
+	 * @param start
+	 * Time the template creation call began.
+	 * @param stop
+	 * Time the template creation call returned.
+	 * @param counts
+	 * Hardware events counted during the template creation call.
+	 * @param numSamples
+	 * Number of Sample sent for this sample.
+	 * @param ret
+	 * Value returned for this sample from the template creation call.
+	 * @param batchSize
+	 * Number of samples processed by the call spanning `start` to `stop`.
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @return
+	 * Pair of strings. First is log string suitable for writing to template
+	 * creation log. Second is log string suitable for writing to the
+	 * template extract data log.
+	 *
+	 * @throw
+	 * Error writing data, or exception thrown from implementation.
+	 *
+	 * @note
+	 * Writes the template (or a zero-byte file on failure) to disk.
+	 */
+	std::pair<std::string, std::optional<std::string>>
+	makeCreateTemplateLogLine(
+	    std::shared_ptr<ExtractionInterface> impl,
+	    const Data::Dataset &dataset,
+	    const uint64_t datasetIndex,
+	    const std::chrono::steady_clock::time_point &start,
+	    const std::chrono::steady_clock::time_point &stop,
+	    const Util::PerfCounters::Counts &counts,
+	    const uint64_t numSamples,
+	    const std::tuple<ReturnStatus,
+	        std::optional<pmr::CreateTemplateResult>> &ret,
+	    const uint64_t batchSize,
+	    const Arguments &args);
 
 	/**
 	 * @brief
@@ -361,6 +768,8 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	 * @param duration
 	 * String representation of the elapsed time calling searchSubject,
 	 * searchSubjectPosition, or extractCorrespondence.
+	 * @param counts
+	 * Hardware events counted during the call timed by `duration`.
 	 * @param searchResult
 	 * The result of calling searchSubject or searchSubjectPosition.
 	 * @param args
@@ -377,10 +786,29 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	makeExtractCorrespondenceLogLine(
 	    const std::string &identifier,
 	    const std::string &duration,
+	    const Util::PerfCounters::Counts &counts,
 	    const std::variant<SearchSubjectResult,
 	        SearchSubjectPositionResult> &searchResult,
 	    const Arguments &args);
 
+	/**
+	 * @brief
+	 * Generate log-able columns of hardware event counts.
+	 *
+	 * @param counts
+	 * Hardware events counted during a call.
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @return
+	 * Comma and each of `counts` (or NA if not counted), matching
+	 * getPerfCountersHeader().
+	 */
+	std::string
+	makePerfCountersColumns(
+	    const Util::PerfCounters::Counts &counts,
+	    const Arguments &args);
+
 	/**
 	 * @brief
 	 * Generate single-file archive of templates with manifest.
@@ -398,6 +826,22 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	    const std::string &datasetName,
 	    const Arguments &args);
 
+	/**
+	 * @brief
+	 * Make an arena for the results of a single template creation.
+	 *
+	 * @return
+	 * Memory resource that releases all of its memory at once when
+	 * destroyed, starting with a buffer reused by every arena made on
+	 * the calling thread.
+	 *
+	 * @note
+	 * Only one arena made by this function may exist on a thread at a
+	 * time.
+	 */
+	std::pmr::monotonic_buffer_resource
+	makeRequestArena();
+
 	/**
 	 * @brief
 	 * Generate log-able string for output of
@@ -410,6 +854,8 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	 * ExtractionInterface::extractTemplateData (or
 	 * ExtractionInterface::createTemplate),
 	 * in microseconds.
+	 * @param counts
+	 * Hardware events counted during the call timed by `duration`.
 	 * @param extractedData
 	 * Data returned from ExtractionInterface::extractTemplateData (or
 	 * ExtractionInterface::createTemplate).
@@ -431,7 +877,9 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	makeExtractTemplateDataLogLine(
 	    const std::string &identifier,
 	    const std::string &duration,
-	    const std::optional<std::vector<TemplateData>> &extractedData,
+	    const Util::PerfCounters::Counts &counts,
+	    const std::optional<std::pmr::vector<pmr::TemplateData>>
+	        &extractedData,
 	    const std::optional<ReturnStatus> &rs,
 	    const Arguments &args);
 
@@ -448,13 +896,98 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	 * Sample versions of `metadatas`.
 	 *
 	 * @note
-	 * Reads image from disk.
+	 * Reads image from `args.imagePack` if set, otherwise from
+	 * `args.prefetcher` if set, otherwise from disk.
 	 */
 	std::vector<Sample>
 	makeSamples(
 	    const std::vector<Data::Input> &metadatas,
 	    const Arguments &args);
 
+	/**
+	 * @brief
+	 * Generate log-able strings for the result of a single probe search.
+	 *
+	 * @param impl
+	 * Initialized SearchInterface implementation.
+	 * @param dataset
+	 * Dataset of samples.
+	 * @param datasetIndex
+	 * Index into `dataset` corresponding to the single sample.
+	 * @param probe
+	 * Contents of the probe template that was searched.
+	 * @param start
+	 * Time the search call began.
+	 * @param stop
+	 * Time the search call returned.
+	 * @param counts
+	 * Hardware events counted during the search call.
+	 * @param rs
+	 * ReturnStatus for this probe from the search call.
+	 * @param result
+	 * Search result for this probe from the search call.
+	 * @param batchSize
+	 * Number of probes searched by the call spanning `start` to `stop`.
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @return
+	 * Pair of strings. First is log string suitable for writing to search
+	 * log. Second is log string suitable for writing to the correspondence
+	 * log.
+	 *
+	 * @throw
+	 * Exception thrown from implementation during correspondence
+	 * extraction.
+	 */
+	std::pair<std::string, std::optional<std::string>>
+	makeSearchLogLine(
+	    std::shared_ptr<SearchInterface> impl,
+	    const Data::Dataset &dataset,
+	    const uint64_t datasetIndex,
+	    std::span<const std::byte> probe,
+	    const std::chrono::steady_clock::time_point &start,
+	    const std::chrono::steady_clock::time_point &stop,
+	    const Util::PerfCounters::Counts &counts,
+	    const ReturnStatus &rs,
+	    const std::variant<std::optional<SearchSubjectResult>,
+	        std::optional<SearchSubjectPositionResult>> &result,
+	    const uint64_t batchSize,
+	    const Arguments &args);
+
+	/**
+	 * @brief
+	 * Change a reference database in place with every incremental
+	 * method of ExtractionInterface.
+	 *
+	 * @param impl
+	 * Initialized ExtractionInterface implementation.
+	 * @param additions
+	 * Templates not yet in the database.
+	 * @param databaseDir
+	 * Directory of the reference database.
+	 * @param databaseName
+	 * Name of the reference database, for logs.
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @throw
+	 * Exception thrown from implementation, failure to write to log, or
+	 * returning failure from any call.
+	 *
+	 * @note
+	 * `additions` are inserted, updated, removed, and inserted again, so
+	 * the database ends up holding them. A SearchInterface loaded before
+	 * the first change is reloaded after each, if it supports reload().
+	 */
+	void
+	modifyDatabase(
+	    std::shared_ptr<ExtractionInterface> impl,
+	    const TemplateArchive &additions,
+	    const std::filesystem::path &databaseDir,
+	    const std::string &databaseName,
+	    const Arguments &args);
+
 	/**
 	 * @brief
 	 * Parse command line arguments.
@@ -475,6 +1008,138 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	    const int argc,
 	    char * const argv[]);
 
+	/**
+	 * @brief
+	 * Obtain the path of a probe template created during template
+	 * creation.
+	 *
+	 * @param datasetName
+	 * Name of the dataset containing the probe.
+	 * @param identifier
+	 * Identifier of the probe.
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @return
+	 * Path to the probe template.
+	 */
+	std::filesystem::path
+	getProbeTemplatePath(
+	    const std::string &datasetName,
+	    const std::string &identifier,
+	    const Arguments &args);
+
+	/**
+	 * @brief
+	 * List the files an operation will read, in the order it reads them.
+	 *
+	 * @param dataset
+	 * Dataset of samples.
+	 * @param indices
+	 * Indices into `dataset` that will be exercised, in order.
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @return
+	 * Images (Operation::CreateTemplates) or probe templates
+	 * (Operation::SearchSubject and Operation::SearchSubjectPosition)
+	 * for `indices`.
+	 *
+	 * @throw
+	 * Unsupported operation.
+	 */
+	std::vector<std::filesystem::path>
+	getPrefetchPaths(
+	    const Data::Dataset &dataset,
+	    const std::vector<uint64_t> &indices,
+	    const Arguments &args);
+
+	/**
+	 * @brief
+	 * Process chunks of indices claimed from a shared work queue.
+	 *
+	 * @param dataset
+	 * Dataset of samples.
+	 * @param indices
+	 * Indices into `dataset` shared by all workers.
+	 * @param args
+	 * Arguments parsed from command line.
+	 * @param fn
+	 * Function to call once with a ClaimFunction returning chunks of
+	 * `indices`, and `args` with a Util::FilePrefetcher for this worker
+	 * if `args.prefetchDepth` is set.
+	 *
+	 * @throw
+	 * Exception thrown from `fn`, or error writing log.
+	 *
+	 * @note
+	 * All of `indices` is one chunk when `args.workQueue` is not set.
+	 * When prefetching, the next chunk is claimed and its files added
+	 * to the prefetcher as each chunk is returned, so reads continue
+	 * across chunks. Utilization of this worker is logged with
+	 * writeUtilizationLog() once `fn` returns.
+	 */
+	void
+	processClaims(
+	    const Data::Dataset &dataset,
+	    const std::vector<uint64_t> &indices,
+	    const Arguments &args,
+	    const std::function<void(const ClaimFunction&,
+	        const Arguments&)> &fn);
+
+	/**
+	 * @brief
+	 * Read a probe template created during template creation.
+	 *
+	 * @param dataset
+	 * Dataset of samples.
+	 * @param datasetIndex
+	 * Index into `dataset` corresponding to the single sample.
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @return
+	 * Contents of the probe template.
+	 *
+	 * @throw
+	 * Error reading probe template.
+	 *
+	 * @note
+	 * Taken from `args.prefetcher` if set, otherwise mapped.
+	 */
+	Util::FileContents
+	readProbeTemplate(
+	    const Data::Dataset &dataset,
+	    const uint64_t datasetIndex,
+	    const Arguments &args);
+
+	/**
+	 * @brief
+	 * Record the latency of one call to an implementation.
+	 *
+	 * @param method
+	 * Name of the method called.
+	 * @param datasetName
+	 * Name of the dataset being processed.
+	 * @param start
+	 * When the call began.
+	 * @param stop
+	 * When the call returned.
+	 * @param args
+	 * Arguments parsed from command line.
+	 *
+	 * @note
+	 * `method` is qualified with the template type or search type, and
+	 * `datasetName` with the database searched, from `args`.
+	 */
+	void
+	recordLatency(
+	    const std::string &method,
+	    const std::string &datasetName,
+	    const std::chrono::steady_clock::time_point &start,
+	    const std::chrono::steady_clock::time_point &stop,
+	    const Arguments &args);
+
 	/**
 	 * @brief
 	 * Create templates for a subset of validation dataset images.
@@ -537,6 +1202,15 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	 * @throw
 	 * Exception thrown from implementation, failure to write to log, or
 	 * returning failure from database creation operation.
+	 *
+	 * @note
+	 * When `args.numShards` is not 1, templates are split with
+	 * splitTemplateArchive() and each shard becomes its own database in a
+	 * subdirectory, searched later with ShardedSearchInterface.
+	 *
+	 * @note
+	 * When `args.incremental` is set, the database is created from the
+	 * first half of the templates and modifyDatabase() adds the rest.
 	 */
 	void
 	singleCreateDatabase(
@@ -583,6 +1257,8 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	 * Dataset of samples.
 	 * @param datasetIndex
 	 * Index into `dataset` corresponding to the single sample.
+	 * @param probe
+	 * Contents of the probe template that was searched.
 	 * @param result
 	 * Result returned from SearchInterface::extractCorrespondence.
 	 * @param args
@@ -599,6 +1275,7 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	    std::shared_ptr<SearchInterface> impl,
 	    const Data::Dataset &dataset,
 	    const uint64_t datasetIndex,
+	    std::span<const std::byte> probe,
 	    const std::variant<SearchSubjectResult, SearchSubjectPositionResult>
 		&result,
 	    const Arguments &args);
@@ -614,7 +1291,8 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	 * @param datasetIndex
 	 * Index into `dataset` corresponding to the single sample.
 	 * @param templateResult
-	 * Result returned from ExtractionInterface::createTemplate.
+	 * Result returned from ExtractionInterface::createTemplate. Extracted
+	 * TemplateData is built within the same memory resource.
 	 * @param args
 	 * Arguments parsed from command line.
 	 *
@@ -631,7 +1309,7 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	    std::shared_ptr<ExtractionInterface> impl,
 	    const Data::Dataset &dataset,
 	    const uint64_t datasetIndex,
-	    const CreateTemplateResult &templateResult,
+	    const pmr::CreateTemplateResult &templateResult,
 	    const Arguments &args);
 
 	/**
@@ -662,6 +1340,75 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	    const uint64_t datasetIndex,
 	    const Arguments &args);
 
+	/**
+	 * @brief
+	 * Begin counting hardware events on the calling thread.
+	 *
+	 * @param enabled
+	 * Whether hardware events are counted (`args.perfCounters`).
+	 *
+	 * @throw
+	 * Error reading counters.
+	 *
+	 * @note
+	 * Call before reading the start time, so that opening and reading
+	 * counters is not included in elapsed times.
+	 */
+	void
+	startPerfCounters(
+	    const bool enabled);
+
+	/**
+	 * @brief
+	 * End counting hardware events on the calling thread.
+	 *
+	 * @param enabled
+	 * Whether hardware events are counted (`args.perfCounters`).
+	 *
+	 * @return
+	 * Events counted since startPerfCounters(), all std::nullopt if not
+	 * `enabled`.
+	 *
+	 * @throw
+	 * Error reading counters.
+	 */
+	Util::PerfCounters::Counts
+	stopPerfCounters(
+	    const bool enabled);
+
+	/**
+	 * @brief
+	 * Spawn threads that perform a FRIF TE E1N search task on a set of
+	 * samples using one shared implementation.
+	 *
+	 * @param impl
+	 * Variant containing initialized SearchInterface implementation.
+	 * @param args
+	 * Arguments parsed from the command line.
+	 * @param dataset
+	 * Dataset of samples.
+	 * @param indices
+	 * Indices into `dataset` that should be exercised.
+	 * @param fn
+	 * Function to call that operations on the `indices` subset of
+	 * `dataset`.
+	 *
+	 * @throw
+	 * Implementation does not support concurrent search, or the first
+	 * exception thrown from `fn` in any thread.
+	 *
+	 * @note
+	 * Threads claim chunks of `indices` from `args.workQueue`.
+	 */
+	void
+	threadOperation(
+	    const InterfaceVariant &impl,
+	    const Arguments &args,
+	    const Data::Dataset &dataset,
+	    const std::vector<uint64_t> &indices,
+	    const std::function<void(InterfaceVariant, const Data::Dataset&,
+		const std::vector<uint64_t>&, const Arguments&)> &fn);
+
 	/**
 	 * @brief
 	 * Wait for forked children to exit.
@@ -672,6 +1419,147 @@ namespace FRIF::Evaluations::Exemplar1N::Validation
 	void
 	waitForExit(
 	    const uint8_t numChildren);
+
+	/**
+	 * @brief
+	 * Log latencies recorded in this process.
+	 *
+	 * @param args
+	 * Arguments parsed from the command line.
+	 * @param forMerge
+	 * Whether this is a child of forkOperation() whose latencies will
+	 * be merged into its parent's.
+	 *
+	 * @throw
+	 * Error writing logs.
+	 *
+	 * @note
+	 * Writes percentiles to `latency-<pid>.log`, or, when `forMerge`
+	 * is set, histograms to getLatencyHistogramPath(). After
+	 * forkOperation(), the latencies of this process include those of
+	 * its children, whose histograms are removed once merged.
+	 */
+	void
+	writeLatencyLogs(
+	    const Arguments &args,
+	    const bool forMerge);
+
+	/**
+	 * @brief
+	 * Log how long it took to instantiate and load SearchInterface, and
+	 * how long until this worker's first search result.
+	 *
+	 * @param args
+	 * Arguments parsed from the command line, with `args.loadStart` and
+	 * `args.loadStop` set.
+	 * @param dataset
+	 * Dataset of samples that was searched.
+	 * @param firstResult
+	 * When the first search result was logged, if any.
+	 *
+	 * @throw
+	 * Error writing log.
+	 *
+	 * @note
+	 * Both elapsed times are measured from `args.loadStart`, so
+	 * `first_result_elapsed` is the time to the first query of a cold
+	 * start. With a memory-mapped database it includes the page faults
+	 * that load() did not take.
+	 */
+	void
+	writeLoadLog(
+	    const Arguments &args,
+	    const Data::Dataset &dataset,
+	    const std::optional<std::chrono::steady_clock::time_point>
+	        &firstResult);
+
+	/**
+	 * @brief
+	 * Log resident memory of this process.
+	 *
+	 * @param args
+	 * Arguments parsed from the command line.
+	 * @param dataset
+	 * Dataset of samples that was processed.
+	 * @param mode
+	 * How work was divided ("single", "fork", or "thread").
+	 * @param numWorkers
+	 * Number of processes or threads performing work.
+	 *
+	 * @throw
+	 * Error writing log.
+	 *
+	 * @note
+	 * Summing `pss_kib` across all logs from a forked run gives the total
+	 * memory of that run. Comparing it to `pss_kib` from a threaded run
+	 * gives the savings of sharing one SearchInterface.
+	 */
+	void
+	writeMemoryLog(
+	    const Arguments &args,
+	    const Data::Dataset &dataset,
+	    const std::string &mode,
+	    const uint8_t numWorkers);
+
+	/**
+	 * @brief
+	 * Log hardware events counted over an entire run.
+	 *
+	 * @param args
+	 * Arguments parsed from the command line.
+	 * @param dataset
+	 * Dataset of samples that was processed.
+	 * @param numItems
+	 * Number of elements of `dataset` processed by all workers.
+	 * @param counts
+	 * Hardware events counted from before the first worker started
+	 * until the last worker finished.
+	 *
+	 * @throw
+	 * Error writing log.
+	 *
+	 * @note
+	 * Counts include every worker process and thread, prefetcher, and
+	 * thread the implementation created, so dividing by `numItems` gives
+	 * the cost of each item at full throughput.
+	 */
+	void
+	writePerfCountersLog(
+	    const Arguments &args,
+	    const Data::Dataset &dataset,
+	    const uint64_t numItems,
+	    const Util::PerfCounters::Counts &counts);
+
+	/**
+	 * @brief
+	 * Log how much of an operation this worker spent working.
+	 *
+	 * @param args
+	 * Arguments parsed from the command line.
+	 * @param dataset
+	 * Dataset of samples that was processed.
+	 * @param numClaims
+	 * Number of chunks claimed by this worker.
+	 * @param numItems
+	 * Number of indices in the chunks claimed by this worker.
+	 * @param busy
+	 * Time spent processing chunks.
+	 *
+	 * @throw
+	 * Error writing log.
+	 *
+	 * @note
+	 * `finish_elapsed` is measured from `args.loadStop`, which is shared
+	 * by all workers of an operation. The spread of `finish_elapsed`
+	 * across workers is the time lost waiting on the slowest.
+	 */
+	void
+	writeUtilizationLog(
+	    const Arguments &args,
+	    const Data::Dataset &dataset,
+	    const uint64_t numClaims,
+	    const uint64_t numItems,
+	    const std::chrono::steady_clock::duration &busy);
 }
 
 #endif /* FRIF_E1N_VALIDATION_H_ */
@@ -15,8 +15,11 @@
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <limits>
 #include <memory>
+#include <new>
 #include <optional>
+#include <span>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -53,6 +56,21 @@ namespace FRIF
 		    noexcept;
 	};
 
+	/** Parallelism of Image::resample(). */
+	struct ResampleOptions
+	{
+		/** Number of threads resampling bands of output rows. */
+		uint8_t numThreads{1};
+		/**
+		 * Number of output rows in each band, or 0 to divide rows
+		 * evenly among #numThreads. Threads take the next band as
+		 * they finish one, so smaller bands balance load better,
+		 * but input rows shared by adjacent bands are filtered
+		 * once per band.
+		 */
+		uint32_t bandHeight{};
+	};
+
 	/** Data and metadata for an image. */
 	struct Image
 	{
@@ -168,6 +186,93 @@ namespace FRIF
 		    const BitsPerPixel bpp,
 		    const std::vector<std::byte> &pixels);
 
+		/**
+		 * @brief
+		 * Image constructor that takes ownership of pixel data.
+		 *
+		 * @param identifier
+		 * An identifier for this image. Used to link Image to
+		 * TemplateData and Correspondence.
+		 * @param width
+		 * Width of the image in pixels.
+		 * @param height
+		 * Height of the image in pixels.
+		 * @param ppi
+		 * Resolution of the image in pixels per inch.
+		 * @param colorspace
+		 * Representation of color in each byte within `pixels`.
+		 * @param bpc
+		 * Number of bits used by each color component.
+		 * @param bpp
+		 * Number of bits comprising a single pixel.
+		 * @param pixels
+		 * Image data, as described for the copying constructor, moved
+		 * into #pixels.
+		 */
+		Image(
+		    const uint8_t identifier,
+		    const uint16_t width,
+		    const uint16_t height,
+		    const uint16_t ppi,
+		    const Colorspace colorspace,
+		    const BitsPerChannel bpc,
+		    const BitsPerPixel bpp,
+		    std::vector<std::byte> &&pixels);
+
+		/**
+		 * @brief
+		 * Image constructor that shares immutable pixel data.
+		 *
+		 * @param identifier
+		 * An identifier for this image. Used to link Image to
+		 * TemplateData and Correspondence.
+		 * @param width
+		 * Width of the image in pixels.
+		 * @param height
+		 * Height of the image in pixels.
+		 * @param ppi
+		 * Resolution of the image in pixels per inch.
+		 * @param colorspace
+		 * Representation of color in each byte within `pixels`.
+		 * @param bpc
+		 * Number of bits used by each color component.
+		 * @param bpp
+		 * Number of bits comprising a single pixel.
+		 * @param pixels
+		 * Image data, as described for the copying constructor,
+		 * which is not copied.
+		 * @param owner
+		 * Object keeping `pixels` valid and unmodified, such as a
+		 * std::vector or a Util::MappedFile. Copies of this Image
+		 * share ownership.
+		 *
+		 * @throw std::invalid_argument
+		 * `owner` is `nullptr`.
+		 */
+		Image(
+		    const uint8_t identifier,
+		    const uint16_t width,
+		    const uint16_t height,
+		    const uint16_t ppi,
+		    const Colorspace colorspace,
+		    const BitsPerChannel bpc,
+		    const BitsPerPixel bpp,
+		    std::span<const std::byte> pixels,
+		    std::shared_ptr<const void> owner);
+
+		/**
+		 * @return
+		 * #sharedPixels if set, otherwise #pixels.
+		 *
+		 * @note
+		 * Prefer this method to reading #pixels directly, which is
+		 * empty when pixel data is shared.
+		 */
+		std::span<const std::byte>
+		getPixels()
+		    const
+		    noexcept;
+
 		/**
 		 * @brief
 		 * Validate that the properties of this Image appear to
@@ -180,6 +285,88 @@ namespace FRIF
 		sanityCheck()
 		    const;
 
+		/**
+		 * @brief
+		 * Convert to another colorspace and/or bit depth.
+		 *
+		 * @details
+		 * Sixteen-bit channels are scaled to eight bits with rounding.
+		 * RGB is converted to grayscale with ITU-R BT.601 luma
+		 * weights. Where the CPU supports them, AVX2 or SSE4.1
+		 * instructions are chosen at runtime, and results are
+		 * identical regardless of the instructions used.
+		 *
+		 * @param colorspace
+		 * Colorspace of the returned Image.
+		 * @param bpc
+		 * Bits per channel of the returned Image.
+		 *
+		 * @return
+		 * Converted copy of this Image, or this Image if it already
+		 * has `colorspace` and `bpc`.
+		 *
+		 * @throw std::logic_error
+		 * This Image fails sanityCheck().
+		 * @throw std::invalid_argument
+		 * Conversion would add color or increase bit depth.
+		 */
+		Image
+		convert(
+		    const Colorspace colorspace,
+		    const BitsPerChannel bpc)
+		    const;
+
+		/**
+		 * @brief
+		 * Invert polarity, such that black becomes white.
+		 *
+		 * @details
+		 * Where the CPU supports them, AVX2 or SSE2 instructions are
+		 * chosen at runtime.
+		 *
+		 * @return
+		 * Copy of this Image with every channel value inverted.
+		 *
+		 * @throw std::logic_error
+		 * This Image fails sanityCheck().
+		 */
+		Image
+		invert()
+		    const;
+
+		/**
+		 * @brief
+		 * Resample to another resolution.
+		 *
+		 * @details
+		 * Pixels are filtered separably with a Lanczos-3 kernel,
+		 * widened when downsampling to avoid aliasing. Where the CPU
+		 * supports them, AVX2 or SSE2 instructions are chosen at
+		 * runtime for the vertical pass. Results are identical
+		 * regardless of the instructions and `options` used.
+		 *
+		 * @param ppi
+		 * Resolution of the returned Image.
+		 * @param options
+		 * Parallelism of resampling.
+		 *
+		 * @return
+		 * Copy of this Image at `ppi`, whose width and height are
+		 * scaled by `ppi` / #ppi and rounded, or this Image if it
+		 * already has `ppi`.
+		 *
+		 * @throw std::logic_error
+		 * This Image fails sanityCheck().
+		 * @throw std::invalid_argument
+		 * `ppi`, #ppi, or `options.numThreads` is 0, or the
+		 * resampled dimensions would not fit in #width and #height.
+		 */
+		Image
+		resample(
+		    const uint16_t ppi,
+		    const ResampleOptions &options = {})
+		    const;
+
 		/**
 		 * An identifier for this image. Used to link Image to EFS,
 		 * TemplateData, and Correspondence.
@@ -217,8 +404,89 @@ namespace FRIF
 		 * method (`pixels.data()`). You may safely `reinterpret_cast`
 		 * this value to `std::vector<uint8_t>` if needed (e.g., to
 		 * obtain a `uint8_t*` from `data()`).
+		 * @note
+		 * Empty if #sharedPixelsOwner is set, as it is for each Image
+		 * the validation driver makes from a file. Read pixel data
+		 * with getPixels(), which works for either storage.
+		 *
+		 * @see getPixels()
 		 */
 		std::vector<std::byte> pixels{};
+
+		/**
+		 * @brief
+		 * Raw pixel data of image, shared with other Image.
+		 *
+		 * @details
+		 * Used instead of #pixels when #sharedPixelsOwner is set,
+		 * so that copying this Image does not copy pixel data.
+		 * Layout is the same as #pixels.
+		 */
+		std::span<const std::byte> sharedPixels{};
+		/** Object keeping #sharedPixels valid, if any. */
+		std::shared_ptr<const void> sharedPixelsOwner{};
+	};
+
+	/**
+	 * @brief
+	 * Allocator returning storage aligned to `Alignment` bytes.
+	 * @details
+	 * Useful for containers that will be read with SIMD instructions.
+	 */
+	template<typename T, std::size_t Alignment>
+	struct AlignedAllocator
+	{
+		static_assert(Alignment >= alignof(T), "Alignment is weaker "
+		    "than that of T");
+
+		using value_type = T;
+
+		template<typename U>
+		struct rebind
+		{
+			using other = AlignedAllocator<U, Alignment>;
+		};
+
+		AlignedAllocator() = default;
+
+		template<typename U>
+		AlignedAllocator(
+		    const AlignedAllocator<U, Alignment>&)
+		    noexcept
+		{
+
+		}
+
+		T*
+		allocate(
+		    const std::size_t n)
+		{
+			if (n > std::numeric_limits<std::size_t>::max() /
+			    sizeof(T))
+				throw std::bad_array_new_length{};
+			return (static_cast<T*>(::operator new(n * sizeof(T),
+			    std::align_val_t{Alignment})));
+		}
+
+		void
+		deallocate(
+		    T *p,
+		    const std::size_t n)
+		    noexcept
+		{
+			::operator delete(p, n * sizeof(T),
+			    std::align_val_t{Alignment});
+		}
+
+		template<typename U>
+		bool
+		operator==(
+		    const AlignedAllocator<U, Alignment>&)
+		    const
+		    noexcept
+		{
+			return (true);
+		}
 	};
 
 	/** Pixel location in an image. */
@@ -297,9 +565,9 @@ namespace FRIF
 	extern uint16_t API_PATCH_VERSION;
 	#else /* NIST_EXTERN_FRIFTE_API_VERSION */
 	/** API major version number. */
-	uint16_t API_MAJOR_VERSION{1};
+	uint16_t API_MAJOR_VERSION{2};
 	/** API minor version number. */
-	uint16_t API_MINOR_VERSION{2};
+	uint16_t API_MINOR_VERSION{0};
 	/** API patch version number. */
 	uint16_t API_PATCH_VERSION{0};
 	#endif /* NIST_EXTERN_FRIFTE_API_VERSION */
@@ -54,8 +54,10 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <set>
+#include <span>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -91,6 +93,13 @@ namespace FRIF::Evaluations::Exemplar1N
 			 */
 			bool supportsReferenceTemplateIntrospection{};
 
+			/**
+			 * Are insertIntoReferenceDatabase(),
+			 * removeFromReferenceDatabase(), and
+			 * updateReferenceDatabase() implemented?
+			 */
+			bool supportsIncrementalReferenceDatabase{};
+
 			/**
 			 * LibraryIdentifier::versionNumber of
 			 * previously-submitted software that generates probe
@@ -201,6 +210,90 @@ namespace FRIF::Evaluations::Exemplar1N
 		    const std::vector<Sample> &samples)
 		    const = 0;
 
+		/**
+		 * @brief
+		 * Extract features from one or more images and encode them
+		 * into a template, obtaining all memory for the result from
+		 * `resource`.
+		 *
+		 * @param templateType
+		 * Where this template will be used in the future.
+		 * @param identifier
+		 * Unique identifier used to identify the returned template
+		 * in future search operations (e.g., Candidate#identifier).
+		 * @param samples
+		 * One or more biometric samples to be considered and encoded
+		 * into a template.
+		 * @param resource
+		 * Per-request arena from which the returned
+		 * pmr::CreateTemplateResult shall obtain memory. The caller
+		 * releases all memory from `resource` at once, after it is
+		 * done with the returned value.
+		 *
+		 * @return
+		 * Same meaning as the value returned from createTemplate().
+		 *
+		 * @note
+		 * Implementations may override this method to build the
+		 * template directly within `resource`. The default
+		 * implementation calls createTemplate() and copies the
+		 * result into `resource`.
+		 *
+		 * @note
+		 * Timing requirements and restrictions are the same as for
+		 * createTemplate().
+		 */
+		virtual
+		std::tuple<ReturnStatus,
+		    std::optional<pmr::CreateTemplateResult>>
+		createTemplate(
+		    const TemplateType templateType,
+		    const std::string &identifier,
+		    const std::vector<Sample> &samples,
+		    std::pmr::memory_resource *resource)
+		    const;
+
+		/**
+		 * @brief
+		 * Extract features from the images of several subjects and
+		 * encode each subject's features into a template.
+		 *
+		 * @param templateType
+		 * Where these templates will be used in the future.
+		 * @param jobs
+		 * One or more pairs of an identifier and the samples for that
+		 * identifier, each with the same meaning as the `identifier`
+		 * and `samples` parameters of createTemplate().
+		 *
+		 * @return
+		 * One tuple for each element of `jobs`, in the same order, each
+		 * with the same meaning as the value returned from
+		 * createTemplate().
+		 *
+		 * @note
+		 * Implementations may override this method to amortize setup
+		 * costs (e.g., model initialization or scratch buffers) across
+		 * all elements of `jobs`. The default implementation calls
+		 * createTemplate() once for each element of `jobs`.
+		 *
+		 * @note
+		 * This method must return in the sum of the time allowed for
+		 * createTemplate() to process each element of `jobs`.
+		 *
+		 * @note
+		 * This method shall not spawn threads.
+		 *
+		 * @see createTemplate
+		 */
+		virtual
+		std::vector<std::tuple<ReturnStatus,
+		    std::optional<CreateTemplateResult>>>
+		createTemplateBatch(
+		    const TemplateType templateType,
+		    const std::vector<std::tuple<std::string,
+		        std::vector<Sample>>> &jobs)
+		    const;
+
 		/**
 		 * @brief
 		 * Extract information contained within a template.
@@ -254,6 +347,44 @@ namespace FRIF::Evaluations::Exemplar1N
 		    const CreateTemplateResult &templateResult)
 		    const = 0;
 
+		/**
+		 * @brief
+		 * Extract information contained within a template, obtaining
+		 * all memory for the result from `resource`.
+		 *
+		 * @param templateType
+		 * templateType passed to createTemplate().
+		 * @param templateResult
+		 * Object returned from createTemplate().
+		 * @param resource
+		 * Per-request arena from which the returned TemplateData
+		 * shall obtain memory. The caller releases all memory from
+		 * `resource` at once, after it is done with the returned
+		 * value.
+		 *
+		 * @return
+		 * Same meaning as the value returned from
+		 * extractTemplateData().
+		 *
+		 * @note
+		 * Implementations may override this method to build
+		 * TemplateData directly within `resource`. The default
+		 * implementation calls extractTemplateData() and copies the
+		 * result into `resource`.
+		 *
+		 * @note
+		 * Timing requirements and restrictions are the same as for
+		 * extractTemplateData().
+		 */
+		virtual
+		std::optional<std::tuple<ReturnStatus,
+		    std::pmr::vector<pmr::TemplateData>>>
+		extractTemplateData(
+		    const TemplateType templateType,
+		    const pmr::CreateTemplateResult &templateResult,
+		    std::pmr::memory_resource *resource)
+		    const;
+
 		/**
 		 * @brief
 		 * Create a reference database on the file system.
@@ -308,6 +439,134 @@ namespace FRIF::Evaluations::Exemplar1N
 		    const uint64_t maxSize)
 		    const = 0;
 
+		/**
+		 * @brief
+		 * Add templates to an existing reference database.
+		 *
+		 * @param referenceTemplates
+		 * One or more templates returned from createTemplate() with a
+		 * `templateType` of TemplateType::Reference, none of whose
+		 * identifiers are already present in the reference database.
+		 * @param databaseDirectory
+		 * Entry to a read/write directory previously populated by
+		 * createReferenceDatabase().
+		 * @param maxSize
+		 * The maximum number of bytes of storage available to write,
+		 * inclusive of the existing reference database.
+		 *
+		 * @return
+		 * Information about the result of executing the method.
+		 *
+		 * @attention
+		 * The same requirements as createReferenceDatabase() apply.
+		 * In particular, the files pointed to by `referenceTemplates`
+		 * **will not exist** when SearchInterface is instantiated.
+		 *
+		 * @note
+		 * On ReturnStatus::Result::Failure, the reference database
+		 * must remain as it was before this method was called.
+		 *
+		 * @note
+		 * This method will only be called when
+		 * Compatibility::supportsIncrementalReferenceDatabase is
+		 * `true`. The default implementation returns
+		 * ReturnStatus::Result::Failure.
+		 *
+		 * @note
+		 * This method must return in <= 5 milliseconds *
+		 * the number of lines in TemplateArchive#manifest.
+		 */
+		virtual
+		ReturnStatus
+		insertIntoReferenceDatabase(
+		    const TemplateArchive &referenceTemplates,
+		    const std::filesystem::path &databaseDirectory,
+		    const uint64_t maxSize)
+		    const;
+
+		/**
+		 * @brief
+		 * Remove templates from an existing reference database.
+		 *
+		 * @param identifiers
+		 * Identifiers of templates previously added to the reference
+		 * database.
+		 * @param databaseDirectory
+		 * Entry to a read/write directory previously populated by
+		 * createReferenceDatabase().
+		 *
+		 * @return
+		 * Information about the result of executing the method.
+		 *
+		 * @note
+		 * After this method returns successfully, no search of the
+		 * reference database may return a candidate with an
+		 * identifier in `identifiers`.
+		 *
+		 * @note
+		 * On ReturnStatus::Result::Failure, the reference database
+		 * must remain as it was before this method was called.
+		 *
+		 * @note
+		 * This method will only be called when
+		 * Compatibility::supportsIncrementalReferenceDatabase is
+		 * `true`. The default implementation returns
+		 * ReturnStatus::Result::Failure.
+		 *
+		 * @note
+		 * This method must return in <= 5 milliseconds *
+		 * the number of elements in `identifiers`.
+		 */
+		virtual
+		ReturnStatus
+		removeFromReferenceDatabase(
+		    const std::vector<std::string> &identifiers,
+		    const std::filesystem::path &databaseDirectory)
+		    const;
+
+		/**
+		 * @brief
+		 * Replace templates in an existing reference database.
+		 *
+		 * @param referenceTemplates
+		 * One or more templates returned from createTemplate() with a
+		 * `templateType` of TemplateType::Reference, all of whose
+		 * identifiers are already present in the reference database.
+		 * @param databaseDirectory
+		 * Entry to a read/write directory previously populated by
+		 * createReferenceDatabase().
+		 * @param maxSize
+		 * The maximum number of bytes of storage available to write,
+		 * inclusive of the existing reference database.
+		 *
+		 * @return
+		 * Information about the result of executing the method.
+		 *
+		 * @note
+		 * Semantically equivalent to calling
+		 * removeFromReferenceDatabase() followed by
+		 * insertIntoReferenceDatabase(), but must not leave the
+		 * reference database without the identifiers in
+		 * `referenceTemplates` on ReturnStatus::Result::Failure.
+		 *
+		 * @note
+		 * This method will only be called when
+		 * Compatibility::supportsIncrementalReferenceDatabase is
+		 * `true`. The default implementation returns
+		 * ReturnStatus::Result::Failure.
+		 *
+		 * @note
+		 * This method must return in <= 5 milliseconds *
+		 * the number of lines in TemplateArchive#manifest.
+		 */
+		virtual
+		ReturnStatus
+		updateReferenceDatabase(
+		    const TemplateArchive &referenceTemplates,
+		    const std::filesystem::path &databaseDirectory,
+		    const uint64_t maxSize)
+		    const;
+
 		/**************************************************************/
 
 		/**
@@ -408,6 +667,39 @@ namespace FRIF::Evaluations::Exemplar1N
 			 */
 			bool supportsCorrespondence{};
 
+			/**
+			 * May const search methods be called concurrently on
+			 * one instance?
+			 *
+			 * @details
+			 * When `true`, after load() returns, the test
+			 * application may call searchSubject(),
+			 * searchSubjectPosition(), searchSubjectBatch(),
+			 * searchSubjectPositionBatch(),
+			 * extractCorrespondenceSubject(), and
+			 * extractCorrespondenceSubjectPosition() (including
+			 * their std::span overloads) from multiple threads at
+			 * the same time on the same instance, instead of
+			 * `fork()`ing. Any state these methods modify (e.g.,
+			 * caches or scratch buffers) must then be synchronized
+			 * or thread-local.
+			 *
+			 * @note
+			 * Non-const methods, including the asynchronous
+			 * submit and complete methods, will never be called
+			 * concurrently.
+			 */
+			bool supportsConcurrentSearch{};
+
+			/** Is reload() implemented? */
+			bool supportsReload{};
+
+			/**
+			 * Do searches honor SearchLimits, returning early
+			 * with partial results?
+			 */
+			bool supportsSearchLimits{};
+
 			/**
 			 * LibraryIdentifier::versionNumber of
 			 * previously-submitted software that generates probe
@@ -463,13 +755,18 @@ namespace FRIF::Evaluations::Exemplar1N
 		 * test application may `fork()`, allowing calls to
 		 * searchSubjectPosition() and searchSubject() to
 		 * share the contents of memory using copy-on-write semantics.
+		 * If Compatibility::supportsConcurrentSearch is `true`, the
+		 * test application may instead call those methods from
+		 * multiple threads sharing this instance.
 		 *
 		 * @warning
 		 * **DO NOT MODIFY** the contents of the database on disk at any
 		 * time! The `databaseDirectory` provided to
 		 * getImplementation() may be stored on a read-only file system
 		 * and may be destroyed and restored before calls to
-		 * searchSubjectPosition() and searchSubject().
+		 * searchSubjectPosition() and searchSubject(). Changes are
+		 * only made through ExtractionInterface, and are picked up with
+		 * reload().
 		 *
 		 * @note
 		 * `maxSize` will not be the full amount of memory available on
@@ -503,6 +800,53 @@ namespace FRIF::Evaluations::Exemplar1N
 		load(
 		    const uint64_t maxSize) = 0;
 
+		/**
+		 * @brief
+		 * Bring the loaded reference database up to date with changes
+		 * made on disk since load() or the last reload().
+		 *
+		 * @param maxSize
+		 * Suggested maximum number of bytes of memory to consume in
+		 * support of searching the reference database faster.
+		 *
+		 * @return
+		 * Information about the result of executing the method.
+		 *
+		 * @details
+		 * The reference database on disk may have been changed with
+		 * ExtractionInterface::insertIntoReferenceDatabase(),
+		 * ExtractionInterface::removeFromReferenceDatabase(), and
+		 * ExtractionInterface::updateReferenceDatabase().
+		 * Implementations should apply only those changes instead of
+		 * discarding and reading the entire reference database again.
+		 *
+		 * @note
+		 * This method will only be called after load(), when no
+		 * searches are in progress, and before the test application
+		 * `fork()`s or starts threads to search. The restrictions in
+		 * load() about modifying memory apply once this method returns.
+		 *
+		 * @note
+		 * On ReturnStatus::Result::Failure, searches must continue to
+		 * behave as they did before this method was called.
+		 *
+		 * @note
+		 * This method will only be called when
+		 * Compatibility::supportsReload is `true`. The default
+		 * implementation returns ReturnStatus::Result::Failure.
+		 *
+		 * @note
+		 * This method **may** use more than one thread.
+		 *
+		 * @note
+		 * This method shall return in <= 1 millisecond * the number of
+		 * identifiers changed since load() or the last reload().
+		 */
+		virtual
+		ReturnStatus
+		reload(
+		    const uint64_t maxSize);
+
 		/**************************************************************/
 
 		/**
@@ -543,7 +887,8 @@ namespace FRIF::Evaluations::Exemplar1N
 		 * @note
 		 * SearchSubjectPositionResult::candidateList will be sorted by
 		 * descending SubjectPositionCandidate::similarity upon return
-		 * from this method using `std::stable_sort()`.
+		 * from this method using RankedSubjectPositionCandidateList,
+		 * which may also be used to build the candidate list.
 		 *
 		 * @note
 		 * If provided a probe template that contains images from
@@ -611,7 +956,8 @@ namespace FRIF::Evaluations::Exemplar1N
 		 * @note
 		 * SearchSubjectResult.candidateList will be sorted by
 		 * descending SubjectCandidate.similarity upon return from this
-		 * method using `std::stable_sort()`.
+		 * method using RankedSubjectCandidateList, which may also be
+		 * used to build the candidate list.
 		 *
 		 * @note
 		 * This method must return in <= 40 * `number of database
@@ -630,6 +976,101 @@ namespace FRIF::Evaluations::Exemplar1N
 		    const uint16_t maxCandidates)
 		    const = 0;
 
+		/**
+		 * @brief
+		 * Search the reference database for each of several probe
+		 * templates, including the most localized friction ridge
+		 * region.
+		 *
+		 * @param probeTemplates
+		 * Views of objects returned from createTemplate() with
+		 * `templateType` of TemplateType::Probe.
+		 * @param maxCandidates
+		 * The maximum number of SubjectPositionCandidate to return for
+		 * each element of `probeTemplates`.
+		 *
+		 * @return
+		 * One tuple for each element of `probeTemplates`, in the same
+		 * order, each with the same meaning as the value returned from
+		 * searchSubjectPosition().
+		 *
+		 * @warning
+		 * The same restrictions on modifying the database that apply
+		 * to searchSubjectPosition() apply to this method.
+		 *
+		 * @note
+		 * Implementations may override this method to share a single
+		 * pass through the reference database among all elements of
+		 * `probeTemplates`. The default implementation calls the
+		 * std::span overload of searchSubjectPosition() once for each
+		 * element of `probeTemplates`.
+		 *
+		 * @note
+		 * This method must return in <= 40 * `number of database
+		 * identifiers` * `probeTemplates.size()` microseconds, on
+		 * average, as measured on a fixed subset of data.
+		 *
+		 * @note
+		 * This method shall not spawn threads.
+		 *
+		 * @see searchSubjectPosition
+		 */
+		virtual
+		std::vector<std::tuple<ReturnStatus,
+		    std::optional<SearchSubjectPositionResult>>>
+		searchSubjectPositionBatch(
+		    const std::vector<std::span<const std::byte>>
+		        &probeTemplates,
+		    const uint16_t maxCandidates)
+		    const;
+
+		/**
+		 * @brief
+		 * Search the reference database for each of several probe
+		 * templates, without respect to friction ridge region.
+		 *
+		 * @param probeTemplates
+		 * Views of objects returned from createTemplate() with
+		 * `templateType` of TemplateType::Probe.
+		 * @param maxCandidates
+		 * The maximum number of SubjectCandidate to return for each
+		 * element of `probeTemplates`.
+		 *
+		 * @return
+		 * One tuple for each element of `probeTemplates`, in the same
+		 * order, each with the same meaning as the value returned from
+		 * searchSubject().
+		 *
+		 * @warning
+		 * The same restrictions on modifying the database that apply
+		 * to searchSubject() apply to this method.
+		 *
+		 * @note
+		 * Implementations may override this method to share a single
+		 * pass through the reference database among all elements of
+		 * `probeTemplates`. The default implementation calls the
+		 * std::span overload of searchSubject() once for each element
+		 * of `probeTemplates`.
+		 *
+		 * @note
+		 * This method must return in <= 40 * `number of database
+		 * identifiers` * `probeTemplates.size()` microseconds, on
+		 * average, as measured on a fixed subset of data.
+		 *
+		 * @note
+		 * This method shall not spawn threads.
+		 *
+		 * @see searchSubject
+		 */
+		virtual
+		std::vector<std::tuple<ReturnStatus,
+		    std::optional<SearchSubjectResult>>>
+		searchSubjectBatch(
+		    const std::vector<std::span<const std::byte>>
+		        &probeTemplates,
+		    const uint16_t maxCandidates)
+		    const;
+
 		/**
 		 * @brief
 		 * Extract pairs of corresponding Minutia between
@@ -737,6 +1178,281 @@ namespace FRIF::Evaluations::Exemplar1N
 		    const SearchSubjectResult &searchResult)
 		    const = 0;
 
+		/**
+		 * @brief
+		 * Search the reference database for a probe template stored in
+		 * memory not owned by the caller's std::vector.
+		 *
+		 * @param probeTemplate
+		 * View of an object returned from createTemplate() with
+		 * `templateType` of TemplateType::Probe.
+		 * @param maxCandidates
+		 * The maximum number of SubjectPositionCandidate to return.
+		 *
+		 * @return
+		 * Same as searchSubjectPosition().
+		 *
+		 * @note
+		 * `probeTemplate` is only valid for the duration of this call,
+		 * and may reference read-only memory (e.g., a memory-mapped
+		 * file). Copy any bytes that must persist.
+		 *
+		 * @note
+		 * Implementations may override this method to search without
+		 * copying `probeTemplate`. The default implementation copies
+		 * `probeTemplate` into a std::vector and calls
+		 * searchSubjectPosition().
+		 *
+		 * @note
+		 * All requirements of searchSubjectPosition() apply.
+		 */
+		virtual
+		std::tuple<ReturnStatus,
+		    std::optional<SearchSubjectPositionResult>>
+		searchSubjectPosition(
+		    std::span<const std::byte> probeTemplate,
+		    const uint16_t maxCandidates)
+		    const;
+
+		/**
+		 * @brief
+		 * Search the reference database for a probe template stored in
+		 * memory not owned by the caller's std::vector.
+		 *
+		 * @param probeTemplate
+		 * View of an object returned from createTemplate() with
+		 * `templateType` of TemplateType::Probe.
+		 * @param maxCandidates
+		 * The maximum number of SubjectCandidate to return.
+		 *
+		 * @return
+		 * Same as searchSubject().
+		 *
+		 * @note
+		 * The same notes about `probeTemplate` that apply to the
+		 * std::span overload of searchSubjectPosition() apply here.
+		 * The default implementation calls searchSubject().
+		 */
+		virtual
+		std::tuple<ReturnStatus, std::optional<SearchSubjectResult>>
+		searchSubject(
+		    std::span<const std::byte> probeTemplate,
+		    const uint16_t maxCandidates)
+		    const;
+
+		/**
+		 * @brief
+		 * Search the reference database, stopping early if a limit is
+		 * reached.
+		 *
+		 * @param probeTemplate
+		 * View of an object returned from createTemplate() with
+		 * `templateType` of TemplateType::Probe.
+		 * @param maxCandidates
+		 * The maximum number of SubjectPositionCandidate to return.
+		 * @param limits
+		 * Limits on the work performed by this search.
+		 *
+		 * @return
+		 * Same as searchSubjectPosition(), with
+		 * SearchSubjectPositionResult#termination set to the limit
+		 * that was reached, if any.
+		 *
+		 * @note
+		 * Limits are requests, not guarantees. Return as soon as
+		 * practical after SearchLimits#deadline, with the best
+		 * candidates found so far. The test application measures the
+		 * time until this method returns regardless.
+		 *
+		 * @note
+		 * The same notes about `probeTemplate` that apply to the
+		 * std::span overload of searchSubjectPosition() apply here.
+		 * The default implementation ignores `limits` and calls the
+		 * std::span overload of searchSubjectPosition().
+		 */
+		virtual
+		std::tuple<ReturnStatus,
+		    std::optional<SearchSubjectPositionResult>>
+		searchSubjectPosition(
+		    std::span<const std::byte> probeTemplate,
+		    const uint16_t maxCandidates,
+		    const SearchLimits &limits)
+		    const;
+
+		/**
+		 * @brief
+		 * Search the reference database, stopping early if a limit is
+		 * reached.
+		 *
+		 * @param probeTemplate
+		 * View of an object returned from createTemplate() with
+		 * `templateType` of TemplateType::Probe.
+		 * @param maxCandidates
+		 * The maximum number of SubjectCandidate to return.
+		 * @param limits
+		 * Limits on the work performed by this search.
+		 *
+		 * @return
+		 * Same as searchSubject(), with
+		 * SearchSubjectResult#termination set to the limit that was
+		 * reached, if any.
+		 *
+		 * @note
+		 * The same notes that apply to the SearchLimits overload of
+		 * searchSubjectPosition() apply here. The default
+		 * implementation ignores `limits` and calls the std::span
+		 * overload of searchSubject().
+		 */
+		virtual
+		std::tuple<ReturnStatus, std::optional<SearchSubjectResult>>
+		searchSubject(
+		    std::span<const std::byte> probeTemplate,
+		    const uint16_t maxCandidates,
+		    const SearchLimits &limits)
+		    const;
+
+		/**
+		 * @brief
+		 * Extract pairs of corresponding Minutia for a probe template
+		 * stored in memory not owned by the caller's std::vector.
+		 *
+		 * @param probeTemplate
+		 * View of the probe template sent to searchSubjectPosition().
+		 * @param searchResult
+		 * Object returned from searchSubjectPosition().
+		 *
+		 * @return
+		 * Same as extractCorrespondenceSubjectPosition().
+		 *
+		 * @note
+		 * The same notes about `probeTemplate` that apply to the
+		 * std::span overload of searchSubjectPosition() apply here.
+		 * The default implementation calls
+		 * extractCorrespondenceSubjectPosition().
+		 */
+		virtual
+		std::optional<SubjectPositionCandidateListCorrespondence>
+		extractCorrespondenceSubjectPosition(
+		    std::span<const std::byte> probeTemplate,
+		    const SearchSubjectPositionResult &searchResult)
+		    const;
+
+		/**
+		 * @brief
+		 * Extract pairs of corresponding Minutia for a probe template
+		 * stored in memory not owned by the caller's std::vector.
+		 *
+		 * @param probeTemplate
+		 * View of the probe template sent to searchSubject().
+		 * @param searchResult
+		 * Object returned from searchSubject().
+		 *
+		 * @return
+		 * Same as extractCorrespondenceSubject().
+		 *
+		 * @note
+		 * The same notes about `probeTemplate` that apply to the
+		 * std::span overload of searchSubjectPosition() apply here.
+		 * The default implementation calls
+		 * extractCorrespondenceSubject().
+		 */
+		virtual
+		std::optional<SubjectCandidateListCorrespondence>
+		extractCorrespondenceSubject(
+		    std::span<const std::byte> probeTemplate,
+		    const SearchSubjectResult &searchResult)
+		    const;
+
+		/**
+		 * @brief
+		 * Submit a probe template for a search that returns subject
+		 * identifiers and positions, without waiting for the search
+		 * to complete.
+		 *
+		 * @param probeTemplate
+		 * View of an object returned from createTemplate() with
+		 * `templateType` of TemplateType::Probe.
+		 * @param maxCandidates
+		 * The maximum number of SubjectPositionCandidate to return.
+		 *
+		 * @return
+		 * Ticket that will identify the SearchCompletion for this
+		 * search when returned from completeSearches(). Tickets shall
+		 * be unique among searches that have not yet been returned from
+		 * completeSearches().
+		 *
+		 * @note
+		 * `probeTemplate` remains valid until the SearchCompletion for
+		 * the returned ticket has been returned from
+		 * completeSearches().
+		 *
+		 * @note
+		 * Implementations may override this method and
+		 * completeSearches() to overlap searches with the caller's
+		 * work. The default implementation calls the std::span overload
+		 * of searchSubjectPosition() before returning and queues the
+		 * result for completeSearches().
+		 *
+		 * @note
+		 * All requirements of searchSubjectPosition() apply to the
+		 * time between submission and completion.
+		 */
+		virtual
+		SearchTicket
+		submitSearchSubjectPosition(
+		    std::span<const std::byte> probeTemplate,
+		    const uint16_t maxCandidates);
+
+		/**
+		 * @brief
+		 * Submit a probe template for a search that returns subject
+		 * identifiers, without waiting for the search to complete.
+		 *
+		 * @param probeTemplate
+		 * View of an object returned from createTemplate() with
+		 * `templateType` of TemplateType::Probe.
+		 * @param maxCandidates
+		 * The maximum number of SubjectCandidate to return.
+		 *
+		 * @return
+		 * Ticket that will identify the SearchCompletion for this
+		 * search when returned from completeSearches().
+		 *
+		 * @note
+		 * The same notes that apply to submitSearchSubjectPosition()
+		 * apply here. The default implementation calls the std::span
+		 * overload of searchSubject().
+		 */
+		virtual
+		SearchTicket
+		submitSearchSubject(
+		    std::span<const std::byte> probeTemplate,
+		    const uint16_t maxCandidates);
+
+		/**
+		 * @brief
+		 * Obtain the results of searches previously submitted with
+		 * submitSearchSubject() or submitSearchSubjectPosition().
+		 *
+		 * @param wait
+		 * When `true` and no submitted search has completed, block
+		 * until at least one submitted search has completed. Has no
+		 * effect when no searches are outstanding.
+		 *
+		 * @return
+		 * Zero or more SearchCompletion, in any order. Each submitted
+		 * search shall be returned exactly once.
+		 *
+		 * @note
+		 * The default implementation returns all results queued by
+		 * the default implementations of submitSearchSubject() and
+		 * submitSearchSubjectPosition().
+		 */
+		virtual
+		std::vector<SearchCompletion>
+		completeSearches(
+		    const bool wait);
+
 		/**************************************************************/
 
 		/**
@@ -849,9 +1565,9 @@ namespace FRIF::Evaluations::Exemplar1N
 	extern uint16_t API_PATCH_VERSION;
 	#else /* NIST_EXTERN_FRIFTE_E1N_API_VERSION */
 	/** API major version number. */
-	uint16_t API_MAJOR_VERSION{1};
+	uint16_t API_MAJOR_VERSION{2};
 	/** API minor version number. */
-	uint16_t API_MINOR_VERSION{2};
+	uint16_t API_MINOR_VERSION{0};
 	/** API patch version number. */
 	uint16_t API_PATCH_VERSION{0};
 	#endif /* NIST_EXTERN_FRIFTE_E1N_API_VERSION */
@@ -11,6 +11,8 @@
 #ifndef FRIF_EFS_H_
 #define FRIF_EFS_H_
 
+#include <memory_resource>
+#include <span>
 #include <unordered_map>
 #include <variant>
 
@@ -570,6 +572,111 @@ namespace FRIF::EFS
 		    const std::optional<uint8_t> thetaUncertainty = {});
 	};
 
+	/**
+	 * @brief
+	 * Collection of Minutia stored as one array per member.
+	 * @details
+	 * Minutia `i` is made of element `i` of each array. Arrays are
+	 * aligned to #Alignment bytes so that distances and angles between
+	 * many minutiae may be computed with SIMD instructions. Converting
+	 * to and from std::vector<Minutia> is lossless.
+	 */
+	struct MinutiaArrays
+	{
+		/** Alignment of each array's first element, in bytes. */
+		static constexpr std::size_t Alignment{64};
+		/** Type of each array. */
+		template<typename T>
+		using Array = std::vector<T, AlignedAllocator<T, Alignment>>;
+
+		/** Minutia::coordinate X coordinates. */
+		Array<uint32_t> x{};
+		/** Minutia::coordinate Y coordinates. */
+		Array<uint32_t> y{};
+		/** Minutia::theta values. */
+		Array<uint16_t> theta{};
+		/** Minutia::type values. */
+		Array<MinutiaType> type{};
+
+		/**
+		 * Minutia::coordinateUncertainty values, where set in
+		 * #coordinateUncertaintyMask, and 0 otherwise.
+		 */
+		Array<uint16_t> coordinateUncertainty{};
+		/**
+		 * Minutia::thetaUncertainty values, where set in
+		 * #thetaUncertaintyMask, and 0 otherwise.
+		 */
+		Array<uint8_t> thetaUncertainty{};
+		/**
+		 * Bit `i % 64` of element `i / 64` is set if minutia `i` has
+		 * a Minutia::coordinateUncertainty.
+		 */
+		std::vector<uint64_t> coordinateUncertaintyMask{};
+		/**
+		 * Bit `i % 64` of element `i / 64` is set if minutia `i` has
+		 * a Minutia::thetaUncertainty.
+		 */
+		std::vector<uint64_t> thetaUncertaintyMask{};
+
+		MinutiaArrays();
+
+		/**
+		 * @brief
+		 * MinutiaArrays constructor.
+		 *
+		 * @param minutiae
+		 * Minutiae to store.
+		 */
+		MinutiaArrays(
+		    const std::vector<Minutia> &minutiae);
+
+		/**
+		 * @brief
+		 * Append a minutia.
+		 *
+		 * @param minutia
+		 * Minutia to append.
+		 */
+		void
+		push_back(
+		    const Minutia &minutia);
+
+		/**
+		 * @brief
+		 * Obtain one minutia.
+		 *
+		 * @param i
+		 * Index of the minutia.
+		 *
+		 * @return
+		 * Minutia `i`.
+		 *
+		 * @throw std::out_of_range
+		 * `i` is not less than size().
+		 */
+		Minutia
+		at(
+		    const std::size_t i)
+		    const;
+
+		/** @return Number of minutiae. */
+		std::size_t
+		size()
+		    const;
+
+		/**
+		 * @brief
+		 * Convert to the array of structures used in Features.
+		 *
+		 * @return
+		 * Every minutia, in order.
+		 */
+		std::vector<Minutia>
+		toMinutiae()
+		    const;
+	};
+
 	/** Singular point of focus of innermost recurving ridge. */
 	struct Core
 	{
@@ -1403,6 +1510,502 @@ namespace FRIF::EFS
 		 */
 		std::optional<bool> complex{};
 	};
+
+	/**
+	 * @brief
+	 * Allocator-aware versions of Features and its members.
+	 *
+	 * @details
+	 * Every container in these types, including the node-based
+	 * QualityMeasureMap and all nested containers, obtains memory from
+	 * one std::pmr::memory_resource. Building Features for a request
+	 * in a std::pmr::monotonic_buffer_resource allows the entire graph
+	 * to be released at once instead of one object at a time.
+	 *
+	 * @note
+	 * std::optional is not allocator-aware. When populating an optional
+	 * member, construct the contained value with get_allocator() (e.g.,
+	 * `f.minutiae.emplace(f.get_allocator())`), or it will use the
+	 * default memory resource.
+	 * @note
+	 * The segments of each Crease and the strings within QualityMeasure
+	 * are not allocator-aware and always use the global heap.
+	 */
+	namespace pmr
+	{
+		/** Allocator-aware version of EFS::RidgeQualityRegion. */
+		struct RidgeQualityRegion
+		{
+			using allocator_type =
+			    std::pmr::polymorphic_allocator<>;
+
+			/** @see EFS::RidgeQualityRegion::region */
+			std::pmr::vector<Coordinate> region{};
+			/** @see EFS::RidgeQualityRegion::quality */
+			RidgeQuality quality{RidgeQuality::Background};
+
+			RidgeQualityRegion() = default;
+			RidgeQualityRegion(
+			    const RidgeQualityRegion&) = default;
+			RidgeQualityRegion(
+			    RidgeQualityRegion&&) = default;
+
+			/**
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			explicit RidgeQualityRegion(
+			    const allocator_type &alloc);
+
+			/**
+			 * @param rqr
+			 * RidgeQualityRegion to copy.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			RidgeQualityRegion(
+			    const RidgeQualityRegion &rqr,
+			    const allocator_type &alloc);
+
+			/**
+			 * @param rqr
+			 * RidgeQualityRegion to move.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			RidgeQualityRegion(
+			    RidgeQualityRegion &&rqr,
+			    const allocator_type &alloc);
+
+			/**
+			 * @param rqr
+			 * EFS::RidgeQualityRegion to copy.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			explicit RidgeQualityRegion(
+			    const EFS::RidgeQualityRegion &rqr,
+			    const allocator_type &alloc = {});
+
+			RidgeQualityRegion&
+			operator=(
+			    const RidgeQualityRegion&) = default;
+			RidgeQualityRegion&
+			operator=(
+			    RidgeQualityRegion&&) = default;
+
+			/** @return Allocator used by all members. */
+			allocator_type
+			get_allocator()
+			    const
+			    noexcept;
+
+			/**
+			 * @return
+			 * Copy of this object using the global heap.
+			 */
+			EFS::RidgeQualityRegion
+			toRidgeQualityRegion()
+			    const;
+		};
+
+		/** Allocator-aware version of EFS::QualityMeasureMap. */
+		using QualityMeasureMap = std::pmr::unordered_map<
+		    QualityMeasure::Description, QualityMeasure,
+		    QualityMeasure::DescriptionHash>;
+
+		/**
+		 * Allocator-aware version of EFS::Features.
+		 *
+		 * @see EFS::Features for documentation of each member.
+		 */
+		struct Features
+		{
+			using allocator_type =
+			    std::pmr::polymorphic_allocator<>;
+
+			uint8_t identifier{};
+			uint16_t ppi{};
+			std::optional<QualityMeasureMap> quality{};
+
+			Impression imp{Impression::Unknown};
+			FrictionRidgeCaptureTechnology frct{
+			    FrictionRidgeCaptureTechnology::Unknown};
+			FrictionRidgeGeneralizedPosition frgp{
+			    FrictionRidgeGeneralizedPosition::
+			    UnknownFrictionRidge};
+
+			std::optional<Orientation> orientation{};
+			std::optional<std::pmr::vector<ProcessingMethod>>
+			    lpm{};
+			std::optional<ValueAssessment> valueAssessment{};
+			std::optional<Substrate> lsb{};
+			std::optional<PatternClassification> pat{};
+
+			std::optional<bool> plr{};
+			std::optional<bool> trv{};
+
+			std::optional<std::pmr::vector<Core>> cores{};
+			std::optional<std::pmr::vector<Delta>> deltas{};
+			std::optional<std::pmr::vector<Minutia>> minutiae{};
+			std::optional<std::pmr::vector<Crease>> creases{};
+			std::optional<std::pmr::vector<Coordinate>> roi{};
+			std::optional<std::pmr::vector<RidgeQualityRegion>>
+			    rqm{};
+
+			std::optional<bool> complex{};
+
+			Features() = default;
+			Features(
+			    Features&&) = default;
+
+			/**
+			 * @param features
+			 * Features to copy into the default memory resource,
+			 * as when copying std::pmr containers.
+			 */
+			Features(
+			    const Features &features);
+
+			/**
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			explicit Features(
+			    const allocator_type &alloc);
+
+			/**
+			 * @param features
+			 * Features to copy.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			Features(
+			    const Features &features,
+			    const allocator_type &alloc);
+
+			/**
+			 * @param features
+			 * Features to move.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			Features(
+			    Features &&features,
+			    const allocator_type &alloc);
+
+			/**
+			 * @param features
+			 * EFS::Features to copy.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			explicit Features(
+			    const EFS::Features &features,
+			    const allocator_type &alloc = {});
+
+			/**
+			 * @param features
+			 * Features to copy with this object's allocator.
+			 */
+			Features&
+			operator=(
+			    const Features &features);
+
+			/**
+			 * @param features
+			 * Features to move, copying if its allocator differs.
+			 */
+			Features&
+			operator=(
+			    Features &&features);
+
+			/** @return Allocator used by all members. */
+			allocator_type
+			get_allocator()
+			    const
+			    noexcept;
+
+			/**
+			 * @return
+			 * Copy of this object using the global heap.
+			 */
+			EFS::Features
+			toFeatures()
+			    const;
+
+		private:
+			/**
+			 * @brief
+			 * Move-assign every member except #alloc.
+			 *
+			 * @param features
+			 * Features using this object's allocator.
+			 */
+			void
+			assign(
+			    Features &&features);
+
+			/** Allocator for all members. */
+			allocator_type alloc{};
+		};
+	}
+
+	/** Version of the binary encoding written by encode(). */
+	constexpr uint16_t FeaturesEncodingVersion{1};
+
+	/**
+	 * @brief
+	 * Encode Features in a compact binary form.
+	 * @details
+	 * The encoding is little-endian regardless of host, and begins with
+	 * FeaturesEncodingVersion. Minutiae, cores, deltas, and region of
+	 * interest vertices are stored as fixed-size records so that
+	 * FeaturesView may read them in place.
+	 *
+	 * @param features
+	 * Features to encode.
+	 *
+	 * @return
+	 * Encoded `features`.
+	 *
+	 * @throw std::runtime_error
+	 * A value of `features` cannot be represented in the encoding.
+	 */
+	std::vector<std::byte>
+	encode(
+	    const Features &features);
+
+	/**
+	 * @brief
+	 * Decode Features encoded with encode().
+	 *
+	 * @param encoded
+	 * Output of encode(), from any version up to
+	 * FeaturesEncodingVersion.
+	 *
+	 * @return
+	 * Decoded Features.
+	 *
+	 * @throw std::runtime_error
+	 * `encoded` is truncated, malformed, or from a newer version.
+	 */
+	Features
+	decode(
+	    std::span<const std::byte> encoded);
+
+	/**
+	 * @brief
+	 * Rescale Features to another resolution.
+	 *
+	 * @details
+	 * Pixel centers are mapped between resolutions, as in
+	 * Image::resample(), and rounded. Coordinate uncertainty radii are
+	 * scaled and rounded. Angles and other properties are unchanged.
+	 *
+	 * @param features
+	 * Features to rescale.
+	 * @param ppi
+	 * Resolution of the returned Features.
+	 *
+	 * @return
+	 * Copy of `features` with Features::ppi of `ppi`.
+	 *
+	 * @throw std::invalid_argument
+	 * `ppi` or `features.ppi` is 0.
+	 */
+	Features
+	rescale(
+	    const Features &features,
+	    const uint16_t ppi);
+
+	/**
+	 * @brief
+	 * Read-only view of fixed-size records within encoded Features.
+	 *
+	 * @note
+	 * Each access decodes one record from the underlying buffer, which
+	 * must outlive this object.
+	 */
+	template<typename T>
+	class RecordView
+	{
+	public:
+		RecordView();
+
+		/**
+		 * @brief
+		 * RecordView constructor.
+		 *
+		 * @param records
+		 * Encoded records, validated to hold `count` records.
+		 * @param count
+		 * Number of records.
+		 */
+		RecordView(
+		    std::span<const std::byte> records,
+		    const std::size_t count);
+
+		/** @return Number of records. */
+		std::size_t
+		size()
+		    const;
+
+		/** @return Whether there are no records. */
+		bool
+		empty()
+		    const;
+
+		/**
+		 * @param i
+		 * Index of the record.
+		 *
+		 * @return
+		 * Record `i`, without bounds checking.
+		 */
+		T
+		operator[](
+		    const std::size_t i)
+		    const;
+
+		/**
+		 * @param i
+		 * Index of the record.
+		 *
+		 * @return
+		 * Record `i`.
+		 *
+		 * @throw std::out_of_range
+		 * `i` is not less than size().
+		 */
+		T
+		at(
+		    const std::size_t i)
+		    const;
+
+	private:
+		std::span<const std::byte> records{};
+		std::size_t count{};
+	};
+
+	extern template class RecordView<Coordinate>;
+	extern template class RecordView<Core>;
+	extern template class RecordView<Delta>;
+	extern template class RecordView<Minutia>;
+
+	/**
+	 * @brief
+	 * Zero-copy reader of Features encoded with encode().
+	 * @details
+	 * Construction validates the encoding's header and section bounds
+	 * without decoding any section. Fixed-size sections are then read in
+	 * place, such as from a memory-mapped file, without building
+	 * Features or its std::optional members.
+	 */
+	class FeaturesView
+	{
+	public:
+		/**
+		 * @brief
+		 * FeaturesView constructor.
+		 *
+		 * @param encoded
+		 * Output of encode(), which must outlive this object.
+		 *
+		 * @throw std::runtime_error
+		 * `encoded` is truncated, malformed, or from a newer version.
+		 */
+		FeaturesView(
+		    std::span<const std::byte> encoded);
+
+		/** @return Encoding version of the underlying buffer. */
+		uint16_t
+		getVersion()
+		    const;
+
+		/** @return Features::identifier. */
+		uint8_t
+		getIdentifier()
+		    const;
+
+		/** @return Features::ppi. */
+		uint16_t
+		getPPI()
+		    const;
+
+		/** @return Features::imp. */
+		Impression
+		getImpression()
+		    const;
+
+		/** @return Features::frct. */
+		FrictionRidgeCaptureTechnology
+		getFrictionRidgeCaptureTechnology()
+		    const;
+
+		/** @return Features::frgp. */
+		FrictionRidgeGeneralizedPosition
+		getFrictionRidgeGeneralizedPosition()
+		    const;
+
+		/** @return Whether Features::minutiae was set. */
+		bool
+		hasMinutiae()
+		    const;
+
+		/** @return Features::minutiae, or empty if not set. */
+		RecordView<Minutia>
+		getMinutiae()
+		    const;
+
+		/** @return Whether Features::cores was set. */
+		bool
+		hasCores()
+		    const;
+
+		/** @return Features::cores, or empty if not set. */
+		RecordView<Core>
+		getCores()
+		    const;
+
+		/** @return Whether Features::deltas was set. */
+		bool
+		hasDeltas()
+		    const;
+
+		/** @return Features::deltas, or empty if not set. */
+		RecordView<Delta>
+		getDeltas()
+		    const;
+
+		/** @return Whether Features::roi was set. */
+		bool
+		hasROI()
+		    const;
+
+		/** @return Features::roi, or empty if not set. */
+		RecordView<Coordinate>
+		getROI()
+		    const;
+
+		/**
+		 * @brief
+		 * Decode every member.
+		 *
+		 * @return
+		 * Same as decode().
+		 *
+		 * @throw std::runtime_error
+		 * A section is malformed.
+		 */
+		Features
+		toFeatures()
+		    const;
+
+	private:
+		/** Encoded Features. */
+		std::span<const std::byte> encoded{};
+	};
 }
 
 #endif /* FRIF_EFS_H_ */
@@ -11,11 +11,15 @@
 #ifndef FRIF_IO_H_
 #define FRIF_IO_H_
 
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 
 #include <frifte/common.h>
@@ -45,6 +49,113 @@ namespace FRIF
 		std::optional<EFS::Features> features{};
 	};
 
+	/** Allocator-aware versions of TE input/output types. */
+	namespace pmr
+	{
+		/**
+		 * @brief
+		 * Allocator-aware version of FRIF::TemplateData.
+		 *
+		 * @details
+		 * All members, including every container within #features,
+		 * obtain memory from one std::pmr::memory_resource, so that
+		 * TemplateData built within a per-request arena may be
+		 * released at once.
+		 *
+		 * @see FRIF::TemplateData for documentation of each member.
+		 * @see EFS::pmr for limitations.
+		 */
+		struct TemplateData
+		{
+			using allocator_type =
+			    std::pmr::polymorphic_allocator<>;
+
+			std::pmr::string identifier{};
+			uint8_t inputIdentifier{};
+			std::optional<EFS::pmr::Features> features{};
+
+			TemplateData() = default;
+			TemplateData(
+			    TemplateData&&) = default;
+
+			/**
+			 * @param templateData
+			 * TemplateData to copy into the default memory
+			 * resource, as when copying std::pmr containers.
+			 */
+			TemplateData(
+			    const TemplateData &templateData);
+
+			/**
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			explicit TemplateData(
+			    const allocator_type &alloc);
+
+			/**
+			 * @param templateData
+			 * TemplateData to copy.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			TemplateData(
+			    const TemplateData &templateData,
+			    const allocator_type &alloc);
+
+			/**
+			 * @param templateData
+			 * TemplateData to move.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			TemplateData(
+			    TemplateData &&templateData,
+			    const allocator_type &alloc);
+
+			/**
+			 * @param templateData
+			 * FRIF::TemplateData to copy.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			explicit TemplateData(
+			    const FRIF::TemplateData &templateData,
+			    const allocator_type &alloc = {});
+
+			/**
+			 * @param templateData
+			 * TemplateData to copy with this object's allocator.
+			 */
+			TemplateData&
+			operator=(
+			    const TemplateData &templateData);
+
+			/**
+			 * @param templateData
+			 * TemplateData to move, copying if its allocator
+			 * differs.
+			 */
+			TemplateData&
+			operator=(
+			    TemplateData &&templateData);
+
+			/** @return Allocator used by all members. */
+			allocator_type
+			get_allocator()
+			    const
+			    noexcept;
+
+			/**
+			 * @return
+			 * Copy of this object using the global heap.
+			 */
+			FRIF::TemplateData
+			toTemplateData()
+			    const;
+		};
+	}
+
 	/** Output from extracting features into a template .*/
 	struct CreateTemplateResult
 	{
@@ -77,6 +188,112 @@ namespace FRIF
 		std::optional<std::vector<TemplateData>> extractedData{};
 	};
 
+	namespace pmr
+	{
+		/**
+		 * @brief
+		 * Allocator-aware version of FRIF::CreateTemplateResult.
+		 *
+		 * @details
+		 * #data and every TemplateData within #extractedData obtain
+		 * memory from one std::pmr::memory_resource.
+		 *
+		 * @see FRIF::CreateTemplateResult for documentation of each
+		 * member.
+		 */
+		struct CreateTemplateResult
+		{
+			using allocator_type =
+			    std::pmr::polymorphic_allocator<>;
+
+			std::pmr::vector<std::byte> data{};
+			std::optional<std::pmr::vector<TemplateData>>
+			    extractedData{};
+
+			CreateTemplateResult() = default;
+			CreateTemplateResult(
+			    CreateTemplateResult&&) = default;
+
+			/**
+			 * @param templateResult
+			 * CreateTemplateResult to copy into the default
+			 * memory resource, as when copying std::pmr
+			 * containers.
+			 */
+			CreateTemplateResult(
+			    const CreateTemplateResult &templateResult);
+
+			/**
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			explicit CreateTemplateResult(
+			    const allocator_type &alloc);
+
+			/**
+			 * @param templateResult
+			 * CreateTemplateResult to copy.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			CreateTemplateResult(
+			    const CreateTemplateResult &templateResult,
+			    const allocator_type &alloc);
+
+			/**
+			 * @param templateResult
+			 * CreateTemplateResult to move.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			CreateTemplateResult(
+			    CreateTemplateResult &&templateResult,
+			    const allocator_type &alloc);
+
+			/**
+			 * @param templateResult
+			 * FRIF::CreateTemplateResult to copy.
+			 * @param alloc
+			 * Allocator for all members.
+			 */
+			explicit CreateTemplateResult(
+			    const FRIF::CreateTemplateResult &templateResult,
+			    const allocator_type &alloc = {});
+
+			/**
+			 * @param templateResult
+			 * CreateTemplateResult to copy with this object's
+			 * allocator.
+			 */
+			CreateTemplateResult&
+			operator=(
+			    const CreateTemplateResult &templateResult);
+
+			/**
+			 * @param templateResult
+			 * CreateTemplateResult to move, copying if its
+			 * allocator differs.
+			 */
+			CreateTemplateResult&
+			operator=(
+			    CreateTemplateResult &&templateResult);
+
+			/** @return Allocator used by all members. */
+			allocator_type
+			get_allocator()
+			    const
+			    noexcept;
+
+			/**
+			 * @return
+			 * Copy of this object using the global heap.
+			 */
+			FRIF::CreateTemplateResult
+			toCreateTemplateResult()
+			    const;
+		};
+	}
+
 	/** Information about a probe/reference relationship. */
 	struct Correspondence
 	{
@@ -140,6 +357,13 @@ namespace FRIF
 	 */
 	using SubjectCandidate = std::string;
 
+	/**
+	 * Dense integer standing in for a SubjectCandidate.
+	 *
+	 * @see SubjectIdentifierDictionary
+	 */
+	using SubjectID = uint32_t;
+
 	/** Hash function for SubjectPositionCandidate. */
 	struct SubjectPositionCandidateListKeyHash
 	{
@@ -206,6 +430,148 @@ namespace FRIF
 	using SubjectCandidateListCorrespondence =
 	    std::unordered_map<std::string, Correspondence>;
 
+	/**
+	 * @brief
+	 * Candidate list of fixed capacity, kept in rank order.
+	 * @details
+	 * Candidates are stored contiguously in a heap whose front is the
+	 * lowest-ranked candidate, so pushing to a full list replaces that
+	 * candidate in logarithmic time without allocating. Candidates are
+	 * ranked by descending similarity, then by ascending key. A
+	 * similarity that is NaN ranks below every other similarity.
+	 *
+	 * @note
+	 * Pushing the same candidate more than once stores each copy.
+	 * toCandidateList() keeps the highest similarity of any copies.
+	 *
+	 * @see RankedSubjectCandidateList
+	 * @see RankedSubjectPositionCandidateList
+	 */
+	template<typename Candidate, typename Hash = std::hash<Candidate>>
+	class RankedCandidateList
+	{
+	public:
+		/** Candidate and its similarity to the probe. */
+		using value_type = std::pair<Candidate, double>;
+		/** Legacy candidate list type. */
+		using CandidateList = std::unordered_map<Candidate, double,
+		    Hash>;
+
+		/**
+		 * @brief
+		 * RankedCandidateList constructor.
+		 *
+		 * @param capacity
+		 * Maximum number of candidates to keep.
+		 */
+		RankedCandidateList(
+		    const std::size_t capacity);
+
+		/**
+		 * @brief
+		 * RankedCandidateList constructor.
+		 *
+		 * @param candidateList
+		 * Candidates to push.
+		 * @param capacity
+		 * Maximum number of candidates to keep.
+		 */
+		RankedCandidateList(
+		    const CandidateList &candidateList,
+		    const std::size_t capacity);
+
+		/**
+		 * @brief
+		 * Offer a candidate to the list.
+		 *
+		 * @param candidate
+		 * Candidate to add.
+		 * @param similarity
+		 * Similarity of `candidate` to the probe.
+		 *
+		 * @return
+		 * true if `candidate` was kept, false if the list is full of
+		 * higher-ranked candidates.
+		 */
+		bool
+		push(
+		    const Candidate &candidate,
+		    const double similarity);
+
+		/**
+		 * @brief
+		 * Obtain the candidates in rank order.
+		 *
+		 * @return
+		 * View of the candidates, highest-ranked first, valid until
+		 * the next call to push().
+		 */
+		std::span<const value_type>
+		rank();
+
+		/**
+		 * @brief
+		 * Obtain the similarity a candidate must exceed to be kept.
+		 *
+		 * @return
+		 * Similarity of the lowest-ranked candidate if the list is
+		 * full, std::nullopt otherwise.
+		 *
+		 * @note
+		 * Engines may use this to skip scoring candidates that
+		 * cannot be kept.
+		 */
+		std::optional<double>
+		getThreshold()
+		    const;
+
+		/**
+		 * @brief
+		 * Convert to the legacy candidate list type.
+		 *
+		 * @return
+		 * Candidates as a CandidateList.
+		 */
+		CandidateList
+		toCandidateList()
+		    const;
+
+		/** @return Maximum number of candidates kept. */
+		std::size_t
+		getCapacity()
+		    const;
+
+		/** @return Number of candidates kept. */
+		std::size_t
+		size()
+		    const;
+
+		/** @return Whether no candidates are kept. */
+		bool
+		empty()
+		    const;
+
+	private:
+		/** Maximum number of candidates kept. */
+		std::size_t capacity{};
+		/** Candidates, as a heap unless #ranked. */
+		std::vector<value_type> entries{};
+		/** Whether #entries is sorted in rank order. */
+		bool ranked{true};
+	};
+
+	extern template class RankedCandidateList<SubjectCandidate>;
+	extern template class RankedCandidateList<SubjectPositionCandidate,
+	    SubjectPositionCandidateListKeyHash>;
+
+	/** RankedCandidateList convertible to SubjectCandidateList. */
+	using RankedSubjectCandidateList =
+	    RankedCandidateList<SubjectCandidate>;
+	/** RankedCandidateList convertible to SubjectPositionCandidateList. */
+	using RankedSubjectPositionCandidateList =
+	    RankedCandidateList<SubjectPositionCandidate,
+	    SubjectPositionCandidateListKeyHash>;
+
 	/** The results of comparing two templates. */
 	struct ComparisonResult
 	{
@@ -240,6 +606,34 @@ namespace FRIF
 		std::optional<Correspondence> correspondence{};
 	};
 
+	/** Why a search stopped considering the reference database. */
+	enum class SearchTermination
+	{
+		/** The entire reference database was considered. */
+		Complete = 0,
+		/** SearchLimits#deadline was reached. */
+		Deadline,
+		/** A candidate reached SearchLimits#minSimilarity. */
+		MinimumSimilarity
+	};
+
+	/** Optional limits on the work performed by a single search. */
+	struct SearchLimits
+	{
+		/**
+		 * Time at which the search should return the best candidates
+		 * found so far.
+		 */
+		std::optional<std::chrono::steady_clock::time_point>
+		    deadline{};
+
+		/**
+		 * Similarity at or above which the search may return as soon
+		 * as a candidate is found.
+		 */
+		std::optional<double> minSimilarity{};
+	};
+
 	/**
 	 * The results of a searching a database for subject finger positions.
 	 */
@@ -277,6 +671,14 @@ namespace FRIF
 		 */
 		std::optional<SubjectPositionCandidateListCorrespondence>
 		    correspondence{};
+
+		/**
+		 * Whether the search considered the entire reference
+		 * database. Any other value means #candidateList contains
+		 * only the best candidates found before a SearchLimits was
+		 * reached.
+		 */
+		SearchTermination termination{SearchTermination::Complete};
 	};
 
 	/**
@@ -317,6 +719,32 @@ namespace FRIF
 		 */
 		std::optional<SubjectCandidateListCorrespondence>
 		    correspondence{};
+
+		/**
+		 * Whether the search considered the entire reference
+		 * database. Any other value means #candidateList contains
+		 * only the best candidates found before a SearchLimits was
+		 * reached.
+		 */
+		SearchTermination termination{SearchTermination::Complete};
+	};
+
+	/** Identifier of a search submitted for asynchronous completion. */
+	using SearchTicket = uint64_t;
+
+	/** Outcome of a search submitted for asynchronous completion. */
+	struct SearchCompletion
+	{
+		/** Value returned when the search was submitted. */
+		SearchTicket ticket{};
+		/** Information about the result of executing the search. */
+		ReturnStatus status{};
+		/**
+		 * Result of the search, holding the type matching the method
+		 * used to submit the search.
+		 */
+		std::variant<std::optional<SearchSubjectResult>,
+		    std::optional<SearchSubjectPositionResult>> result{};
 	};
 
 	/** Collection of templates on disk. */
@@ -341,14 +769,120 @@ namespace FRIF
 		 * Identifiers are guaranteed to never contain spaces. That is,
 		 * each line of the manifest is guaranteed to have exactly two
 		 * spaces, used to delimit the three fields in each line.
+		 *
+		 * @note
+		 * Each identifier appears on only one line, so interning
+		 * identifiers into a SubjectIdentifierDictionary in the order
+		 * of the lines assigns each line's zero-based index as its
+		 * SubjectID.
 		 */
 		std::filesystem::path manifest{};
 	};
 
+	/**
+	 * @brief
+	 * Bidirectional mapping between subject identifiers and dense
+	 * SubjectID.
+	 * @details
+	 * IDs are assigned in the order identifiers are first interned,
+	 * starting at 0, so they may index contiguous per-subject storage.
+	 */
+	class SubjectIdentifierDictionary
+	{
+	public:
+		SubjectIdentifierDictionary();
+
+		/**
+		 * @brief
+		 * Obtain the SubjectID of an identifier, assigning the next
+		 * SubjectID if it has not been seen.
+		 *
+		 * @param identifier
+		 * Subject identifier.
+		 *
+		 * @return
+		 * SubjectID of `identifier`.
+		 *
+		 * @throw
+		 * No SubjectID remain.
+		 */
+		SubjectID
+		intern(
+		    const std::string &identifier);
+
+		/**
+		 * @brief
+		 * Obtain the SubjectID of an identifier.
+		 *
+		 * @param identifier
+		 * Subject identifier.
+		 *
+		 * @return
+		 * SubjectID of `identifier`, if interned.
+		 */
+		std::optional<SubjectID>
+		find(
+		    const std::string &identifier)
+		    const;
+
+		/**
+		 * @brief
+		 * Obtain the identifier of a SubjectID.
+		 *
+		 * @param id
+		 * SubjectID returned from intern().
+		 *
+		 * @return
+		 * Identifier interned as `id`.
+		 *
+		 * @throw std::out_of_range
+		 * `id` was not returned from intern().
+		 */
+		const std::string&
+		resolve(
+		    const SubjectID id)
+		    const;
+
+		/** @return Number of identifiers interned. */
+		std::size_t
+		size()
+		    const;
+
+	private:
+		/** SubjectID of each identifier. */
+		std::unordered_map<std::string, SubjectID> ids{};
+		/** Identifier of each SubjectID, indexed by SubjectID. */
+		std::vector<std::string> identifiers{};
+	};
+
 	/** Convenience definition for a friction ridge sample */
 	using Sample = std::tuple<std::optional<Image>,
 	    std::optional<EFS::Features>>;
 
+	/**
+	 * @brief
+	 * Normalize the resolution of a Sample.
+	 *
+	 * @param sample
+	 * Sample to resample.
+	 * @param ppi
+	 * Resolution of the returned Sample.
+	 * @param options
+	 * Parallelism of resampling the Image.
+	 *
+	 * @return
+	 * `sample`, with its Image resampled with Image::resample() and its
+	 * EFS::Features rescaled with EFS::rescale().
+	 *
+	 * @throw
+	 * Error resampling the Image or rescaling the EFS::Features.
+	 */
+	Sample
+	resample(
+	    const Sample &sample,
+	    const uint16_t ppi,
+	    const ResampleOptions &options = {});
+
 	/** Use for data extracted from Sample. */
 	enum class TemplateType
 	{
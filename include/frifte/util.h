@@ -11,10 +11,24 @@
 #ifndef FRIF_UTIL_H_
 #define FRIF_UTIL_H_
 
+#include <array>
+#include <atomic>
+#include <charconv>
 #include <chrono>
+#include <cstddef>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace FRIF::Util
 {
@@ -77,6 +91,28 @@ namespace FRIF::Util
 		return (std::to_string(e2i(t)));
 	}
 
+	/**
+	 * @brief
+	 * Mix the hash of a value into a running hash.
+	 *
+	 * @param seed
+	 * Running hash, modified in place.
+	 * @param value
+	 * Value whose std::hash is mixed into `seed`.
+	 *
+	 * @note
+	 * Unlike hashing a concatenated string, this never allocates.
+	 */
+	template<typename T>
+	void
+	hashCombine(
+	    std::size_t &seed,
+	    const T &value)
+	{
+		seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) +
+		    (seed >> 2);
+	}
+
 	/**
 	 * @brief
 	 * Make a string lowercase in place.
@@ -91,6 +127,197 @@ namespace FRIF::Util
 	lower(
 	    std::string &s);
 
+	/** Read-only view of an entire file mapped into memory. */
+	class MappedFile
+	{
+	public:
+		/** Expected pattern of access to the mapped file. */
+		enum class Access
+		{
+			/** No particular pattern. */
+			Normal,
+			/** Read once, from start to end. */
+			Sequential,
+			/** Read in no particular order. */
+			Random,
+			/** Read entirely, soon. */
+			WillNeed
+		};
+
+		/**
+		 * @brief
+		 * MappedFile constructor.
+		 *
+		 * @param pathName
+		 * Path to file to map.
+		 * @param access
+		 * Expected pattern of access, passed to advise().
+		 *
+		 * @throw runtime_error
+		 * Error opening or mapping `pathName`.
+		 */
+		MappedFile(
+		    const std::filesystem::path &pathName,
+		    const Access access = Access::Normal);
+
+		/**
+		 * @brief
+		 * Tell the kernel how the mapping will be accessed, so
+		 * that it may read ahead or not.
+		 *
+		 * @param access
+		 * Expected pattern of access.
+		 *
+		 * @note
+		 * Advice is only a hint, and failure to apply it is
+		 * ignored.
+		 */
+		void
+		advise(
+		    const Access access)
+		    const;
+
+		/**
+		 * @return
+		 * View of the contents of the mapped file.
+		 *
+		 * @note
+		 * View is only valid for the lifetime of this object.
+		 */
+		std::span<const std::byte>
+		data()
+		    const;
+
+		/** @return Number of bytes in the mapped file. */
+		std::size_t
+		size()
+		    const;
+
+		MappedFile(MappedFile &&rhs) noexcept;
+		MappedFile& operator=(MappedFile &&rhs) noexcept;
+		~MappedFile();
+
+		/** Suppress copying mapping ownership. */
+		MappedFile(const MappedFile&) = delete;
+		/** Suppress copying mapping ownership. */
+		MappedFile& operator=(const MappedFile&) = delete;
+
+	private:
+		/** Start of the mapping (nullptr for empty files). */
+		void *address{nullptr};
+		/** Number of bytes mapped. */
+		std::size_t length{};
+	};
+
+	/** Contents of a file and the object keeping them valid. */
+	struct FileContents
+	{
+		/** Bytes of the file. */
+		std::span<const std::byte> data{};
+		/** Object owning #data. */
+		std::shared_ptr<const void> owner{};
+	};
+
+	/**
+	 * @brief
+	 * Read files, in an order known in advance, ahead of their use.
+	 *
+	 * @details
+	 * Up to `depth` files are read at once with io_uring or, where
+	 * io_uring is unavailable, with a pool of threads. Contents are
+	 * returned from next() in the order of the paths passed to the
+	 * constructor and then to extend(), so that storage is read while
+	 * the caller uses earlier files.
+	 */
+	class FilePrefetcher
+	{
+	public:
+		/** Mechanism used to read files. */
+		enum class Backend
+		{
+			/** Asynchronous reads submitted to io_uring. */
+			IOURing,
+			/** Blocking reads on a pool of threads. */
+			Threads
+		};
+
+		/**
+		 * @brief
+		 * FilePrefetcher constructor. Reading begins immediately.
+		 *
+		 * @param pathNames
+		 * Files to read, in the order they will be requested.
+		 * @param depth
+		 * Maximum number of files read ahead of the caller.
+		 * @param backend
+		 * Preferred mechanism. Backend::Threads is used if
+		 * io_uring is unavailable.
+		 *
+		 * @throw std::invalid_argument
+		 * `depth` is 0.
+		 */
+		FilePrefetcher(
+		    std::vector<std::filesystem::path> pathNames,
+		    const uint16_t depth,
+		    const Backend backend = Backend::IOURing);
+
+		/**
+		 * @brief
+		 * Obtain the contents of the next file, waiting for it to
+		 * be read if necessary.
+		 *
+		 * @param pathName
+		 * Path to the next file, to confirm that files are
+		 * requested in order.
+		 *
+		 * @return
+		 * Contents of `pathName`.
+		 *
+		 * @throw std::logic_error
+		 * `pathName` is not the next file.
+		 * @throw std::runtime_error
+		 * Error reading `pathName`.
+		 */
+		FileContents
+		next(
+		    const std::filesystem::path &pathName);
+
+		/**
+		 * @brief
+		 * Append files to read after those already requested.
+		 *
+		 * @param pathNames
+		 * Files to read, in the order they will be requested.
+		 *
+		 * @note
+		 * Reading continues from where it stopped, so the
+		 * prefetcher need not be rebuilt to read more files.
+		 */
+		void
+		extend(
+		    std::vector<std::filesystem::path> pathNames);
+
+		/** @return Mechanism used to read files. */
+		Backend
+		getBackend()
+		    const;
+
+		~FilePrefetcher();
+
+		/** Suppress copying in-flight reads. */
+		FilePrefetcher(const FilePrefetcher&) = delete;
+		/** Suppress copying in-flight reads. */
+		FilePrefetcher& operator=(const FilePrefetcher&) = delete;
+
+	private:
+		class Impl;
+		class IOURingReader;
+		class ThreadPoolReader;
+
+		/** Backend reading files. */
+		std::unique_ptr<Impl> impl;
+	};
+
 	/**
 	 * @brief
 	 * Obtain a list of random non-repeating positive integers.
@@ -164,6 +391,154 @@ namespace FRIF::Util
 	    const bool escapeQuotes = true,
 	    const bool wrapInQuotes = true);
 
+	/**
+	 * @brief
+	 * Reusable buffer for building log lines.
+	 *
+	 * @details
+	 * Values are appended in place, with numbers formatted by
+	 * std::to_chars, so building a line creates no temporary strings.
+	 * Numbers are formatted as by ts() and e2i2s(), and an empty
+	 * std::optional as NA. clear() keeps capacity, so a buffer reused
+	 * for many lines stops allocating once it fits the longest.
+	 */
+	class LogBuffer
+	{
+	public:
+		/**
+		 * @brief
+		 * Append a character.
+		 *
+		 * @param c
+		 * Character to append.
+		 *
+		 * @return
+		 * Reference to this LogBuffer.
+		 */
+		LogBuffer&
+		operator<<(
+		    const char c);
+
+		/**
+		 * @brief
+		 * Append a string.
+		 *
+		 * @param s
+		 * String to append.
+		 *
+		 * @return
+		 * Reference to this LogBuffer.
+		 */
+		LogBuffer&
+		operator<<(
+		    const std::string_view s);
+
+		/**
+		 * @brief
+		 * Append a number or the integral value of an enumeration.
+		 *
+		 * @param t
+		 * Value to append.
+		 *
+		 * @return
+		 * Reference to this LogBuffer.
+		 */
+		template<typename T>
+		    requires (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+		LogBuffer&
+		operator<<(
+		    const T t)
+		{
+			if constexpr (std::is_enum_v<T>)
+				this->appendNumber(e2i(t));
+			else
+				this->appendNumber(t);
+			return (*this);
+		}
+
+		/**
+		 * @brief
+		 * Append an optional value.
+		 *
+		 * @param t
+		 * Value to append.
+		 *
+		 * @return
+		 * Reference to this LogBuffer.
+		 */
+		template<typename T>
+		LogBuffer&
+		operator<<(
+		    const std::optional<T> &t)
+		{
+			if (t)
+				return (*this << *t);
+			return (*this << NA);
+		}
+
+		/**
+		 * @brief
+		 * Remove a suffix, such as a trailing separator.
+		 *
+		 * @param suffix
+		 * Suffix to remove, if present.
+		 */
+		void
+		removeSuffix(
+		    const std::string_view suffix);
+
+		/** @brief Empty the buffer without releasing capacity. */
+		void
+		clear()
+		    noexcept;
+
+		/** @return Contents of the buffer. */
+		std::string_view
+		view()
+		    const
+		    noexcept;
+
+		/** @return Copy of the contents of the buffer. */
+		std::string
+		str()
+		    const;
+
+	private:
+		/**
+		 * @brief
+		 * Append a number as ts() would format it.
+		 *
+		 * @param t
+		 * Number to append.
+		 */
+		template<typename T>
+		void
+		appendNumber(
+		    const T t)
+		{
+			if constexpr (std::is_same_v<T, bool>) {
+				this->buffer += (t ? '1' : '0');
+			} else if constexpr (std::is_floating_point_v<T>) {
+				/* std::to_string() uses "%f" */
+				std::array<char, std::numeric_limits<T>::
+				    max_exponent10 + 16> chars;
+				const auto result = std::to_chars(chars.data(),
+				    chars.data() + chars.size(), t,
+				    std::chars_format::fixed, 6);
+				this->buffer.append(chars.data(), result.ptr);
+			} else {
+				std::array<char,
+				    std::numeric_limits<T>::digits10 + 2> chars;
+				const auto result = std::to_chars(chars.data(),
+				    chars.data() + chars.size(), t);
+				this->buffer.append(chars.data(), result.ptr);
+			}
+		}
+
+		/** Contents of the buffer. */
+		std::string buffer{};
+	};
+
 	/**
 	 * @brief
 	 * Make a log-able string out of a vector of Coordinate.
@@ -427,15 +802,552 @@ namespace FRIF::Util
 	std::string
 	splice(
 	    const std::vector<T> &v,
+	    const std::string &itemSep = "|");
+
+	/*
+	 * Each overload of splice() taking a LogBuffer appends what the
+	 * overload returning std::string would return, and throws under the
+	 * same conditions.
+	 */
+
+	/**
+	 * @see
+	 * splice(const std::vector<Coordinate>&, const std::string&,
+	 * const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    std::span<const Coordinate> v,
+	    const std::string &elementSep = ";",
+	    const std::string &itemSep = "|");
+
+	/**
+	 * @see
+	 * splice(const std::vector<EFS::Minutia>&, const std::string&,
+	 * const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    std::span<const EFS::Minutia> v,
+	    const std::string &elementSep = ";",
+	    const std::string &itemSep = "|");
+
+	/**
+	 * @see
+	 * splice(const std::vector<EFS::Core>&, const std::string&,
+	 * const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    std::span<const EFS::Core> v,
+	    const std::string &elementSep = ";",
+	    const std::string &itemSep = "|");
+
+	/**
+	 * @see
+	 * splice(const std::vector<EFS::Delta>&, const std::string&,
+	 * const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    std::span<const EFS::Delta> v,
+	    const std::string &elementSep = ";",
+	    const std::string &itemSep = "|");
+
+	/**
+	 * @see
+	 * splice(const std::vector<EFS::RidgeQualityRegion>&,
+	 * const std::string&, const std::string&, const std::string&,
+	 * const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    std::span<const EFS::RidgeQualityRegion> v,
+	    const std::string &elementSep = ":",
+	    const std::string &itemSep = "^",
+	    const std::string &coordinateElementSep = ";",
+	    const std::string &coordinateItemSep = "|");
+
+	/**
+	 * @see
+	 * splice(const std::vector<EFS::RidgeQualityRegion>&,
+	 * const std::string&, const std::string&, const std::string&,
+	 * const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    std::span<const EFS::pmr::RidgeQualityRegion> v,
+	    const std::string &elementSep = ":",
+	    const std::string &itemSep = "^",
+	    const std::string &coordinateElementSep = ";",
+	    const std::string &coordinateItemSep = "|");
+
+	/**
+	 * @see
+	 * splice(const std::vector<std::string>&,
+	 * const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    std::span<const std::string> v,
+	    const std::string &itemSep);
+
+	/**
+	 * @see
+	 * splice(const std::vector<Segment>&, const std::string&,
+	 * const std::string&, const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    std::span<const Segment> v,
+	    const std::string &itemSep = "^",
+	    const std::string &coordinateElementSep = ";",
+	    const std::string &coordinateItemSep = "|");
+
+	/**
+	 * @see
+	 * splice(const std::vector<EFS::Crease>&, const std::string&,
+	 * const std::string&, const std::string&, const std::string&,
+	 * const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    std::span<const EFS::Crease> v,
+	    const std::string &elementSep = ":",
+	    const std::string &itemSep = "^",
+	    const std::string &segmentItemSep = "~",
+	    const std::string &coordinateElementSep = ";",
+	    const std::string &coordinateItemSep = "|");
+
+	/**
+	 * @see
+	 * splice(const EFS::QualityMeasure::Description&,
+	 * const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    const EFS::QualityMeasure::Description &d,
+	    const std::string &elementSep = ";");
+
+	/**
+	 * @see
+	 * splice(const EFS::QualityMeasure&, const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    const EFS::QualityMeasure &q,
+	    const std::string &elementSep = ";");
+
+	/**
+	 * @see
+	 * splice(const EFS::QualityMeasureMap&, const std::string&,
+	 * const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    const EFS::QualityMeasureMap &m,
+	    const std::string &elementSep = ";",
+	    const std::string &itemSep = "|");
+
+	/**
+	 * @see
+	 * splice(const EFS::QualityMeasureMap&, const std::string&,
+	 * const std::string&)
+	 */
+	void
+	splice(
+	    LogBuffer &buffer,
+	    const EFS::pmr::QualityMeasureMap &m,
+	    const std::string &elementSep = ";",
+	    const std::string &itemSep = "|");
+
+	/**
+	 * @see
+	 * splice(const std::vector<T>&, const std::string&)
+	 */
+	template<typename T,
+	    typename = typename std::enable_if_t<std::is_enum_v<T>>>
+	void
+	splice(
+	    LogBuffer &buffer,
+	    const std::vector<T> &v,
+	    const std::string &itemSep = "|")
+	{
+		for (const auto &e : v)
+			buffer << e << itemSep;
+		if (!v.empty())
+			buffer.removeSuffix(itemSep);
+	}
+
+	/**
+	 * @see
+	 * splice(const std::vector<T>&, const std::string&)
+	 */
+	template<typename T,
+	    typename = typename std::enable_if_t<std::is_enum_v<T>>>
+	void
+	splice(
+	    LogBuffer &buffer,
+	    const std::pmr::vector<T> &v,
 	    const std::string &itemSep = "|")
 	{
-		std::string ret{};
 		for (const auto &e : v)
-			ret += e2i2s(e) + itemSep;
-		ret.erase(ret.find_last_of(itemSep), itemSep.length());
-		return (ret);
+			buffer << e << itemSep;
+		if (!v.empty())
+			buffer.removeSuffix(itemSep);
+	}
+
+	template<typename T, typename>
+	std::string
+	splice(
+	    const std::vector<T> &v,
+	    const std::string &itemSep)
+	{
+		LogBuffer buffer{};
+		splice(buffer, v, itemSep);
+		return (buffer.str());
 	}
 
+	/**
+	 * @brief
+	 * Counts of latencies in logarithmic buckets of linear sub-buckets,
+	 * in the manner of an HDR histogram.
+	 *
+	 * @details
+	 * Values are microseconds. Values below 2^(SubBucketBits + 1) are
+	 * counted exactly, and larger values in buckets narrower than
+	 * 1/2^SubBucketBits of their value. Values of 2^MaxValueBits or more
+	 * are counted as 2^MaxValueBits - 1. All histograms share one layout,
+	 * so histograms from many processes merge without loss of precision.
+	 */
+	class LatencyHistogram
+	{
+	public:
+		/** log2 of the number of sub-buckets in each bucket. */
+		static constexpr uint8_t SubBucketBits{7};
+		/** log2 of the smallest value that is clamped. */
+		static constexpr uint8_t MaxValueBits{40};
+
+		LatencyHistogram();
+
+		/**
+		 * @brief
+		 * LatencyHistogram constructor.
+		 *
+		 * @param in
+		 * Stream positioned at a histogram written by write().
+		 *
+		 * @throw runtime_error
+		 * Histogram is malformed or of a different layout.
+		 */
+		explicit LatencyHistogram(
+		    std::istream &in);
+
+		/**
+		 * @brief
+		 * Count one latency.
+		 *
+		 * @param value
+		 * Latency, in microseconds.
+		 */
+		void
+		record(
+		    const uint64_t value);
+
+		/**
+		 * @brief
+		 * Count one latency.
+		 *
+		 * @param start
+		 * When the measured call began.
+		 * @param stop
+		 * When the measured call returned.
+		 */
+		void
+		record(
+		    const std::chrono::steady_clock::time_point &start,
+		    const std::chrono::steady_clock::time_point &stop);
+
+		/**
+		 * @brief
+		 * Add the counts of another histogram to this one.
+		 *
+		 * @param rhs
+		 * Histogram to add.
+		 */
+		void
+		merge(
+		    const LatencyHistogram &rhs);
+
+		/** @return Number of latencies counted. */
+		uint64_t
+		getCount()
+		    const;
+
+		/** @return Largest latency counted, or 0 if none. */
+		uint64_t
+		getMax()
+		    const;
+
+		/**
+		 * @brief
+		 * Obtain a percentile of the latencies counted.
+		 *
+		 * @param percentile
+		 * Percentile to obtain, in [0, 100].
+		 *
+		 * @return
+		 * Largest value in the bucket holding `percentile`, no
+		 * larger than getMax(), or 0 if nothing was counted.
+		 */
+		uint64_t
+		getValueAtPercentile(
+		    const double percentile)
+		    const;
+
+		/**
+		 * @brief
+		 * Write the histogram in a form read by LatencyHistogram().
+		 *
+		 * @param out
+		 * Stream to write to.
+		 *
+		 * @note
+		 * Only non-zero buckets are written.
+		 */
+		void
+		write(
+		    std::ostream &out)
+		    const;
+
+	private:
+		/** @return Index of the bucket counting `value`. */
+		static std::size_t
+		getIndex(
+		    const uint64_t value);
+
+		/** @return Largest value counted by bucket `index`. */
+		static uint64_t
+		getHighestValue(
+		    const std::size_t index);
+
+		/** Count of each bucket. */
+		std::vector<uint64_t> counts{};
+		/** Sum of #counts. */
+		uint64_t count{};
+		/** Largest value counted. */
+		uint64_t max{};
+	};
+
+	/**
+	 * @brief
+	 * Hardware and kernel event counts of the calling thread and the
+	 * threads it creates, read around a region of code.
+	 *
+	 * @details
+	 * Counters are opened with perf_event_open(2) for the thread that
+	 * constructs the object, and are inherited by threads and processes
+	 * it creates afterwards, counting all of them in user space.
+	 * Threads that already exist are not counted. Events the kernel,
+	 * hardware, or perf_event_paranoid setting will not count are
+	 * reported as std::nullopt. Each event is read on its own, since
+	 * inherited events cannot be read as a group, and is scaled when
+	 * the kernel multiplexed it.
+	 */
+	class PerfCounters
+	{
+	public:
+		/** Events counted. */
+		enum class Event
+		{
+			/** CPU cycles. */
+			Cycles,
+			/** Instructions retired. */
+			Instructions,
+			/** Last level cache misses. */
+			LLCMisses,
+			/** Mispredicted branches. */
+			BranchMisses,
+			/** Page faults. */
+			PageFaults
+		};
+		/** All Events, in the order of Counts. */
+		static constexpr std::array<Event, 5> Events{Event::Cycles,
+		    Event::Instructions, Event::LLCMisses, Event::BranchMisses,
+		    Event::PageFaults};
+		/** Count of each of Events, if counted. */
+		using Counts = std::array<std::optional<uint64_t>,
+		    Events.size()>;
+
+		/**
+		 * @brief
+		 * PerfCounters constructor.
+		 *
+		 * @note
+		 * Events that cannot be counted are not an error.
+		 */
+		PerfCounters();
+
+		/** @return Whether `event` is being counted. */
+		bool
+		isCounting(
+		    const Event event)
+		    const;
+
+		/**
+		 * @brief
+		 * Begin a region to count.
+		 *
+		 * @throw runtime_error
+		 * Error reading counters.
+		 */
+		void
+		start();
+
+		/**
+		 * @brief
+		 * End the region begun by the last start().
+		 *
+		 * @return
+		 * Events counted since start().
+		 *
+		 * @throw runtime_error
+		 * Error reading counters.
+		 */
+		Counts
+		stop();
+
+		/** @return Lowercase name of `event`, for log headers. */
+		static std::string
+		getName(
+		    const Event event);
+
+		~PerfCounters();
+
+		/** Suppress copying descriptor ownership. */
+		PerfCounters(const PerfCounters&) = delete;
+		/** Suppress copying descriptor ownership. */
+		PerfCounters& operator=(const PerfCounters&) = delete;
+
+	private:
+		/** Values read from one event at a point in time. */
+		struct Reading
+		{
+			/** Value of the event. */
+			uint64_t value{};
+			/** Time the event was enabled, in nanoseconds. */
+			uint64_t enabled{};
+			/** Time the event was counting, in nanoseconds. */
+			uint64_t running{};
+		};
+
+		/**
+		 * @brief
+		 * Read one event.
+		 *
+		 * @param index
+		 * Index of the event in Events.
+		 *
+		 * @return
+		 * Current values of the event.
+		 *
+		 * @throw runtime_error
+		 * Error reading the event.
+		 */
+		Reading
+		read(
+		    const std::size_t index)
+		    const;
+
+		/** Descriptor of each of Events, or -1 if not counted. */
+		std::array<int, Events.size()> fds{};
+		/** Values of each of Events read by the last start(). */
+		std::array<Reading, Events.size()> begin{};
+	};
+
+	/**
+	 * @brief
+	 * Positions in a list of work, claimed in chunks by workers that
+	 * share it.
+	 *
+	 * @details
+	 * The next unclaimed position is kept in an anonymous shared
+	 * mapping, so threads and processes forked after construction all
+	 * claim from the same queue. Workers that finish early claim more,
+	 * rather than waiting on a worker given slower work.
+	 */
+	class WorkQueue
+	{
+	public:
+		/**
+		 * @brief
+		 * WorkQueue constructor.
+		 *
+		 * @param size
+		 * Number of positions in the list of work.
+		 * @param chunkSize
+		 * Number of positions given out by each claim().
+		 *
+		 * @throw invalid_argument
+		 * `chunkSize` is 0.
+		 * @throw runtime_error
+		 * Error mapping shared memory.
+		 */
+		WorkQueue(
+		    const uint64_t size,
+		    const uint64_t chunkSize);
+
+		/**
+		 * @brief
+		 * Claim the next chunk of positions.
+		 *
+		 * @return
+		 * Half-open range [first, last) of positions claimed by
+		 * no other worker, or std::nullopt if all positions have
+		 * been claimed. The final range may be shorter than
+		 * the chunk size.
+		 */
+		std::optional<std::pair<uint64_t, uint64_t>>
+		claim();
+
+		/** @return Number of positions in the list of work. */
+		uint64_t
+		getSize()
+		    const;
+
+		/** @return Number of positions given out by claim(). */
+		uint64_t
+		getChunkSize()
+		    const;
+
+		~WorkQueue();
+
+		/** Suppress copying mapping ownership. */
+		WorkQueue(const WorkQueue&) = delete;
+		/** Suppress copying mapping ownership. */
+		WorkQueue& operator=(const WorkQueue&) = delete;
+
+	private:
+		/** Number of positions in the list of work. */
+		const uint64_t size;
+		/** Number of positions given out by claim(). */
+		const uint64_t chunkSize;
+		/** Next unclaimed position, within the shared mapping. */
+		std::atomic<uint64_t> *cursor{nullptr};
+	};
+
 	/**
 	 * @brief
 	 * Create multiple smaller sets from a large set.
@@ -505,7 +1417,7 @@ namespace FRIF::Util
 	 */
 	void
 	writeFile(
-	    const std::vector<std::byte> &data,
+	    std::span<const std::byte> data,
 	    const std::string &pathName);
 }
 
@@ -0,0 +1,107 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <frifte/frifte.h>
+
+namespace
+{
+	/** Number of keys in each map. */
+	const std::size_t NumKeys{1'000'000};
+	/** Number of times every key is looked up. */
+	const unsigned int NumPasses{3};
+
+	/** Hash of a string built from the key, as before hashCombine(). */
+	struct ConcatenatingKeyHash
+	{
+		std::size_t
+		operator()(
+		    const FRIF::SubjectPositionCandidate &c)
+		    const
+		    noexcept
+		{
+			return (std::hash<std::string>{}(c.identifier + ' ' +
+			    std::to_string(std::underlying_type_t<
+			    FRIF::EFS::FrictionRidgeGeneralizedPosition>(
+			    c.fgp))));
+		}
+	};
+
+	/**
+	 * @brief
+	 * Look up every key of a map.
+	 *
+	 * @param keys
+	 * Keys in the map.
+	 *
+	 * @return
+	 * Lookups per second.
+	 */
+	template<typename Hash>
+	double
+	measure(
+	    const std::vector<FRIF::SubjectPositionCandidate> &keys)
+	{
+		std::unordered_map<FRIF::SubjectPositionCandidate, double,
+		    Hash> map{};
+		map.reserve(keys.size());
+		for (const auto &key : keys)
+			map.emplace(key, 0);
+
+		std::size_t found{};
+		const auto start = std::chrono::steady_clock::now();
+		for (unsigned int pass{0}; pass < NumPasses; ++pass)
+			for (const auto &key : keys)
+				found += map.count(key);
+		const auto stop = std::chrono::steady_clock::now();
+
+		if (found != keys.size() * NumPasses)
+			throw std::runtime_error{"Lookup failed"};
+
+		return (static_cast<double>(found) /
+		    std::chrono::duration<double>(stop - start).count());
+	}
+}
+
+int
+main()
+{
+	static const std::vector<FRIF::EFS::FrictionRidgeGeneralizedPosition>
+	    positions{
+	    FRIF::EFS::FrictionRidgeGeneralizedPosition::RightThumb,
+	    FRIF::EFS::FrictionRidgeGeneralizedPosition::RightIndex,
+	    FRIF::EFS::FrictionRidgeGeneralizedPosition::LeftThumb,
+	    FRIF::EFS::FrictionRidgeGeneralizedPosition::LeftIndex};
+
+	std::vector<FRIF::SubjectPositionCandidate> keys{};
+	keys.reserve(NumKeys);
+	for (std::size_t i{0}; i < NumKeys; ++i)
+		keys.emplace_back("subject-" + std::to_string(i /
+		    positions.size()), positions[i % positions.size()]);
+
+	try {
+		std::cout << "Concatenated string: " <<
+		    measure<ConcatenatingKeyHash>(keys) << " lookups/s\n";
+		std::cout << "Util::hashCombine(): " <<
+		    measure<FRIF::SubjectPositionCandidateListKeyHash>(keys) <<
+		    " lookups/s\n";
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << '\n';
+		return (EXIT_FAILURE);
+	}
+
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,187 @@
+/*
+ * This software was developed at the National Institute of Standards and
+ * Technology (NIST) by employees of the Federal Government in the course
+ * of their official duties. Pursuant to title 17 Section 105 of the
+ * United States Code, this software is not subject to copyright protection
+ * and is in the public domain. NIST assumes no responsibility whatsoever for
+ * its use by other parties, and makes no guarantees, expressed or implied,
+ * about its quality, reliability, or any other characteristic.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <frifte/frifte.h>
+#include <frifte/util.h>
+
+namespace
+{
+	/** Number of log rows built in each repetition. */
+	const unsigned int NumRows{200};
+	/** Number of times all rows are built. */
+	const unsigned int NumRepetitions{20};
+
+	/** A log row: identifier, duration, and minutiae. */
+	struct Row
+	{
+		std::string identifier{};
+		std::string duration{};
+		std::vector<FRIF::EFS::Minutia> minutiae{};
+	};
+
+	/**
+	 * @brief
+	 * Splice minutiae by concatenating temporary strings, as before
+	 * LogBuffer.
+	 *
+	 * @param v
+	 * Minutiae to splice.
+	 *
+	 * @return
+	 * Spliced minutiae.
+	 */
+	std::string
+	concatenatingSplice(
+	    const std::vector<FRIF::EFS::Minutia> &v)
+	{
+		using namespace FRIF::Util;
+		const std::string elementSep{";"}, itemSep{"|"};
+
+		std::string ret{};
+		for (const auto &m : v)
+			ret += ts(m.coordinate.x) + elementSep +
+			    ts(m.coordinate.y) + elementSep +
+			    (m.coordinateUncertainty ?
+			    ts(*m.coordinateUncertainty) : NA) + elementSep +
+			    ts(m.theta) + elementSep +
+			    (m.thetaUncertainty ? ts(*m.thetaUncertainty) :
+			    NA) + elementSep + e2i2s(m.type) + itemSep;
+		ret.erase(ret.find_last_of(itemSep), itemSep.length());
+		return (ret);
+	}
+
+	/**
+	 * @brief
+	 * Build a row by concatenating temporary strings.
+	 *
+	 * @param row
+	 * Row to format.
+	 *
+	 * @return
+	 * Log line for `row`.
+	 */
+	std::string
+	makeConcatenatedLine(
+	    const Row &row)
+	{
+		return ('"' + row.identifier + "\"," + row.duration + ',' +
+		    FRIF::Util::ts(row.minutiae.size()) + ",\"" +
+		    concatenatingSplice(row.minutiae) + "\"\n");
+	}
+
+	/**
+	 * @brief
+	 * Build a row in a reused LogBuffer.
+	 *
+	 * @param row
+	 * Row to format.
+	 *
+	 * @return
+	 * Log line for `row`, valid until the next call.
+	 */
+	std::string_view
+	makeLogBufferLine(
+	    const Row &row)
+	{
+		thread_local FRIF::Util::LogBuffer logLine{};
+		logLine.clear();
+
+		logLine << '"' << row.identifier << "\"," << row.duration <<
+		    ',' << row.minutiae.size() << ",\"";
+		FRIF::Util::splice(logLine, row.minutiae);
+		logLine << "\"\n";
+
+		return (logLine.view());
+	}
+
+	/**
+	 * @brief
+	 * Time building every row NumRepetitions times.
+	 *
+	 * @param rows
+	 * Rows to format.
+	 * @param makeLine
+	 * Function building one row.
+	 *
+	 * @return
+	 * Milliseconds elapsed.
+	 */
+	template<typename MakeLine>
+	double
+	measure(
+	    const std::vector<Row> &rows,
+	    MakeLine makeLine)
+	{
+		std::size_t bytes{};
+		const auto start = std::chrono::steady_clock::now();
+		for (unsigned int i{0}; i < NumRepetitions; ++i)
+			for (const auto &row : rows)
+				bytes += std::string_view{makeLine(row)}.size();
+		const auto stop = std::chrono::steady_clock::now();
+
+		if (bytes == 0)
+			throw std::runtime_error{"No lines built"};
+
+		return (std::chrono::duration<double, std::milli>(
+		    stop - start).count());
+	}
+}
+
+int
+main()
+{
+	std::mt19937 rng{};
+	std::uniform_int_distribution<std::size_t> numMinutiae{100, 160};
+	std::uniform_int_distribution<uint32_t> coordinate{0, 1000};
+	std::uniform_int_distribution<uint16_t> theta{0, 359};
+	std::uniform_int_distribution<uint16_t> uncertainty{0, 20};
+
+	std::vector<Row> rows(NumRows);
+	for (unsigned int i{0}; i < NumRows; ++i) {
+		rows[i].identifier = "probe-" + std::to_string(i);
+		rows[i].duration = std::to_string(100 + i);
+		rows[i].minutiae.resize(numMinutiae(rng));
+		for (auto &m : rows[i].minutiae) {
+			m.coordinate = {coordinate(rng), coordinate(rng)};
+			m.theta = theta(rng);
+			m.type = FRIF::EFS::MinutiaType::Bifurcation;
+			if (i % 2 == 0) {
+				m.coordinateUncertainty = uncertainty(rng);
+				m.thetaUncertainty = static_cast<uint8_t>(
+				    uncertainty(rng));
+			}
+		}
+	}
+
+	try {
+		for (const auto &row : rows)
+			if (makeConcatenatedLine(row) != makeLogBufferLine(row))
+				throw std::runtime_error{"Output differs for " +
+				    row.identifier};
+
+		std::cout << "Concatenated strings: " <<
+		    measure(rows, makeConcatenatedLine) << " ms\n";
+		std::cout << "Util::LogBuffer: " <<
+		    measure(rows, makeLogBufferLine) << " ms\n";
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << '\n';
+		return (EXIT_FAILURE);
+	}
+
+	return (EXIT_SUCCESS);
+}
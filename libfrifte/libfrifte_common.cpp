@@ -8,7 +8,24 @@
  * about its quality, reliability, or any other characteristic.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <exception>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define FRIF_PIXEL_KERNELS_X86
+#include <immintrin.h>
+#endif
 
 #include <frifte/common.h>
 
@@ -92,6 +109,61 @@ FRIF::Image::Image(
 
 }
 
+FRIF::Image::Image(
+    const uint8_t identifier_,
+    const uint16_t width_,
+    const uint16_t height_,
+    const uint16_t ppi_,
+    const Colorspace colorspace_,
+    const BitsPerChannel bpc_,
+    const BitsPerPixel bpp_,
+    std::vector<std::byte> &&pixels_) :
+    identifier{identifier_},
+    width{width_},
+    height{height_},
+    ppi{ppi_},
+    colorspace{colorspace_},
+    bpc{bpc_},
+    bpp{bpp_},
+    pixels{std::move(pixels_)}
+{
+
+}
+
+FRIF::Image::Image(
+    const uint8_t identifier_,
+    const uint16_t width_,
+    const uint16_t height_,
+    const uint16_t ppi_,
+    const Colorspace colorspace_,
+    const BitsPerChannel bpc_,
+    const BitsPerPixel bpp_,
+    std::span<const std::byte> pixels_,
+    std::shared_ptr<const void> owner) :
+    identifier{identifier_},
+    width{width_},
+    height{height_},
+    ppi{ppi_},
+    colorspace{colorspace_},
+    bpc{bpc_},
+    bpp{bpp_},
+    sharedPixels{pixels_},
+    sharedPixelsOwner{std::move(owner)}
+{
+	if (this->sharedPixelsOwner == nullptr)
+		throw std::invalid_argument{"Shared pixels have no owner"};
+}
+
+std::span<const std::byte>
+FRIF::Image::getPixels()
+    const
+    noexcept
+{
+	if (this->sharedPixelsOwner != nullptr)
+		return (this->sharedPixels);
+	return (this->pixels);
+}
+
 FRIF::Image::BitsPerPixel
 FRIF::Image::toBitsPerPixel(
     const std::underlying_type_t<BitsPerPixel> i)
@@ -134,7 +206,8 @@ FRIF::Image::sanityCheck()
 		throw std::logic_error{"Unexpected dimensions (" +
 		    imagePropertiesString(*this) + ')'};
 
-	decltype(pixels.size()) expected{};
+	const auto actual = this->getPixels().size();
+	std::size_t expected{};
 	switch (colorspace) {
 	case Colorspace::Grayscale:
 		switch (bpc) {
@@ -154,11 +227,11 @@ FRIF::Image::sanityCheck()
 			}
 
 			expected = width * height * 2ul;
-			if (pixels.size() != expected)
+			if (actual != expected)
 				throw std::logic_error{"Unexpected pixel "
 				    "length (expected = " +
 				    std::to_string(expected) +", actual = " +
-				    std::to_string(pixels.size()) + ')'};
+				    std::to_string(actual) + ')'};
 
 			return;
 		case BitsPerChannel::Eight:
@@ -177,11 +250,11 @@ FRIF::Image::sanityCheck()
 			}
 
 			expected = width * height;
-			if (pixels.size() != expected)
+			if (actual != expected)
 				throw std::logic_error{"Unexpected pixel "
 				    "length (expected = " +
 				    std::to_string(expected) +", actual = " +
-				    std::to_string(this->pixels.size()) + ')'};
+				    std::to_string(actual) + ')'};
 
 			return;
 		}
@@ -205,11 +278,11 @@ FRIF::Image::sanityCheck()
 			}
 
 			expected = width * height * (3ul * 2ul);
-			if (pixels.size() != expected)
+			if (actual != expected)
 				throw std::logic_error{"Unexpected pixel "
 				    "length (expected = " +
 				    std::to_string(expected) +", actual = " +
-				    std::to_string(this->pixels.size()) + ')'};
+				    std::to_string(actual) + ')'};
 
 			return;
 		case BitsPerChannel::Eight:
@@ -228,11 +301,11 @@ FRIF::Image::sanityCheck()
 			}
 
 			expected = width * height * 3ul;
-			if (pixels.size() != expected)
+			if (actual != expected)
 				throw std::logic_error{"Unexpected pixel "
 				    "length (expected = " +
 				    std::to_string(expected) +", actual = " +
-				    std::to_string(this->pixels.size()) + ')'};
+				    std::to_string(actual) + ')'};
 
 			return;
 		}
@@ -242,3 +315,859 @@ FRIF::Image::sanityCheck()
 	throw std::logic_error{"Untested "
 	    "combination (" + imagePropertiesString(*this) + ')'};
 }
+
+/*
+ * Pixel conversion kernels. Each has a scalar version and, on x86, SSE and
+ * AVX2 versions chosen at runtime that produce identical output. Sixteen-bit
+ * values are big-endian, as in Image::pixels.
+ */
+
+/** Signature of a pixel kernel converting `count` output values. */
+using PixelKernel = void (*)(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count);
+
+/** Signature of a kernel adding `weight` * `row` to `count` sums. */
+using RowAccumulator = void (*)(
+    float *sums,
+    const float *row,
+    const float weight,
+    const std::size_t count);
+
+/** Kernels chosen for the CPU running this process. */
+struct PixelKernels
+{
+	/** 16-bit to 8-bit channel values, rounding. */
+	PixelKernel scaleSixteenToEight{};
+	/** 24-bit RGB to 8-bit grayscale. */
+	PixelKernel rgb24ToGray8{};
+	/** 48-bit RGB to 16-bit grayscale. */
+	PixelKernel rgb48ToGray16{};
+	/** Invert every bit (`count` is in bytes). */
+	PixelKernel invert{};
+	/** Weighted sum of rows, for resampling. */
+	RowAccumulator accumulateRow{};
+};
+
+/*
+ * round(v / 257) == ((((v * 0xFF01) >> 16) + 128) >> 8) for every 16-bit v,
+ * which needs no more than 16 bits at each step.
+ */
+static constexpr uint32_t ScaleMultiplier{0xFF01};
+
+/*
+ * BT.601 luma weights (0.299, 0.587, 0.114) scaled to 128 for 8-bit
+ * channels, where pairs of weighted channels must fit in int16_t...
+ */
+static constexpr uint8_t Luma8Red{38}, Luma8Green{75}, Luma8Blue{15};
+/* ...and scaled to 32768 for 16-bit channels, where weights are int16_t. */
+static constexpr int16_t Luma16Red{9798}, Luma16Green{19235},
+    Luma16Blue{3735};
+
+static uint32_t
+readBE16(
+    const std::byte *in)
+{
+	return ((std::to_integer<uint32_t>(in[0]) << 8) |
+	    std::to_integer<uint32_t>(in[1]));
+}
+
+static void
+scaleSixteenToEightScalar(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	for (std::size_t i{0}; i < count; ++i)
+		out[i] = static_cast<std::byte>(((((readBE16(in + (2 * i)) *
+		    ScaleMultiplier) >> 16) + 128) >> 8));
+}
+
+static void
+rgb24ToGray8Scalar(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	for (std::size_t i{0}; i < count; ++i) {
+		const auto *px = in + (3 * i);
+		out[i] = static_cast<std::byte>(((Luma8Red *
+		    std::to_integer<uint32_t>(px[0])) + (Luma8Green *
+		    std::to_integer<uint32_t>(px[1])) + (Luma8Blue *
+		    std::to_integer<uint32_t>(px[2])) + 64) >> 7);
+	}
+}
+
+static void
+rgb48ToGray16Scalar(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	for (std::size_t i{0}; i < count; ++i) {
+		const auto *px = in + (6 * i);
+		const uint32_t y{((static_cast<uint32_t>(Luma16Red) *
+		    readBE16(px)) + (static_cast<uint32_t>(Luma16Green) *
+		    readBE16(px + 2)) + (static_cast<uint32_t>(Luma16Blue) *
+		    readBE16(px + 4)) + 16384) >> 15};
+		out[2 * i] = static_cast<std::byte>(y >> 8);
+		out[(2 * i) + 1] = static_cast<std::byte>(y & 0xFF);
+	}
+}
+
+static void
+invertScalar(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	for (std::size_t i{0}; i < count; ++i)
+		out[i] = ~in[i];
+}
+
+static void
+accumulateRowScalar(
+    float *sums,
+    const float *row,
+    const float weight,
+    const std::size_t count)
+{
+	for (std::size_t i{0}; i < count; ++i)
+		sums[i] += weight * row[i];
+}
+
+#ifdef FRIF_PIXEL_KERNELS_X86
+
+/** Unaligned 128-bit load. */
+__attribute__((target("sse2")))
+static __m128i
+load128(
+    const std::byte *p)
+{
+	return (_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+/** Unaligned 128-bit store. */
+__attribute__((target("sse2")))
+static void
+store128(
+    std::byte *p,
+    const __m128i v)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+/** Unaligned loads of two 128-bit values into one 256-bit value. */
+__attribute__((target("avx2")))
+static __m256i
+load128x2(
+    const std::byte *lo,
+    const std::byte *hi)
+{
+	return (_mm256_inserti128_si256(_mm256_castsi128_si256(load128(lo)),
+	    load128(hi), 1));
+}
+
+__attribute__((target("sse4.1")))
+static __m128i
+scaleSixteenToEightSSE(
+    const __m128i be)
+{
+	const __m128i swap{_mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10,
+	    13, 12, 15, 14)};
+	const __m128i v{_mm_mulhi_epu16(_mm_shuffle_epi8(be, swap),
+	    _mm_set1_epi16(static_cast<int16_t>(ScaleMultiplier)))};
+	return (_mm_srli_epi16(_mm_add_epi16(v, _mm_set1_epi16(128)), 8));
+}
+
+__attribute__((target("sse4.1")))
+static void
+scaleSixteenToEightSSE(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	std::size_t i{0};
+	for (; (i + 16) <= count; i += 16)
+		store128(out + i, _mm_packus_epi16(
+		    scaleSixteenToEightSSE(load128(in + (2 * i))),
+		    scaleSixteenToEightSSE(load128(in + (2 * i) + 16))));
+	scaleSixteenToEightScalar(in + (2 * i), out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static __m256i
+scaleSixteenToEightAVX2(
+    const __m256i be)
+{
+	const __m256i swap{_mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11,
+	    10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12,
+	    15, 14)};
+	const __m256i v{_mm256_mulhi_epu16(_mm256_shuffle_epi8(be, swap),
+	    _mm256_set1_epi16(static_cast<int16_t>(ScaleMultiplier)))};
+	return (_mm256_srli_epi16(_mm256_add_epi16(v,
+	    _mm256_set1_epi16(128)), 8));
+}
+
+__attribute__((target("avx2")))
+static void
+scaleSixteenToEightAVX2(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	std::size_t i{0};
+	for (; (i + 32) <= count; i += 32) {
+		const __m256i a{scaleSixteenToEightAVX2(_mm256_loadu_si256(
+		    reinterpret_cast<const __m256i*>(in + (2 * i))))};
+		const __m256i b{scaleSixteenToEightAVX2(_mm256_loadu_si256(
+		    reinterpret_cast<const __m256i*>(in + (2 * i) + 32)))};
+		/* packus works within 128-bit lanes; restore order */
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+		    _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b),
+		    _MM_SHUFFLE(3, 1, 2, 0)));
+	}
+	scaleSixteenToEightScalar(in + (2 * i), out + i, count - i);
+}
+
+/*
+ * RGB24 kernels expand four pixels (12 bytes, read with a 16-byte load) to
+ * [R G B 0] groups, weight them with maddubs, and sum pairs with hadd.
+ */
+
+__attribute__((target("sse4.1")))
+static __m128i
+weighRGB24SSE(
+    const std::byte *in)
+{
+	const __m128i expand{_mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8,
+	    -1, 9, 10, 11, -1)};
+	const __m128i weights{_mm_setr_epi8(Luma8Red, Luma8Green, Luma8Blue,
+	    0, Luma8Red, Luma8Green, Luma8Blue, 0, Luma8Red, Luma8Green,
+	    Luma8Blue, 0, Luma8Red, Luma8Green, Luma8Blue, 0)};
+	return (_mm_maddubs_epi16(_mm_shuffle_epi8(load128(in), expand),
+	    weights));
+}
+
+__attribute__((target("sse4.1")))
+static __m128i
+roundLuma8SSE(
+    const __m128i sum)
+{
+	return (_mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(64)), 7));
+}
+
+__attribute__((target("sse4.1")))
+static void
+rgb24ToGray8SSE(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	/* Last load of 16 pixels reads 16 bytes from byte 36 */
+	std::size_t i{0};
+	for (; (3 * (count - i)) >= 52; i += 16) {
+		const auto *px = in + (3 * i);
+		const __m128i lo{roundLuma8SSE(_mm_hadd_epi16(
+		    weighRGB24SSE(px), weighRGB24SSE(px + 12)))};
+		const __m128i hi{roundLuma8SSE(_mm_hadd_epi16(
+		    weighRGB24SSE(px + 24), weighRGB24SSE(px + 36)))};
+		store128(out + i, _mm_packus_epi16(lo, hi));
+	}
+	rgb24ToGray8Scalar(in + (3 * i), out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static __m256i
+weighRGB24AVX2(
+    const std::byte *lo,
+    const std::byte *hi)
+{
+	const __m256i expand{_mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7,
+	    8, -1, 9, 10, 11, -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9,
+	    10, 11, -1)};
+	const __m256i weights{_mm256_setr_epi8(Luma8Red, Luma8Green,
+	    Luma8Blue, 0, Luma8Red, Luma8Green, Luma8Blue, 0, Luma8Red,
+	    Luma8Green, Luma8Blue, 0, Luma8Red, Luma8Green, Luma8Blue, 0,
+	    Luma8Red, Luma8Green, Luma8Blue, 0, Luma8Red, Luma8Green,
+	    Luma8Blue, 0, Luma8Red, Luma8Green, Luma8Blue, 0, Luma8Red,
+	    Luma8Green, Luma8Blue, 0)};
+	return (_mm256_maddubs_epi16(_mm256_shuffle_epi8(load128x2(lo, hi),
+	    expand), weights));
+}
+
+__attribute__((target("avx2")))
+static __m256i
+roundLuma8AVX2(
+    const __m256i sum)
+{
+	return (_mm256_srli_epi16(_mm256_add_epi16(sum,
+	    _mm256_set1_epi16(64)), 7));
+}
+
+__attribute__((target("avx2")))
+static void
+rgb24ToGray8AVX2(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	/* Last load of 32 pixels reads 16 bytes from byte 84 */
+	std::size_t i{0};
+	for (; (3 * (count - i)) >= 100; i += 32) {
+		const auto *px = in + (3 * i);
+		/* Lane 0 holds pixels 0-15 and lane 1 holds 16-31 */
+		const __m256i a{roundLuma8AVX2(_mm256_hadd_epi16(
+		    weighRGB24AVX2(px, px + 48),
+		    weighRGB24AVX2(px + 12, px + 60)))};
+		const __m256i b{roundLuma8AVX2(_mm256_hadd_epi16(
+		    weighRGB24AVX2(px + 24, px + 72),
+		    weighRGB24AVX2(px + 36, px + 84)))};
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+		    _mm256_packus_epi16(a, b));
+	}
+	rgb24ToGray8Scalar(in + (3 * i), out + i, count - i);
+}
+
+/*
+ * RGB48 kernels expand two pixels (12 bytes, read with a 16-byte load) to
+ * little-endian [R G B 0] groups, bias them to int16_t, weight them with
+ * madd, and sum pairs with hadd. Removing the bias adds
+ * 32768 * (sum of weights) == 1 << 30.
+ */
+static constexpr int32_t RGB48Offset{(1 << 30) + 16384};
+
+__attribute__((target("sse4.1")))
+static __m128i
+weighRGB48SSE(
+    const std::byte *in)
+{
+	const __m128i expand{_mm_setr_epi8(1, 0, 3, 2, 5, 4, -1, -1, 7, 6, 9,
+	    8, 11, 10, -1, -1)};
+	const __m128i weights{_mm_setr_epi16(Luma16Red, Luma16Green,
+	    Luma16Blue, 0, Luma16Red, Luma16Green, Luma16Blue, 0)};
+	const __m128i biased{_mm_xor_si128(_mm_shuffle_epi8(load128(in),
+	    expand), _mm_set1_epi16(std::numeric_limits<int16_t>::min()))};
+	return (_mm_madd_epi16(biased, weights));
+}
+
+__attribute__((target("sse4.1")))
+static __m128i
+roundLuma16SSE(
+    const __m128i sum)
+{
+	return (_mm_srli_epi32(_mm_add_epi32(sum,
+	    _mm_set1_epi32(RGB48Offset)), 15));
+}
+
+__attribute__((target("sse4.1")))
+static void
+rgb48ToGray16SSE(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	const __m128i swap{_mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10,
+	    13, 12, 15, 14)};
+
+	/* Last load of 8 pixels reads 16 bytes from byte 36 */
+	std::size_t i{0};
+	for (; (6 * (count - i)) >= 52; i += 8) {
+		const auto *px = in + (6 * i);
+		const __m128i lo{roundLuma16SSE(_mm_hadd_epi32(
+		    weighRGB48SSE(px), weighRGB48SSE(px + 12)))};
+		const __m128i hi{roundLuma16SSE(_mm_hadd_epi32(
+		    weighRGB48SSE(px + 24), weighRGB48SSE(px + 36)))};
+		store128(out + (2 * i), _mm_shuffle_epi8(
+		    _mm_packus_epi32(lo, hi), swap));
+	}
+	rgb48ToGray16Scalar(in + (6 * i), out + (2 * i), count - i);
+}
+
+__attribute__((target("avx2")))
+static __m256i
+weighRGB48AVX2(
+    const std::byte *lo,
+    const std::byte *hi)
+{
+	const __m256i expand{_mm256_setr_epi8(1, 0, 3, 2, 5, 4, -1, -1, 7, 6,
+	    9, 8, 11, 10, -1, -1, 1, 0, 3, 2, 5, 4, -1, -1, 7, 6, 9, 8, 11,
+	    10, -1, -1)};
+	const __m256i weights{_mm256_setr_epi16(Luma16Red, Luma16Green,
+	    Luma16Blue, 0, Luma16Red, Luma16Green, Luma16Blue, 0, Luma16Red,
+	    Luma16Green, Luma16Blue, 0, Luma16Red, Luma16Green, Luma16Blue,
+	    0)};
+	const __m256i biased{_mm256_xor_si256(_mm256_shuffle_epi8(
+	    load128x2(lo, hi), expand), _mm256_set1_epi16(
+	    std::numeric_limits<int16_t>::min()))};
+	return (_mm256_madd_epi16(biased, weights));
+}
+
+__attribute__((target("avx2")))
+static __m256i
+roundLuma16AVX2(
+    const __m256i sum)
+{
+	return (_mm256_srli_epi32(_mm256_add_epi32(sum,
+	    _mm256_set1_epi32(RGB48Offset)), 15));
+}
+
+__attribute__((target("avx2")))
+static void
+rgb48ToGray16AVX2(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	const __m256i swap{_mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11,
+	    10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12,
+	    15, 14)};
+
+	/* Last load of 16 pixels reads 16 bytes from byte 84 */
+	std::size_t i{0};
+	for (; (6 * (count - i)) >= 100; i += 16) {
+		const auto *px = in + (6 * i);
+		/* Lane 0 holds pixels 0-7 and lane 1 holds 8-15 */
+		const __m256i a{roundLuma16AVX2(_mm256_hadd_epi32(
+		    weighRGB48AVX2(px, px + 48),
+		    weighRGB48AVX2(px + 12, px + 60)))};
+		const __m256i b{roundLuma16AVX2(_mm256_hadd_epi32(
+		    weighRGB48AVX2(px + 24, px + 72),
+		    weighRGB48AVX2(px + 36, px + 84)))};
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + (2 * i)),
+		    _mm256_shuffle_epi8(_mm256_packus_epi32(a, b), swap));
+	}
+	rgb48ToGray16Scalar(in + (6 * i), out + (2 * i), count - i);
+}
+
+__attribute__((target("sse2")))
+static void
+invertSSE(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	const __m128i ones{_mm_set1_epi8(-1)};
+
+	std::size_t i{0};
+	for (; (i + 16) <= count; i += 16)
+		store128(out + i, _mm_xor_si128(load128(in + i), ones));
+	invertScalar(in + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void
+invertAVX2(
+    const std::byte *in,
+    std::byte *out,
+    const std::size_t count)
+{
+	const __m256i ones{_mm256_set1_epi8(-1)};
+
+	std::size_t i{0};
+	for (; (i + 32) <= count; i += 32)
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+		    _mm256_xor_si256(_mm256_loadu_si256(
+		    reinterpret_cast<const __m256i*>(in + i)), ones));
+	invertScalar(in + i, out + i, count - i);
+}
+
+/*
+ * Multiplying and adding separately, rather than with FMA, rounds the same
+ * as accumulateRowScalar().
+ */
+__attribute__((target("sse2")))
+static void
+accumulateRowSSE(
+    float *sums,
+    const float *row,
+    const float weight,
+    const std::size_t count)
+{
+	const __m128 w{_mm_set1_ps(weight)};
+
+	std::size_t i{0};
+	for (; (i + 4) <= count; i += 4)
+		_mm_storeu_ps(sums + i, _mm_add_ps(_mm_loadu_ps(sums + i),
+		    _mm_mul_ps(w, _mm_loadu_ps(row + i))));
+	accumulateRowScalar(sums + i, row + i, weight, count - i);
+}
+
+__attribute__((target("avx2")))
+static void
+accumulateRowAVX2(
+    float *sums,
+    const float *row,
+    const float weight,
+    const std::size_t count)
+{
+	const __m256 w{_mm256_set1_ps(weight)};
+
+	std::size_t i{0};
+	for (; (i + 8) <= count; i += 8)
+		_mm256_storeu_ps(sums + i, _mm256_add_ps(
+		    _mm256_loadu_ps(sums + i),
+		    _mm256_mul_ps(w, _mm256_loadu_ps(row + i))));
+	accumulateRowScalar(sums + i, row + i, weight, count - i);
+}
+
+#endif /* FRIF_PIXEL_KERNELS_X86 */
+
+/** @return Fastest kernels supported by the running CPU. */
+static const PixelKernels&
+getPixelKernels()
+{
+	static const PixelKernels kernels = []() -> PixelKernels {
+#ifdef FRIF_PIXEL_KERNELS_X86
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			return {scaleSixteenToEightAVX2, rgb24ToGray8AVX2,
+			    rgb48ToGray16AVX2, invertAVX2, accumulateRowAVX2};
+		if (__builtin_cpu_supports("sse4.1"))
+			return {scaleSixteenToEightSSE, rgb24ToGray8SSE,
+			    rgb48ToGray16SSE, invertSSE, accumulateRowSSE};
+#endif /* FRIF_PIXEL_KERNELS_X86 */
+		return {scaleSixteenToEightScalar, rgb24ToGray8Scalar,
+		    rgb48ToGray16Scalar, invertScalar, accumulateRowScalar};
+	}();
+
+	return (kernels);
+}
+
+/** @return BitsPerPixel of an Image with `colorspace` and `bpc`. */
+static FRIF::Image::BitsPerPixel
+getBitsPerPixel(
+    const FRIF::Image::Colorspace colorspace,
+    const FRIF::Image::BitsPerChannel bpc)
+{
+	using FRIF::Image;
+
+	switch (colorspace) {
+	case Image::Colorspace::Grayscale:
+		return (bpc == Image::BitsPerChannel::Eight ?
+		    Image::BitsPerPixel::Eight : Image::BitsPerPixel::Sixteen);
+	case Image::Colorspace::RGB:
+		return (bpc == Image::BitsPerChannel::Eight ?
+		    Image::BitsPerPixel::TwentyFour :
+		    Image::BitsPerPixel::FortyEight);
+	}
+
+	throw std::logic_error{"Unknown colorspace"};
+}
+
+FRIF::Image
+FRIF::Image::convert(
+    const Colorspace colorspace_,
+    const BitsPerChannel bpc_)
+    const
+{
+	this->sanityCheck();
+	if ((this->colorspace == Colorspace::Grayscale) &&
+	    (colorspace_ == Colorspace::RGB))
+		throw std::invalid_argument{"Cannot convert grayscale to RGB"};
+	if ((this->bpc == BitsPerChannel::Eight) &&
+	    (bpc_ == BitsPerChannel::Sixteen))
+		throw std::invalid_argument{"Cannot increase bits per channel"};
+	if ((this->colorspace == colorspace_) && (this->bpc == bpc_))
+		return (*this);
+
+	const auto &kernels = getPixelKernels();
+	const std::size_t numPixels{std::size_t{this->width} * this->height};
+
+	std::span<const std::byte> source{this->getPixels()};
+	std::vector<std::byte> converted{};
+	if (this->colorspace != colorspace_) {
+		if (this->bpc == BitsPerChannel::Eight) {
+			converted.resize(numPixels);
+			kernels.rgb24ToGray8(source.data(), converted.data(),
+			    numPixels);
+		} else {
+			converted.resize(numPixels * 2);
+			kernels.rgb48ToGray16(source.data(), converted.data(),
+			    numPixels);
+		}
+		source = converted;
+	}
+	if (this->bpc != bpc_) {
+		std::vector<std::byte> scaled(source.size() / 2);
+		kernels.scaleSixteenToEight(source.data(), scaled.data(),
+		    scaled.size());
+		converted = std::move(scaled);
+	}
+
+	return {this->identifier, this->width, this->height, this->ppi,
+	    colorspace_, bpc_, getBitsPerPixel(colorspace_, bpc_),
+	    std::move(converted)};
+}
+
+FRIF::Image
+FRIF::Image::invert()
+    const
+{
+	this->sanityCheck();
+
+	const auto source = this->getPixels();
+	std::vector<std::byte> inverted(source.size());
+	getPixelKernels().invert(source.data(), inverted.data(),
+	    inverted.size());
+
+	return {this->identifier, this->width, this->height, this->ppi,
+	    this->colorspace, this->bpc, this->bpp, std::move(inverted)};
+}
+
+/*
+ * Resampling. Weights along each axis are computed once. Rows are filtered
+ * horizontally into a float buffer, and each output row is a weighted sum of
+ * those filtered rows, computed with PixelKernels::accumulateRow.
+ */
+
+/** Number of lobes of the Lanczos kernel. */
+static constexpr double LanczosLobes{3};
+
+/** Input samples contributing to one output sample along one axis. */
+struct ResampleTaps
+{
+	/** Index of the first contributing input sample. */
+	std::size_t first{};
+	/** Normalized weight of each input sample, starting at #first. */
+	std::vector<float> weights{};
+};
+
+/** Immutable state shared by threads resampling one Image. */
+struct Resampler
+{
+	/** Input pixels. */
+	std::span<const std::byte> pixels{};
+	/** Number of channels in each pixel. */
+	std::size_t channels{};
+	/** Number of bytes in each channel value. */
+	std::size_t bytesPerChannel{};
+	/** Width of input, in pixels. */
+	std::size_t inWidth{};
+	/** Width of output, in pixels. */
+	std::size_t outWidth{};
+	/** Taps for each output column. */
+	std::vector<ResampleTaps> columns{};
+	/** Taps for each output row. */
+	std::vector<ResampleTaps> rows{};
+};
+
+/** @return Lanczos kernel evaluated at `x`. */
+static double
+lanczos(
+    const double x)
+{
+	const double ax{std::abs(x)};
+	if (ax < std::numeric_limits<double>::epsilon())
+		return (1);
+	if (ax >= LanczosLobes)
+		return (0);
+
+	const double px{std::numbers::pi * ax};
+	return ((LanczosLobes * std::sin(px) * std::sin(px / LanczosLobes)) /
+	    (px * px));
+}
+
+/** @return Taps for each of `outSize` samples of `inSize` samples. */
+static std::vector<ResampleTaps>
+makeResampleTaps(
+    const std::size_t inSize,
+    const std::size_t outSize)
+{
+	const double scale{static_cast<double>(inSize) /
+	    static_cast<double>(outSize)};
+	/* Widen the kernel when downsampling to suppress aliasing */
+	const double filterScale{std::max(scale, 1.0)};
+	const double support{LanczosLobes * filterScale};
+
+	std::vector<ResampleTaps> taps(outSize);
+	std::vector<double> weights{};
+	for (std::size_t o{0}; o < outSize; ++o) {
+		const double center{(static_cast<double>(o) + 0.5) * scale};
+		const auto first = static_cast<std::size_t>(
+		    std::max(0.0, std::floor(center - support)));
+		const auto last = std::min(inSize, static_cast<std::size_t>(
+		    std::ceil(center + support)));
+
+		weights.clear();
+		double sum{0};
+		for (std::size_t i{first}; i < last; ++i) {
+			weights.push_back(lanczos((static_cast<double>(i) +
+			    0.5 - center) / filterScale));
+			sum += weights.back();
+		}
+
+		taps[o].first = first;
+		taps[o].weights.reserve(weights.size());
+		for (const double w : weights)
+			taps[o].weights.push_back(static_cast<float>(w / sum));
+	}
+
+	return (taps);
+}
+
+/**
+ * @brief
+ * Resample one band of output rows.
+ *
+ * @param resampler
+ * State of the resampling.
+ * @param out
+ * Output pixels of the entire Image.
+ * @param firstRow
+ * First output row of the band.
+ * @param lastRow
+ * One past the last output row of the band.
+ */
+static void
+resampleBand(
+    const Resampler &resampler,
+    std::span<std::byte> out,
+    const std::size_t firstRow,
+    const std::size_t lastRow)
+{
+	const auto &r = resampler;
+	const std::size_t inRowLength{r.inWidth * r.channels};
+	const std::size_t outRowLength{r.outWidth * r.channels};
+	const float maxValue{r.bytesPerChannel == 1 ? 255.0f : 65535.0f};
+
+	/* Taps move forward with rows, so the first row's are lowest */
+	const std::size_t firstInput{r.rows[firstRow].first};
+	std::size_t lastInput{firstInput};
+	for (std::size_t y{firstRow}; y < lastRow; ++y)
+		lastInput = std::max(lastInput,
+		    r.rows[y].first + r.rows[y].weights.size());
+
+	/* Filter each contributing input row horizontally */
+	std::vector<float> decoded(inRowLength);
+	std::vector<float> filtered((lastInput - firstInput) * outRowLength);
+	for (std::size_t y{firstInput}; y < lastInput; ++y) {
+		const std::byte *src{r.pixels.data() +
+		    (y * inRowLength * r.bytesPerChannel)};
+		for (std::size_t i{0}; i < inRowLength; ++i)
+			decoded[i] = static_cast<float>(r.bytesPerChannel == 1 ?
+			    std::to_integer<uint32_t>(src[i]) :
+			    readBE16(src + (2 * i)));
+
+		float *dst{filtered.data() + ((y - firstInput) * outRowLength)};
+		for (std::size_t x{0}; x < r.outWidth; ++x) {
+			const auto &taps = r.columns[x];
+			for (std::size_t c{0}; c < r.channels; ++c) {
+				float sum{0};
+				for (std::size_t k{0}; k < taps.weights.size();
+				    ++k)
+					sum += taps.weights[k] * decoded[
+					    ((taps.first + k) * r.channels) + c];
+				dst[(x * r.channels) + c] = sum;
+			}
+		}
+	}
+
+	/* Sum filtered rows for each output row and quantize */
+	const auto accumulateRow = getPixelKernels().accumulateRow;
+	std::vector<float> sums(outRowLength);
+	for (std::size_t y{firstRow}; y < lastRow; ++y) {
+		const auto &taps = r.rows[y];
+		std::fill(sums.begin(), sums.end(), 0.0f);
+		for (std::size_t k{0}; k < taps.weights.size(); ++k)
+			accumulateRow(sums.data(), filtered.data() +
+			    ((taps.first + k - firstInput) * outRowLength),
+			    taps.weights[k], outRowLength);
+
+		std::byte *dst{out.data() +
+		    (y * outRowLength * r.bytesPerChannel)};
+		for (std::size_t i{0}; i < outRowLength; ++i) {
+			const auto v = static_cast<uint16_t>(std::lround(
+			    std::clamp(sums[i], 0.0f, maxValue)));
+			if (r.bytesPerChannel == 1) {
+				dst[i] = static_cast<std::byte>(v);
+			} else {
+				dst[2 * i] = static_cast<std::byte>(v >> 8);
+				dst[(2 * i) + 1] = static_cast<std::byte>(
+				    v & 0xFF);
+			}
+		}
+	}
+}
+
+FRIF::Image
+FRIF::Image::resample(
+    const uint16_t ppi_,
+    const ResampleOptions &options)
+    const
+{
+	this->sanityCheck();
+	if ((ppi_ == 0) || (this->ppi == 0))
+		throw std::invalid_argument{"Cannot resample to or from 0 PPI"};
+	if (options.numThreads == 0)
+		throw std::invalid_argument{"Cannot resample with 0 threads"};
+	if (ppi_ == this->ppi)
+		return (*this);
+
+	const auto scaleDimension = [&](const uint16_t size) -> uint16_t {
+		const double scaled{std::round((static_cast<double>(size) *
+		    ppi_) / this->ppi)};
+		if (scaled > std::numeric_limits<uint16_t>::max())
+			throw std::invalid_argument{"Resampled dimensions "
+			    "too large"};
+		return (static_cast<uint16_t>(std::max(scaled, 1.0)));
+	};
+	const uint16_t outWidth{scaleDimension(this->width)};
+	const uint16_t outHeight{scaleDimension(this->height)};
+
+	Resampler resampler{};
+	resampler.pixels = this->getPixels();
+	resampler.channels = (this->colorspace == Colorspace::RGB ? 3 : 1);
+	resampler.bytesPerChannel = (this->bpc == BitsPerChannel::Eight ?
+	    1 : 2);
+	resampler.inWidth = this->width;
+	resampler.outWidth = outWidth;
+	resampler.columns = makeResampleTaps(this->width, outWidth);
+	resampler.rows = makeResampleTaps(this->height, outHeight);
+
+	std::vector<std::byte> resampled(std::size_t{outWidth} * outHeight *
+	    resampler.channels * resampler.bytesPerChannel);
+
+	const std::size_t numRows{outHeight};
+	const std::size_t bandHeight{options.bandHeight != 0 ?
+	    options.bandHeight :
+	    (numRows + options.numThreads - 1) / options.numThreads};
+	const std::size_t numBands{(numRows + bandHeight - 1) / bandHeight};
+
+	/* Each thread takes the next band until none remain */
+	std::atomic<std::size_t> nextBand{0};
+	const std::size_t numThreads{std::min<std::size_t>(
+	    options.numThreads, numBands)};
+	std::vector<std::exception_ptr> errors(numThreads);
+	const auto work = [&](const std::size_t thread) {
+		try {
+			for (std::size_t band{nextBand++}; band < numBands;
+			    band = nextBand++)
+				resampleBand(resampler, resampled,
+				    band * bandHeight, std::min(numRows,
+				    (band + 1) * bandHeight));
+		} catch (...) {
+			errors[thread] = std::current_exception();
+		}
+	};
+
+	std::vector<std::thread> threads{};
+	for (std::size_t t{1}; t < numThreads; ++t) {
+		try {
+			threads.emplace_back(work, t);
+		} catch (const std::system_error&) {
+			/* Remaining bands are taken by running threads */
+			break;
+		}
+	}
+	work(0);
+	for (auto &thread : threads)
+		thread.join();
+	for (const auto &error : errors)
+		if (error)
+			std::rethrow_exception(error);
+
+	return {this->identifier, outWidth, outHeight, ppi_,
+	    this->colorspace, this->bpc, this->bpp, std::move(resampled)};
+}
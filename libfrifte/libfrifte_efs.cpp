@@ -8,7 +8,17 @@
  * about its quality, reliability, or any other characteristic.
  */
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+
 #include <frifte/efs.h>
+#include <frifte/util.h>
 
 FRIF::EFS::CorrespondenceRelationship::CorrespondenceRelationship(
     CorrespondenceType type_,
@@ -48,6 +58,88 @@ FRIF::EFS::Minutia::Minutia(
 
 }
 
+FRIF::EFS::MinutiaArrays::MinutiaArrays() = default;
+
+FRIF::EFS::MinutiaArrays::MinutiaArrays(
+    const std::vector<Minutia> &minutiae)
+{
+	this->x.reserve(minutiae.size());
+	this->y.reserve(minutiae.size());
+	this->theta.reserve(minutiae.size());
+	this->type.reserve(minutiae.size());
+	this->coordinateUncertainty.reserve(minutiae.size());
+	this->thetaUncertainty.reserve(minutiae.size());
+	this->coordinateUncertaintyMask.reserve((minutiae.size() + 63) / 64);
+	this->thetaUncertaintyMask.reserve((minutiae.size() + 63) / 64);
+
+	for (const auto &minutia : minutiae)
+		this->push_back(minutia);
+}
+
+void
+FRIF::EFS::MinutiaArrays::push_back(
+    const Minutia &minutia)
+{
+	const auto i = this->size();
+	if ((i % 64) == 0) {
+		this->coordinateUncertaintyMask.push_back(0);
+		this->thetaUncertaintyMask.push_back(0);
+	}
+	const uint64_t bit{uint64_t{1} << (i % 64)};
+
+	this->x.push_back(minutia.coordinate.x);
+	this->y.push_back(minutia.coordinate.y);
+	this->theta.push_back(minutia.theta);
+	this->type.push_back(minutia.type);
+
+	this->coordinateUncertainty.push_back(
+	    minutia.coordinateUncertainty.value_or(0));
+	if (minutia.coordinateUncertainty.has_value())
+		this->coordinateUncertaintyMask.back() |= bit;
+	this->thetaUncertainty.push_back(minutia.thetaUncertainty.value_or(0));
+	if (minutia.thetaUncertainty.has_value())
+		this->thetaUncertaintyMask.back() |= bit;
+}
+
+FRIF::EFS::Minutia
+FRIF::EFS::MinutiaArrays::at(
+    const std::size_t i)
+    const
+{
+	if (i >= this->size())
+		throw std::out_of_range{"Minutia " + std::to_string(i) +
+		    " requested from " + std::to_string(this->size())};
+
+	const uint64_t bit{uint64_t{1} << (i % 64)};
+	Minutia minutia{{this->x[i], this->y[i]}, this->theta[i],
+	    this->type[i]};
+	if (this->coordinateUncertaintyMask[i / 64] & bit)
+		minutia.coordinateUncertainty = this->coordinateUncertainty[i];
+	if (this->thetaUncertaintyMask[i / 64] & bit)
+		minutia.thetaUncertainty = this->thetaUncertainty[i];
+
+	return (minutia);
+}
+
+std::size_t
+FRIF::EFS::MinutiaArrays::size()
+    const
+{
+	return (this->x.size());
+}
+
+std::vector<FRIF::EFS::Minutia>
+FRIF::EFS::MinutiaArrays::toMinutiae()
+    const
+{
+	std::vector<Minutia> minutiae{};
+	minutiae.reserve(this->size());
+	for (std::size_t i{0}; i < this->size(); ++i)
+		minutiae.push_back(this->at(i));
+
+	return (minutiae);
+}
+
 FRIF::EFS::Core::Core(
     const Coordinate &coordinate_,
     const std::optional<uint16_t> &direction_,
@@ -794,37 +886,28 @@ FRIF::EFS::QualityMeasure::DescriptionHash::operator()(
     const FRIF::EFS::QualityMeasure::Description &d)
     const
 {
-	static const std::string fs = "\x1C";
-	static const std::string us = "\x1F";
-	static const std::string gs = "\x1D";
-
-	std::string id{};
+	std::size_t seed{};
+	Util::hashCombine(seed, d.identifier.has_value());
 	if (d.identifier.has_value()) {
-		id += d.identifier->marketing.value_or("") + us;
-
+		Util::hashCombine(seed, d.identifier->marketing);
+		Util::hashCombine(seed, d.identifier->cbeff.has_value());
 		if (d.identifier->cbeff.has_value()) {
-			id += std::to_string(d.identifier->cbeff->owner) + us;
-
-			if (d.identifier->cbeff->algorithm.has_value())
-				id += std::to_string(
-				    *d.identifier->cbeff->algorithm);
-		} else
-			id += us;
-	} else
-		id += us + us;
+			Util::hashCombine(seed, d.identifier->cbeff->owner);
+			Util::hashCombine(seed, d.identifier->cbeff->algorithm);
+		}
+	}
+	Util::hashCombine(seed, d.version);
+	Util::hashCombine(seed, d.comment);
+	Util::hashCombine(seed, d.modelSHA256);
 
-	return (std::hash<std::string>{}(
-	    id + gs +
-	    d.version.value_or("") + gs +
-	    d.comment.value_or("") + gs +
-	    d.modelSHA256.value_or("") + fs
-	));
+	return (seed);
 }
 
 FRIF::EFS::QualityMeasure::QualityMeasure() = default;
 
 FRIF::EFS::QualityMeasure::QualityMeasure(
     const double value_) :
+    status{Status::Success},
     value{value_}
 {
 
@@ -880,3 +963,1331 @@ FRIF::EFS::QualityMeasure::setMessage(
 {
 	this->message = message_;
 }
+
+FRIF::EFS::pmr::RidgeQualityRegion::RidgeQualityRegion(
+    const allocator_type &alloc) :
+    region{alloc}
+{
+
+}
+
+FRIF::EFS::pmr::RidgeQualityRegion::RidgeQualityRegion(
+    const RidgeQualityRegion &rqr,
+    const allocator_type &alloc) :
+    region{rqr.region, alloc},
+    quality{rqr.quality}
+{
+
+}
+
+FRIF::EFS::pmr::RidgeQualityRegion::RidgeQualityRegion(
+    RidgeQualityRegion &&rqr,
+    const allocator_type &alloc) :
+    region{std::move(rqr.region), alloc},
+    quality{rqr.quality}
+{
+
+}
+
+FRIF::EFS::pmr::RidgeQualityRegion::RidgeQualityRegion(
+    const EFS::RidgeQualityRegion &rqr,
+    const allocator_type &alloc) :
+    region{rqr.region.cbegin(), rqr.region.cend(), alloc},
+    quality{rqr.quality}
+{
+
+}
+
+FRIF::EFS::pmr::RidgeQualityRegion::allocator_type
+FRIF::EFS::pmr::RidgeQualityRegion::get_allocator()
+    const
+    noexcept
+{
+	return (this->region.get_allocator());
+}
+
+FRIF::EFS::RidgeQualityRegion
+FRIF::EFS::pmr::RidgeQualityRegion::toRidgeQualityRegion()
+    const
+{
+	EFS::RidgeQualityRegion rqr{};
+	rqr.region.assign(this->region.cbegin(), this->region.cend());
+	rqr.quality = this->quality;
+
+	return (rqr);
+}
+
+/**
+ * @brief
+ * Copy an optional sequence into a std::pmr::vector.
+ *
+ * @param source
+ * Sequence to copy.
+ * @param alloc
+ * Allocator for the copy and each of its elements.
+ *
+ * @return
+ * Copy of `source`, or std::nullopt if `source` is not set.
+ */
+template<typename T, typename Source>
+static std::optional<std::pmr::vector<T>>
+copyToPMR(
+    const std::optional<Source> &source,
+    const std::pmr::polymorphic_allocator<> &alloc)
+{
+	if (!source)
+		return (std::nullopt);
+	return (std::optional<std::pmr::vector<T>>{std::in_place,
+	    source->cbegin(), source->cend(), alloc});
+}
+
+/**
+ * @brief
+ * Copy every member of Features or pmr::Features into pmr::Features.
+ *
+ * @param destination
+ * Features whose members are overwritten.
+ * @param source
+ * Features to copy.
+ * @param alloc
+ * Allocator for all members of `destination`.
+ */
+template<typename Source>
+static void
+copyMembersToPMR(
+    FRIF::EFS::pmr::Features &destination,
+    const Source &source,
+    const std::pmr::polymorphic_allocator<> &alloc)
+{
+	using namespace FRIF::EFS;
+
+	destination.identifier = source.identifier;
+	destination.ppi = source.ppi;
+	destination.quality.reset();
+	if (source.quality)
+		destination.quality.emplace(source.quality->cbegin(),
+		    source.quality->cend(), source.quality->bucket_count(),
+		    alloc);
+	destination.imp = source.imp;
+	destination.frct = source.frct;
+	destination.frgp = source.frgp;
+	destination.orientation = source.orientation;
+	destination.lpm = copyToPMR<ProcessingMethod>(source.lpm, alloc);
+	destination.valueAssessment = source.valueAssessment;
+	destination.lsb = source.lsb;
+	destination.pat = source.pat;
+	destination.plr = source.plr;
+	destination.trv = source.trv;
+	destination.cores = copyToPMR<Core>(source.cores, alloc);
+	destination.deltas = copyToPMR<Delta>(source.deltas, alloc);
+	destination.minutiae = copyToPMR<Minutia>(source.minutiae, alloc);
+	destination.creases = copyToPMR<Crease>(source.creases, alloc);
+	destination.roi = copyToPMR<FRIF::Coordinate>(source.roi, alloc);
+	destination.rqm = copyToPMR<pmr::RidgeQualityRegion>(source.rqm,
+	    alloc);
+	destination.complex = source.complex;
+}
+
+FRIF::EFS::pmr::Features::Features(
+    const Features &features) :
+    Features(features, allocator_type{})
+{
+
+}
+
+FRIF::EFS::pmr::Features::Features(
+    const allocator_type &alloc_) :
+    alloc{alloc_}
+{
+
+}
+
+FRIF::EFS::pmr::Features::Features(
+    const Features &features,
+    const allocator_type &alloc_) :
+    alloc{alloc_}
+{
+	copyMembersToPMR(*this, features, this->alloc);
+}
+
+FRIF::EFS::pmr::Features::Features(
+    Features &&features,
+    const allocator_type &alloc_) :
+    alloc{alloc_}
+{
+	if (features.alloc == this->alloc)
+		this->assign(std::move(features));
+	else
+		copyMembersToPMR(*this, features, this->alloc);
+}
+
+FRIF::EFS::pmr::Features::Features(
+    const EFS::Features &features,
+    const allocator_type &alloc_) :
+    alloc{alloc_}
+{
+	copyMembersToPMR(*this, features, this->alloc);
+}
+
+FRIF::EFS::pmr::Features&
+FRIF::EFS::pmr::Features::operator=(
+    const Features &features)
+{
+	if (this != &features)
+		this->assign(Features(features, this->alloc));
+	return (*this);
+}
+
+FRIF::EFS::pmr::Features&
+FRIF::EFS::pmr::Features::operator=(
+    Features &&features)
+{
+	if (this != &features)
+		this->assign(Features(std::move(features), this->alloc));
+	return (*this);
+}
+
+FRIF::EFS::pmr::Features::allocator_type
+FRIF::EFS::pmr::Features::get_allocator()
+    const
+    noexcept
+{
+	return (this->alloc);
+}
+
+FRIF::EFS::Features
+FRIF::EFS::pmr::Features::toFeatures()
+    const
+{
+	EFS::Features f{};
+
+	f.identifier = this->identifier;
+	f.ppi = this->ppi;
+	if (this->quality)
+		f.quality.emplace(this->quality->cbegin(),
+		    this->quality->cend(), this->quality->bucket_count());
+	f.imp = this->imp;
+	f.frct = this->frct;
+	f.frgp = this->frgp;
+	f.orientation = this->orientation;
+	if (this->lpm)
+		f.lpm.emplace(this->lpm->cbegin(), this->lpm->cend());
+	f.valueAssessment = this->valueAssessment;
+	f.lsb = this->lsb;
+	f.pat = this->pat;
+	f.plr = this->plr;
+	f.trv = this->trv;
+	if (this->cores)
+		f.cores.emplace(this->cores->cbegin(), this->cores->cend());
+	if (this->deltas)
+		f.deltas.emplace(this->deltas->cbegin(),
+		    this->deltas->cend());
+	if (this->minutiae)
+		f.minutiae.emplace(this->minutiae->cbegin(),
+		    this->minutiae->cend());
+	if (this->creases)
+		f.creases.emplace(this->creases->cbegin(),
+		    this->creases->cend());
+	if (this->roi)
+		f.roi.emplace(this->roi->cbegin(), this->roi->cend());
+	if (this->rqm) {
+		f.rqm.emplace();
+		f.rqm->reserve(this->rqm->size());
+		for (const auto &rqr : *this->rqm)
+			f.rqm->push_back(rqr.toRidgeQualityRegion());
+	}
+	f.complex = this->complex;
+
+	return (f);
+}
+
+void
+FRIF::EFS::pmr::Features::assign(
+    Features &&features)
+{
+	this->identifier = features.identifier;
+	this->ppi = features.ppi;
+	this->quality = std::move(features.quality);
+	this->imp = features.imp;
+	this->frct = features.frct;
+	this->frgp = features.frgp;
+	this->orientation = std::move(features.orientation);
+	this->lpm = std::move(features.lpm);
+	this->valueAssessment = features.valueAssessment;
+	this->lsb = features.lsb;
+	this->pat = std::move(features.pat);
+	this->plr = features.plr;
+	this->trv = features.trv;
+	this->cores = std::move(features.cores);
+	this->deltas = std::move(features.deltas);
+	this->minutiae = std::move(features.minutiae);
+	this->creases = std::move(features.creases);
+	this->roi = std::move(features.roi);
+	this->rqm = std::move(features.rqm);
+	this->complex = features.complex;
+}
+
+/*
+ * Binary encoding of Features. Every integer is little-endian. A fixed
+ * header holds scalar members, a bitmask of which std::optional members
+ * are set, and the offset and count of each section that follows.
+ */
+
+/** First bytes of encoded Features. */
+static constexpr std::array<std::byte, 4> EncodingMagic{std::byte{'F'},
+    std::byte{'E'}, std::byte{'F'}, std::byte{'S'}};
+/** Size of the header written by this version. */
+static constexpr std::size_t EncodingHeaderSize{96};
+/** Offset of the section table within the header. */
+static constexpr std::size_t EncodingSectionTableOffset{32};
+
+/** Variable-length parts of encoded Features. */
+enum class EncodingSection
+{
+	ProcessingMethods,
+	Cores,
+	Deltas,
+	Minutiae,
+	Creases,
+	ROI,
+	RQM,
+	Quality
+};
+
+/** Bits of the header's mask of set std::optional members. */
+enum class EncodingPresence
+{
+	Quality,
+	Orientation,
+	OrientationUncertainty,
+	LPM,
+	ValueAssessment,
+	LSB,
+	Pattern,
+	PatternSubclassification,
+	WhorlDeltaRelationship,
+	PLR,
+	TRV,
+	Cores,
+	Deltas,
+	Minutiae,
+	Creases,
+	ROI,
+	RQM,
+	Complex
+};
+
+/** Size of each fixed-size record. */
+template<typename T>
+static constexpr std::size_t EncodedRecordSize{};
+template<>
+constexpr std::size_t EncodedRecordSize<FRIF::Coordinate>{8};
+template<>
+constexpr std::size_t EncodedRecordSize<FRIF::EFS::Core>{16};
+template<>
+constexpr std::size_t EncodedRecordSize<FRIF::EFS::Delta>{24};
+template<>
+constexpr std::size_t EncodedRecordSize<FRIF::EFS::Minutia>{16};
+
+template<typename T>
+static void
+putLE(
+    std::vector<std::byte> &buf,
+    const T value)
+{
+	for (std::size_t i{0}; i < sizeof(T); ++i)
+		buf.push_back(static_cast<std::byte>((value >> (8 * i)) & 0xFF));
+}
+
+template<typename T>
+static void
+putLEAt(
+    std::vector<std::byte> &buf,
+    const std::size_t offset,
+    const T value)
+{
+	for (std::size_t i{0}; i < sizeof(T); ++i)
+		buf[offset + i] = static_cast<std::byte>(
+		    (value >> (8 * i)) & 0xFF);
+}
+
+/** Read a value at `offset`, advancing `offset` past it. */
+template<typename T>
+static T
+readLE(
+    std::span<const std::byte> buf,
+    std::size_t &offset)
+{
+	if ((offset > buf.size()) || (sizeof(T) > buf.size() - offset))
+		throw std::runtime_error{"Encoded Features are truncated"};
+
+	uint64_t value{};
+	for (std::size_t i{0}; i < sizeof(T); ++i)
+		value |= uint64_t{std::to_integer<uint8_t>(buf[offset + i])} <<
+		    (8 * i);
+	offset += sizeof(T);
+
+	if constexpr (std::is_same_v<T, uint64_t>)
+		return (value);
+	else
+		return (static_cast<T>(value));
+}
+
+template<typename T>
+static T
+getLE(
+    std::span<const std::byte> buf,
+    std::size_t offset)
+{
+	return (readLE<T>(buf, offset));
+}
+
+static void
+putString(
+    std::vector<std::byte> &buf,
+    const std::string &str)
+{
+	if (!std::in_range<uint32_t>(str.size()))
+		throw std::runtime_error{"String too long to encode"};
+	putLE(buf, static_cast<uint32_t>(str.size()));
+	for (const auto c : str)
+		buf.push_back(static_cast<std::byte>(c));
+}
+
+static std::string
+readString(
+    std::span<const std::byte> buf,
+    std::size_t &offset)
+{
+	const auto length = readLE<uint32_t>(buf, offset);
+	if ((offset > buf.size()) || (length > buf.size() - offset))
+		throw std::runtime_error{"Encoded Features are truncated"};
+
+	std::string str(reinterpret_cast<const char*>(buf.data() + offset),
+	    length);
+	offset += length;
+
+	return (str);
+}
+
+/** Narrow an enumeration to the integer type stored in the encoding. */
+template<typename T, typename E>
+static T
+encodeEnum(
+    const E e)
+{
+	const auto i = FRIF::Util::e2i(e);
+	if (!std::in_range<T>(i))
+		throw std::runtime_error{"Cannot encode enumerated value " +
+		    std::to_string(i)};
+
+	return (static_cast<T>(i));
+}
+
+static uint8_t
+encodeFlag(
+    const bool set,
+    const uint8_t bit)
+{
+	return (set ? static_cast<uint8_t>(1u << bit) : uint8_t{0});
+}
+
+static void
+encodeRecord(
+    std::vector<std::byte> &buf,
+    const FRIF::Coordinate &c)
+{
+	putLE(buf, c.x);
+	putLE(buf, c.y);
+}
+
+static void
+encodeRecord(
+    std::vector<std::byte> &buf,
+    const FRIF::EFS::Core &c)
+{
+	encodeRecord(buf, c.coordinate);
+	putLE(buf, c.coordinateUncertainty.value_or(0));
+	putLE(buf, c.direction.value_or(0));
+	putLE(buf, c.directionUncertainty.value_or(0));
+	putLE(buf, static_cast<uint8_t>(
+	    encodeFlag(c.coordinateUncertainty.has_value(), 0) |
+	    encodeFlag(c.direction.has_value(), 1) |
+	    encodeFlag(c.directionUncertainty.has_value(), 2)));
+	putLE(buf, uint16_t{0});
+}
+
+static void
+encodeRecord(
+    std::vector<std::byte> &buf,
+    const FRIF::EFS::Delta &d)
+{
+	encodeRecord(buf, d.coordinate);
+	putLE(buf, d.coordinateUncertainty.value_or(0));
+
+	const auto dir = d.direction.value_or(std::make_tuple(
+	    std::nullopt, std::nullopt, std::nullopt));
+	putLE(buf, std::get<0>(dir).value_or(0));
+	putLE(buf, std::get<1>(dir).value_or(0));
+	putLE(buf, std::get<2>(dir).value_or(0));
+	const auto unc = d.directionUncertainty.value_or(std::make_tuple(
+	    std::nullopt, std::nullopt, std::nullopt));
+	putLE(buf, std::get<0>(unc).value_or(0));
+	putLE(buf, std::get<1>(unc).value_or(0));
+	putLE(buf, std::get<2>(unc).value_or(0));
+	putLE(buf, uint8_t{0});
+
+	uint16_t flags{encodeFlag(d.coordinateUncertainty.has_value(), 0)};
+	flags |= encodeFlag(d.direction.has_value(), 1);
+	flags |= encodeFlag(std::get<0>(dir).has_value(), 2);
+	flags |= encodeFlag(std::get<1>(dir).has_value(), 3);
+	flags |= encodeFlag(std::get<2>(dir).has_value(), 4);
+	flags |= encodeFlag(d.directionUncertainty.has_value(), 5);
+	flags |= encodeFlag(std::get<0>(unc).has_value(), 6);
+	flags |= encodeFlag(std::get<1>(unc).has_value(), 7);
+	if (std::get<2>(unc).has_value())
+		flags |= uint16_t{1u << 8};
+	putLE(buf, flags);
+	putLE(buf, uint16_t{0});
+}
+
+static void
+encodeRecord(
+    std::vector<std::byte> &buf,
+    const FRIF::EFS::Minutia &m)
+{
+	encodeRecord(buf, m.coordinate);
+	putLE(buf, m.theta);
+	putLE(buf, m.coordinateUncertainty.value_or(0));
+	putLE(buf, m.thetaUncertainty.value_or(0));
+	putLE(buf, encodeEnum<uint8_t>(m.type));
+	putLE(buf, static_cast<uint8_t>(
+	    encodeFlag(m.coordinateUncertainty.has_value(), 0) |
+	    encodeFlag(m.thetaUncertainty.has_value(), 1)));
+	putLE(buf, uint8_t{0});
+}
+
+template<typename T>
+static T
+decodeRecord(
+    std::span<const std::byte> record);
+
+template<>
+FRIF::Coordinate
+decodeRecord(
+    std::span<const std::byte> record)
+{
+	return {getLE<uint32_t>(record, 0), getLE<uint32_t>(record, 4)};
+}
+
+template<>
+FRIF::EFS::Core
+decodeRecord(
+    std::span<const std::byte> record)
+{
+	const auto flags = getLE<uint8_t>(record, 13);
+
+	FRIF::EFS::Core core{decodeRecord<FRIF::Coordinate>(record)};
+	if (flags & 0x01)
+		core.coordinateUncertainty = getLE<uint16_t>(record, 8);
+	if (flags & 0x02)
+		core.direction = getLE<uint16_t>(record, 10);
+	if (flags & 0x04)
+		core.directionUncertainty = getLE<uint8_t>(record, 12);
+
+	return (core);
+}
+
+template<>
+FRIF::EFS::Delta
+decodeRecord(
+    std::span<const std::byte> record)
+{
+	const auto flags = getLE<uint16_t>(record, 20);
+	const auto flag = [&](const unsigned bit) {
+		return ((flags & (1u << bit)) != 0);
+	};
+	const auto optional = [&](const unsigned bit, const auto value) {
+		return (flag(bit) ? std::optional{value} : std::nullopt);
+	};
+
+	FRIF::EFS::Delta delta{decodeRecord<FRIF::Coordinate>(record)};
+	if (flag(0))
+		delta.coordinateUncertainty = getLE<uint16_t>(record, 8);
+	if (flag(1))
+		delta.direction = std::make_tuple(
+		    optional(2, getLE<uint16_t>(record, 10)),
+		    optional(3, getLE<uint16_t>(record, 12)),
+		    optional(4, getLE<uint16_t>(record, 14)));
+	if (flag(5))
+		delta.directionUncertainty = std::make_tuple(
+		    optional(6, getLE<uint8_t>(record, 16)),
+		    optional(7, getLE<uint8_t>(record, 17)),
+		    optional(8, getLE<uint8_t>(record, 18)));
+
+	return (delta);
+}
+
+template<>
+FRIF::EFS::Minutia
+decodeRecord(
+    std::span<const std::byte> record)
+{
+	const auto flags = getLE<uint8_t>(record, 14);
+
+	FRIF::EFS::Minutia minutia{decodeRecord<FRIF::Coordinate>(record),
+	    getLE<uint16_t>(record, 8),
+	    FRIF::EFS::toMinutiaType(getLE<uint8_t>(record, 13))};
+	if (flags & 0x01)
+		minutia.coordinateUncertainty = getLE<uint16_t>(record, 10);
+	if (flags & 0x02)
+		minutia.thetaUncertainty = getLE<uint8_t>(record, 12);
+
+	return (minutia);
+}
+
+/** Read a record at `offset`, advancing `offset` past it. */
+template<typename T>
+static T
+readRecord(
+    std::span<const std::byte> buf,
+    std::size_t &offset)
+{
+	if ((offset > buf.size()) ||
+	    (EncodedRecordSize<T> > buf.size() - offset))
+		throw std::runtime_error{"Encoded Features are truncated"};
+
+	const auto record = decodeRecord<T>(buf.subspan(offset,
+	    EncodedRecordSize<T>));
+	offset += EncodedRecordSize<T>;
+
+	return (record);
+}
+
+static void
+encodeQualityMeasure(
+    std::vector<std::byte> &buf,
+    const FRIF::EFS::QualityMeasure::Description &d,
+    const FRIF::EFS::QualityMeasure &q)
+{
+	const auto &id = d.identifier;
+	const bool hasCBEFF{id.has_value() && id->cbeff.has_value()};
+	uint16_t flags{encodeFlag(id.has_value(), 0)};
+	flags |= encodeFlag(id.has_value() && id->marketing.has_value(), 1);
+	flags |= encodeFlag(hasCBEFF, 2);
+	flags |= encodeFlag(hasCBEFF && id->cbeff->algorithm.has_value(), 3);
+	flags |= encodeFlag(d.version.has_value(), 4);
+	flags |= encodeFlag(d.comment.has_value(), 5);
+	flags |= encodeFlag(d.modelSHA256.has_value(), 6);
+	flags |= encodeFlag(q.hasValue(), 7);
+	if (q.getMessage().has_value())
+		flags |= uint16_t{1u << 8};
+	putLE(buf, flags);
+
+	putLE(buf, hasCBEFF ? id->cbeff->owner : uint16_t{0});
+	putLE(buf, hasCBEFF ? id->cbeff->algorithm.value_or(0) : uint16_t{0});
+	if (id.has_value() && id->marketing.has_value())
+		putString(buf, *id->marketing);
+	if (d.version.has_value())
+		putString(buf, *d.version);
+	if (d.comment.has_value())
+		putString(buf, *d.comment);
+	if (d.modelSHA256.has_value())
+		putString(buf, *d.modelSHA256);
+	if (q.hasValue())
+		putLE(buf, std::bit_cast<uint64_t>(q.getValue()));
+	if (q.getMessage().has_value())
+		putString(buf, *q.getMessage());
+}
+
+static std::pair<FRIF::EFS::QualityMeasure::Description,
+    FRIF::EFS::QualityMeasure>
+readQualityMeasure(
+    std::span<const std::byte> buf,
+    std::size_t &offset)
+{
+	const auto flags = readLE<uint16_t>(buf, offset);
+	const auto owner = readLE<uint16_t>(buf, offset);
+	const auto algorithm = readLE<uint16_t>(buf, offset);
+
+	FRIF::EFS::QualityMeasure::Description d{};
+	if (flags & 0x0001) {
+		d.identifier.emplace();
+		if (flags & 0x0002)
+			d.identifier->marketing = readString(buf, offset);
+		if (flags & 0x0004) {
+			d.identifier->cbeff.emplace();
+			d.identifier->cbeff->owner = owner;
+			if (flags & 0x0008)
+				d.identifier->cbeff->algorithm = algorithm;
+		}
+	}
+	if (flags & 0x0010)
+		d.version = readString(buf, offset);
+	if (flags & 0x0020)
+		d.comment = readString(buf, offset);
+	if (flags & 0x0040)
+		d.modelSHA256 = readString(buf, offset);
+
+	FRIF::EFS::QualityMeasure q{};
+	if (flags & 0x0080)
+		q = FRIF::EFS::QualityMeasure{std::bit_cast<double>(
+		    readLE<uint64_t>(buf, offset))};
+	if (flags & 0x0100)
+		q.setMessage(readString(buf, offset));
+
+	return {d, q};
+}
+
+/** Offset and count of a section, checked to be within `encoded`. */
+static std::pair<std::size_t, std::size_t>
+getSection(
+    std::span<const std::byte> encoded,
+    const EncodingSection section)
+{
+	const auto entry = EncodingSectionTableOffset +
+	    (static_cast<std::size_t>(section) * 8);
+	const std::size_t offset{getLE<uint32_t>(encoded, entry)};
+	const std::size_t count{getLE<uint32_t>(encoded, entry + 4)};
+	if (offset > encoded.size())
+		throw std::runtime_error{"Encoded Features section " +
+		    std::to_string(FRIF::Util::e2i(section)) + " is out of "
+		    "bounds"};
+
+	return {offset, count};
+}
+
+template<typename T>
+static FRIF::EFS::RecordView<T>
+getRecordView(
+    std::span<const std::byte> encoded,
+    const EncodingSection section)
+{
+	const auto [offset, count] = getSection(encoded, section);
+	if (count > (encoded.size() - offset) / EncodedRecordSize<T>)
+		throw std::runtime_error{"Encoded Features section " +
+		    std::to_string(FRIF::Util::e2i(section)) + " is "
+		    "truncated"};
+
+	return {encoded.subspan(offset, count * EncodedRecordSize<T>),
+	    count};
+}
+
+static bool
+isPresent(
+    std::span<const std::byte> encoded,
+    const EncodingPresence presence)
+{
+	return ((getLE<uint32_t>(encoded, 8) &
+	    (uint32_t{1} << FRIF::Util::e2i(presence))) != 0);
+}
+
+std::vector<std::byte>
+FRIF::EFS::encode(
+    const Features &features)
+{
+	std::vector<std::byte> buf(EncodingHeaderSize);
+	std::copy(EncodingMagic.cbegin(), EncodingMagic.cend(), buf.begin());
+	putLEAt(buf, 4, FeaturesEncodingVersion);
+	putLEAt(buf, 6, static_cast<uint16_t>(EncodingHeaderSize));
+
+	uint32_t present{};
+	const auto setPresent = [&](const bool set,
+	    const EncodingPresence presence) {
+		if (set)
+			present |= uint32_t{1} << Util::e2i(presence);
+	};
+
+	putLEAt(buf, 12, features.identifier);
+	putLEAt(buf, 14, features.ppi);
+	putLEAt(buf, 16, encodeEnum<uint16_t>(features.imp));
+	putLEAt(buf, 18, encodeEnum<uint16_t>(features.frct));
+	putLEAt(buf, 20, encodeEnum<uint16_t>(features.frgp));
+
+	setPresent(features.valueAssessment.has_value(),
+	    EncodingPresence::ValueAssessment);
+	if (features.valueAssessment)
+		putLEAt(buf, 13, encodeEnum<uint8_t>(
+		    *features.valueAssessment));
+
+	setPresent(features.orientation.has_value(),
+	    EncodingPresence::Orientation);
+	if (features.orientation) {
+		putLEAt(buf, 22, static_cast<uint16_t>(
+		    features.orientation->direction));
+		setPresent(features.orientation->uncertainty.has_value(),
+		    EncodingPresence::OrientationUncertainty);
+		putLEAt(buf, 24,
+		    features.orientation->uncertainty.value_or(0));
+	}
+
+	setPresent(features.lsb.has_value(), EncodingPresence::LSB);
+	if (features.lsb)
+		putLEAt(buf, 25, encodeEnum<uint8_t>(*features.lsb));
+
+	setPresent(features.pat.has_value(), EncodingPresence::Pattern);
+	if (features.pat) {
+		putLEAt(buf, 26, encodeEnum<uint8_t>(
+		    features.pat->getPatternGeneralClassification()));
+
+		const auto sub = features.pat->getPatternSubclassification();
+		setPresent(sub.has_value(),
+		    EncodingPresence::PatternSubclassification);
+		if (sub) {
+			putLEAt(buf, 27, static_cast<uint8_t>(sub->index()));
+			putLEAt(buf, 28, std::visit([](const auto &v) {
+				return (encodeEnum<uint8_t>(v));
+			}, *sub));
+		}
+
+		const auto wdr = features.pat->getWhorlDeltaRelationship();
+		setPresent(wdr.has_value(),
+		    EncodingPresence::WhorlDeltaRelationship);
+		if (wdr)
+			putLEAt(buf, 29, encodeEnum<uint8_t>(*wdr));
+	}
+
+	setPresent(features.plr.has_value(), EncodingPresence::PLR);
+	setPresent(features.trv.has_value(), EncodingPresence::TRV);
+	setPresent(features.complex.has_value(), EncodingPresence::Complex);
+	putLEAt(buf, 30, static_cast<uint8_t>(
+	    encodeFlag(features.plr.value_or(false), 0) |
+	    encodeFlag(features.trv.value_or(false), 1) |
+	    encodeFlag(features.complex.value_or(false), 2)));
+
+	/* Record where each section begins */
+	const auto beginSection = [&](const EncodingSection section,
+	    const std::size_t count) {
+		if (!std::in_range<uint32_t>(buf.size()) ||
+		    !std::in_range<uint32_t>(count))
+			throw std::runtime_error{"Features too large to "
+			    "encode"};
+
+		const auto entry = EncodingSectionTableOffset +
+		    (static_cast<std::size_t>(section) * 8);
+		putLEAt(buf, entry, static_cast<uint32_t>(buf.size()));
+		putLEAt(buf, entry + 4, static_cast<uint32_t>(count));
+	};
+
+	setPresent(features.lpm.has_value(), EncodingPresence::LPM);
+	if (features.lpm) {
+		beginSection(EncodingSection::ProcessingMethods,
+		    features.lpm->size());
+		for (const auto &lpm : *features.lpm)
+			putLE(buf, encodeEnum<uint8_t>(lpm));
+	}
+
+	const auto encodeRecords = [&](const auto &records,
+	    const EncodingPresence presence, const EncodingSection section) {
+		setPresent(records.has_value(), presence);
+		if (!records)
+			return;
+
+		beginSection(section, records->size());
+		for (const auto &record : *records)
+			encodeRecord(buf, record);
+	};
+	encodeRecords(features.cores, EncodingPresence::Cores,
+	    EncodingSection::Cores);
+	encodeRecords(features.deltas, EncodingPresence::Deltas,
+	    EncodingSection::Deltas);
+	encodeRecords(features.minutiae, EncodingPresence::Minutiae,
+	    EncodingSection::Minutiae);
+	encodeRecords(features.roi, EncodingPresence::ROI,
+	    EncodingSection::ROI);
+
+	setPresent(features.creases.has_value(), EncodingPresence::Creases);
+	if (features.creases) {
+		beginSection(EncodingSection::Creases,
+		    features.creases->size());
+		for (const auto &crease : *features.creases) {
+			putLE(buf, encodeEnum<uint16_t>(
+			    crease.getFrictionRidgeGeneralizedPosition()));
+			const auto cld = crease.getCreaseClassification();
+			putLE(buf, static_cast<uint8_t>(cld.index()));
+			putLE(buf, std::visit([](const auto &v) {
+				return (encodeEnum<uint8_t>(v));
+			}, cld));
+
+			const auto segments = crease.getSegments();
+			if (!std::in_range<uint32_t>(segments.size()))
+				throw std::runtime_error{"Too many crease "
+				    "segments to encode"};
+			putLE(buf, static_cast<uint32_t>(segments.size()));
+			for (const auto &[a, b] : segments) {
+				encodeRecord(buf, a);
+				encodeRecord(buf, b);
+			}
+		}
+	}
+
+	setPresent(features.rqm.has_value(), EncodingPresence::RQM);
+	if (features.rqm) {
+		beginSection(EncodingSection::RQM, features.rqm->size());
+		for (const auto &rqr : *features.rqm) {
+			putLE(buf, encodeEnum<uint8_t>(rqr.quality));
+			if (!std::in_range<uint32_t>(rqr.region.size()))
+				throw std::runtime_error{"Too many ridge "
+				    "quality region vertices to encode"};
+			putLE(buf, static_cast<uint32_t>(rqr.region.size()));
+			for (const auto &c : rqr.region)
+				encodeRecord(buf, c);
+		}
+	}
+
+	setPresent(features.quality.has_value(), EncodingPresence::Quality);
+	if (features.quality) {
+		beginSection(EncodingSection::Quality,
+		    features.quality->size());
+
+		/*
+		 * Sort so that equal Features always encode identically. The
+		 * explicit byte comparison avoids a false -Wstringop-overread
+		 * from GCC's memcmp() specialization.
+		 */
+		std::vector<std::vector<std::byte>> entries{};
+		entries.reserve(features.quality->size());
+		for (const auto &[description, measure] : *features.quality)
+			encodeQualityMeasure(entries.emplace_back(),
+			    description, measure);
+		std::sort(entries.begin(), entries.end(), [](
+		    const auto &a, const auto &b) {
+			return (std::lexicographical_compare(a.cbegin(),
+			    a.cend(), b.cbegin(), b.cend(), [](
+			    const std::byte x, const std::byte y) {
+				return (x < y);
+			    }));
+		});
+
+		for (const auto &entry : entries)
+			buf.insert(buf.end(), entry.cbegin(), entry.cend());
+	}
+
+	putLEAt(buf, 8, present);
+
+	return (buf);
+}
+
+FRIF::EFS::Features
+FRIF::EFS::decode(
+    std::span<const std::byte> encoded)
+{
+	return (FeaturesView{encoded}.toFeatures());
+}
+
+FRIF::EFS::Features
+FRIF::EFS::rescale(
+    const Features &features,
+    const uint16_t ppi)
+{
+	if ((ppi == 0) || (features.ppi == 0))
+		throw std::invalid_argument{"Cannot rescale to or from 0 PPI"};
+
+	const double ratio{static_cast<double>(ppi) / features.ppi};
+	const auto scale = [&ratio]<typename T>(const T value,
+	    const double offset) -> T {
+		return (static_cast<T>(std::clamp(std::round(
+		    ((value + offset) * ratio) - offset), 0.0,
+		    static_cast<double>(std::numeric_limits<T>::max()))));
+	};
+	/* Map pixel centers, as Image::resample() does */
+	const auto scaleCoordinate = [&scale](const Coordinate &c) {
+		return (Coordinate{scale(c.x, 0.5), scale(c.y, 0.5)});
+	};
+	const auto scaleUncertainty = [&scale](
+	    std::optional<uint16_t> &radius) {
+		if (radius)
+			radius = scale(*radius, 0.0);
+	};
+
+	Features rescaled{features};
+	rescaled.ppi = ppi;
+
+	if (rescaled.cores) {
+		for (auto &core : *rescaled.cores) {
+			core.coordinate = scaleCoordinate(core.coordinate);
+			scaleUncertainty(core.coordinateUncertainty);
+		}
+	}
+	if (rescaled.deltas) {
+		for (auto &delta : *rescaled.deltas) {
+			delta.coordinate = scaleCoordinate(delta.coordinate);
+			scaleUncertainty(delta.coordinateUncertainty);
+		}
+	}
+	if (rescaled.minutiae) {
+		for (auto &minutia : *rescaled.minutiae) {
+			minutia.coordinate = scaleCoordinate(
+			    minutia.coordinate);
+			scaleUncertainty(minutia.coordinateUncertainty);
+		}
+	}
+	if (rescaled.creases) {
+		for (auto &crease : *rescaled.creases) {
+			auto segments = crease.getSegments();
+			for (auto &[start, end] : segments) {
+				start = scaleCoordinate(start);
+				end = scaleCoordinate(end);
+			}
+			crease.setSegments(segments);
+		}
+	}
+	if (rescaled.roi)
+		for (auto &vertex : *rescaled.roi)
+			vertex = scaleCoordinate(vertex);
+	if (rescaled.rqm)
+		for (auto &region : *rescaled.rqm)
+			for (auto &vertex : region.region)
+				vertex = scaleCoordinate(vertex);
+
+	return (rescaled);
+}
+
+template<typename T>
+FRIF::EFS::RecordView<T>::RecordView() = default;
+
+template<typename T>
+FRIF::EFS::RecordView<T>::RecordView(
+    std::span<const std::byte> records_,
+    const std::size_t count_) :
+    records{records_},
+    count{count_}
+{
+
+}
+
+template<typename T>
+std::size_t
+FRIF::EFS::RecordView<T>::size()
+    const
+{
+	return (this->count);
+}
+
+template<typename T>
+bool
+FRIF::EFS::RecordView<T>::empty()
+    const
+{
+	return (this->count == 0);
+}
+
+template<typename T>
+T
+FRIF::EFS::RecordView<T>::operator[](
+    const std::size_t i)
+    const
+{
+	return (decodeRecord<T>(this->records.subspan(
+	    i * EncodedRecordSize<T>, EncodedRecordSize<T>)));
+}
+
+template<typename T>
+T
+FRIF::EFS::RecordView<T>::at(
+    const std::size_t i)
+    const
+{
+	if (i >= this->count)
+		throw std::out_of_range{"Record " + std::to_string(i) +
+		    " requested from " + std::to_string(this->count)};
+
+	return ((*this)[i]);
+}
+
+template class FRIF::EFS::RecordView<FRIF::Coordinate>;
+template class FRIF::EFS::RecordView<FRIF::EFS::Core>;
+template class FRIF::EFS::RecordView<FRIF::EFS::Delta>;
+template class FRIF::EFS::RecordView<FRIF::EFS::Minutia>;
+
+FRIF::EFS::FeaturesView::FeaturesView(
+    std::span<const std::byte> encoded_) :
+    encoded{encoded_}
+{
+	if ((this->encoded.size() < EncodingMagic.size()) ||
+	    !std::equal(EncodingMagic.cbegin(), EncodingMagic.cend(),
+	    this->encoded.begin()))
+		throw std::runtime_error{"Not encoded Features"};
+
+	const auto version = this->getVersion();
+	if ((version == 0) || (version > FeaturesEncodingVersion))
+		throw std::runtime_error{"Unsupported Features encoding "
+		    "version " + std::to_string(version)};
+	if (getLE<uint16_t>(this->encoded, 6) < EncodingHeaderSize)
+		throw std::runtime_error{"Encoded Features header is "
+		    "truncated"};
+	if (this->encoded.size() < EncodingHeaderSize)
+		throw std::runtime_error{"Encoded Features are truncated"};
+
+	/* Check bounds of fixed-size sections up front */
+	this->getCores();
+	this->getDeltas();
+	this->getMinutiae();
+	this->getROI();
+}
+
+uint16_t
+FRIF::EFS::FeaturesView::getVersion()
+    const
+{
+	return (getLE<uint16_t>(this->encoded, 4));
+}
+
+uint8_t
+FRIF::EFS::FeaturesView::getIdentifier()
+    const
+{
+	return (getLE<uint8_t>(this->encoded, 12));
+}
+
+uint16_t
+FRIF::EFS::FeaturesView::getPPI()
+    const
+{
+	return (getLE<uint16_t>(this->encoded, 14));
+}
+
+FRIF::EFS::Impression
+FRIF::EFS::FeaturesView::getImpression()
+    const
+{
+	return (toImpression(getLE<uint16_t>(this->encoded, 16)));
+}
+
+FRIF::EFS::FrictionRidgeCaptureTechnology
+FRIF::EFS::FeaturesView::getFrictionRidgeCaptureTechnology()
+    const
+{
+	return (toFrictionRidgeCaptureTechnology(getLE<uint16_t>(
+	    this->encoded, 18)));
+}
+
+FRIF::EFS::FrictionRidgeGeneralizedPosition
+FRIF::EFS::FeaturesView::getFrictionRidgeGeneralizedPosition()
+    const
+{
+	return (toFrictionRidgeGeneralizedPosition(getLE<uint16_t>(
+	    this->encoded, 20)));
+}
+
+bool
+FRIF::EFS::FeaturesView::hasMinutiae()
+    const
+{
+	return (isPresent(this->encoded, EncodingPresence::Minutiae));
+}
+
+FRIF::EFS::RecordView<FRIF::EFS::Minutia>
+FRIF::EFS::FeaturesView::getMinutiae()
+    const
+{
+	if (!this->hasMinutiae())
+		return {};
+	return (getRecordView<Minutia>(this->encoded,
+	    EncodingSection::Minutiae));
+}
+
+bool
+FRIF::EFS::FeaturesView::hasCores()
+    const
+{
+	return (isPresent(this->encoded, EncodingPresence::Cores));
+}
+
+FRIF::EFS::RecordView<FRIF::EFS::Core>
+FRIF::EFS::FeaturesView::getCores()
+    const
+{
+	if (!this->hasCores())
+		return {};
+	return (getRecordView<Core>(this->encoded, EncodingSection::Cores));
+}
+
+bool
+FRIF::EFS::FeaturesView::hasDeltas()
+    const
+{
+	return (isPresent(this->encoded, EncodingPresence::Deltas));
+}
+
+FRIF::EFS::RecordView<FRIF::EFS::Delta>
+FRIF::EFS::FeaturesView::getDeltas()
+    const
+{
+	if (!this->hasDeltas())
+		return {};
+	return (getRecordView<Delta>(this->encoded,
+	    EncodingSection::Deltas));
+}
+
+bool
+FRIF::EFS::FeaturesView::hasROI()
+    const
+{
+	return (isPresent(this->encoded, EncodingPresence::ROI));
+}
+
+FRIF::EFS::RecordView<FRIF::Coordinate>
+FRIF::EFS::FeaturesView::getROI()
+    const
+{
+	if (!this->hasROI())
+		return {};
+	return (getRecordView<Coordinate>(this->encoded,
+	    EncodingSection::ROI));
+}
+
+FRIF::EFS::Features
+FRIF::EFS::FeaturesView::toFeatures()
+    const
+{
+	const auto present = [&](const EncodingPresence presence) {
+		return (isPresent(this->encoded, presence));
+	};
+	const auto toVector = [](const auto &view) {
+		std::vector<decltype(view[0])> records{};
+		records.reserve(view.size());
+		for (std::size_t i{0}; i < view.size(); ++i)
+			records.push_back(view[i]);
+		return (records);
+	};
+
+	Features f{};
+	f.identifier = this->getIdentifier();
+	f.ppi = this->getPPI();
+	f.imp = this->getImpression();
+	f.frct = this->getFrictionRidgeCaptureTechnology();
+	f.frgp = this->getFrictionRidgeGeneralizedPosition();
+
+	if (present(EncodingPresence::ValueAssessment))
+		f.valueAssessment = toValueAssessment(getLE<uint8_t>(
+		    this->encoded, 13));
+	if (present(EncodingPresence::Orientation))
+		f.orientation = Orientation{static_cast<int16_t>(
+		    getLE<uint16_t>(this->encoded, 22)),
+		    present(EncodingPresence::OrientationUncertainty) ?
+		    std::optional{getLE<uint8_t>(this->encoded, 24)} :
+		    std::nullopt};
+	if (present(EncodingPresence::LSB))
+		f.lsb = toSubstrate(getLE<uint8_t>(this->encoded, 25));
+	if (present(EncodingPresence::Pattern)) {
+		std::optional<PatternSubclassification> sub{};
+		if (present(EncodingPresence::PatternSubclassification)) {
+			const auto value = getLE<uint8_t>(this->encoded, 28);
+			switch (getLE<uint8_t>(this->encoded, 27)) {
+			case 0:
+				sub = toArchPatternSubclassification(value);
+				break;
+			case 1:
+				sub = toWhorlPatternSubclassification(value);
+				break;
+			default:
+				throw std::runtime_error{"Invalid encoded "
+				    "pattern subclassification"};
+			}
+		}
+
+		f.pat = PatternClassification{toPatternGeneralClassification(
+		    getLE<uint8_t>(this->encoded, 26)), sub,
+		    present(EncodingPresence::WhorlDeltaRelationship) ?
+		    std::optional{toWhorlDeltaRelationship(getLE<uint8_t>(
+		    this->encoded, 29))} : std::nullopt};
+	}
+
+	const auto flags = getLE<uint8_t>(this->encoded, 30);
+	if (present(EncodingPresence::PLR))
+		f.plr = (flags & 0x01) != 0;
+	if (present(EncodingPresence::TRV))
+		f.trv = (flags & 0x02) != 0;
+	if (present(EncodingPresence::Complex))
+		f.complex = (flags & 0x04) != 0;
+
+	if (present(EncodingPresence::LPM)) {
+		auto [offset, count] = getSection(this->encoded,
+		    EncodingSection::ProcessingMethods);
+		f.lpm.emplace();
+		for (std::size_t i{0}; i < count; ++i)
+			f.lpm->push_back(toProcessingMethod(readLE<uint8_t>(
+			    this->encoded, offset)));
+	}
+
+	if (this->hasCores())
+		f.cores = toVector(this->getCores());
+	if (this->hasDeltas())
+		f.deltas = toVector(this->getDeltas());
+	if (this->hasMinutiae())
+		f.minutiae = toVector(this->getMinutiae());
+	if (this->hasROI())
+		f.roi = toVector(this->getROI());
+
+	if (present(EncodingPresence::Creases)) {
+		auto [offset, count] = getSection(this->encoded,
+		    EncodingSection::Creases);
+		f.creases.emplace();
+		for (std::size_t i{0}; i < count; ++i) {
+			const auto fgp = toFrictionRidgeGeneralizedPosition(
+			    readLE<uint16_t>(this->encoded, offset));
+			const auto kind = readLE<uint8_t>(this->encoded,
+			    offset);
+			const auto value = readLE<uint8_t>(this->encoded,
+			    offset);
+			CreaseClassification cld{};
+			switch (kind) {
+			case 0:
+				cld = toFingerCrease(value);
+				break;
+			case 1:
+				cld = toPalmCrease(value);
+				break;
+			case 2:
+				cld = toLinearDiscontinuity(value);
+				break;
+			default:
+				throw std::runtime_error{"Invalid encoded "
+				    "crease classification"};
+			}
+
+			const auto numSegments = readLE<uint32_t>(
+			    this->encoded, offset);
+			std::vector<Segment> segments{};
+			for (uint32_t j{0}; j < numSegments; ++j) {
+				const auto a = readRecord<Coordinate>(
+				    this->encoded, offset);
+				const auto b = readRecord<Coordinate>(
+				    this->encoded, offset);
+				segments.emplace_back(a, b);
+			}
+
+			f.creases->emplace_back(fgp, cld, segments);
+		}
+	}
+
+	if (present(EncodingPresence::RQM)) {
+		auto [offset, count] = getSection(this->encoded,
+		    EncodingSection::RQM);
+		f.rqm.emplace();
+		for (std::size_t i{0}; i < count; ++i) {
+			RidgeQualityRegion rqr{};
+			rqr.quality = toRidgeQuality(readLE<uint8_t>(
+			    this->encoded, offset));
+			const auto numVertices = readLE<uint32_t>(
+			    this->encoded, offset);
+			for (uint32_t j{0}; j < numVertices; ++j) {
+				rqr.region.push_back(readRecord<Coordinate>(
+				    this->encoded, offset));
+			}
+			f.rqm->push_back(rqr);
+		}
+	}
+
+	if (present(EncodingPresence::Quality)) {
+		auto [offset, count] = getSection(this->encoded,
+		    EncodingSection::Quality);
+		f.quality.emplace();
+		for (std::size_t i{0}; i < count; ++i)
+			f.quality->insert(readQualityMeasure(this->encoded,
+			    offset));
+	}
+
+	return (f);
+}
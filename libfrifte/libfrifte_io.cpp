@@ -8,7 +8,230 @@
  * about its quality, reliability, or any other characteristic.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+
 #include <frifte/io.h>
+#include <frifte/util.h>
+
+FRIF::pmr::TemplateData::TemplateData(
+    const TemplateData &templateData) :
+    TemplateData(templateData, allocator_type{})
+{
+
+}
+
+FRIF::pmr::TemplateData::TemplateData(
+    const allocator_type &alloc) :
+    identifier{alloc}
+{
+
+}
+
+FRIF::pmr::TemplateData::TemplateData(
+    const TemplateData &templateData,
+    const allocator_type &alloc) :
+    identifier{templateData.identifier, alloc},
+    inputIdentifier{templateData.inputIdentifier}
+{
+	if (templateData.features)
+		this->features.emplace(*templateData.features, alloc);
+}
+
+FRIF::pmr::TemplateData::TemplateData(
+    TemplateData &&templateData,
+    const allocator_type &alloc) :
+    identifier{std::move(templateData.identifier), alloc},
+    inputIdentifier{templateData.inputIdentifier}
+{
+	if (templateData.features)
+		this->features.emplace(std::move(*templateData.features),
+		    alloc);
+}
+
+FRIF::pmr::TemplateData::TemplateData(
+    const FRIF::TemplateData &templateData,
+    const allocator_type &alloc) :
+    identifier{templateData.identifier, alloc},
+    inputIdentifier{templateData.inputIdentifier}
+{
+	if (templateData.features)
+		this->features.emplace(*templateData.features, alloc);
+}
+
+FRIF::pmr::TemplateData&
+FRIF::pmr::TemplateData::operator=(
+    const TemplateData &templateData)
+{
+	if (this == &templateData)
+		return (*this);
+
+	this->identifier = templateData.identifier;
+	this->inputIdentifier = templateData.inputIdentifier;
+	if (!templateData.features)
+		this->features.reset();
+	else if (this->features)
+		*this->features = *templateData.features;
+	else
+		this->features.emplace(*templateData.features,
+		    this->get_allocator());
+
+	return (*this);
+}
+
+FRIF::pmr::TemplateData&
+FRIF::pmr::TemplateData::operator=(
+    TemplateData &&templateData)
+{
+	if (this == &templateData)
+		return (*this);
+
+	this->identifier = std::move(templateData.identifier);
+	this->inputIdentifier = templateData.inputIdentifier;
+	if (!templateData.features)
+		this->features.reset();
+	else if (this->features)
+		*this->features = std::move(*templateData.features);
+	else
+		this->features.emplace(std::move(*templateData.features),
+		    this->get_allocator());
+
+	return (*this);
+}
+
+FRIF::pmr::TemplateData::allocator_type
+FRIF::pmr::TemplateData::get_allocator()
+    const
+    noexcept
+{
+	return (this->identifier.get_allocator());
+}
+
+FRIF::TemplateData
+FRIF::pmr::TemplateData::toTemplateData()
+    const
+{
+	FRIF::TemplateData td{};
+	td.identifier.assign(this->identifier.cbegin(),
+	    this->identifier.cend());
+	td.inputIdentifier = this->inputIdentifier;
+	if (this->features)
+		td.features.emplace(this->features->toFeatures());
+
+	return (td);
+}
+
+FRIF::pmr::CreateTemplateResult::CreateTemplateResult(
+    const CreateTemplateResult &templateResult) :
+    CreateTemplateResult(templateResult, allocator_type{})
+{
+
+}
+
+FRIF::pmr::CreateTemplateResult::CreateTemplateResult(
+    const allocator_type &alloc) :
+    data{alloc}
+{
+
+}
+
+FRIF::pmr::CreateTemplateResult::CreateTemplateResult(
+    const CreateTemplateResult &templateResult,
+    const allocator_type &alloc) :
+    data{templateResult.data, alloc}
+{
+	if (templateResult.extractedData)
+		this->extractedData.emplace(*templateResult.extractedData,
+		    alloc);
+}
+
+FRIF::pmr::CreateTemplateResult::CreateTemplateResult(
+    CreateTemplateResult &&templateResult,
+    const allocator_type &alloc) :
+    data{std::move(templateResult.data), alloc}
+{
+	if (templateResult.extractedData)
+		this->extractedData.emplace(
+		    std::move(*templateResult.extractedData), alloc);
+}
+
+FRIF::pmr::CreateTemplateResult::CreateTemplateResult(
+    const FRIF::CreateTemplateResult &templateResult,
+    const allocator_type &alloc) :
+    data{templateResult.data.cbegin(), templateResult.data.cend(), alloc}
+{
+	if (templateResult.extractedData)
+		this->extractedData.emplace(
+		    templateResult.extractedData->cbegin(),
+		    templateResult.extractedData->cend(), alloc);
+}
+
+FRIF::pmr::CreateTemplateResult&
+FRIF::pmr::CreateTemplateResult::operator=(
+    const CreateTemplateResult &templateResult)
+{
+	if (this == &templateResult)
+		return (*this);
+
+	this->data = templateResult.data;
+	if (!templateResult.extractedData)
+		this->extractedData.reset();
+	else if (this->extractedData)
+		*this->extractedData = *templateResult.extractedData;
+	else
+		this->extractedData.emplace(*templateResult.extractedData,
+		    this->get_allocator());
+
+	return (*this);
+}
+
+FRIF::pmr::CreateTemplateResult&
+FRIF::pmr::CreateTemplateResult::operator=(
+    CreateTemplateResult &&templateResult)
+{
+	if (this == &templateResult)
+		return (*this);
+
+	this->data = std::move(templateResult.data);
+	if (!templateResult.extractedData)
+		this->extractedData.reset();
+	else if (this->extractedData)
+		*this->extractedData = std::move(
+		    *templateResult.extractedData);
+	else
+		this->extractedData.emplace(
+		    std::move(*templateResult.extractedData),
+		    this->get_allocator());
+
+	return (*this);
+}
+
+FRIF::pmr::CreateTemplateResult::allocator_type
+FRIF::pmr::CreateTemplateResult::get_allocator()
+    const
+    noexcept
+{
+	return (this->data.get_allocator());
+}
+
+FRIF::CreateTemplateResult
+FRIF::pmr::CreateTemplateResult::toCreateTemplateResult()
+    const
+{
+	FRIF::CreateTemplateResult ctr{};
+	ctr.data.assign(this->data.cbegin(), this->data.cend());
+	if (this->extractedData) {
+		ctr.extractedData.emplace();
+		ctr.extractedData->reserve(this->extractedData->size());
+		for (const auto &td : *this->extractedData)
+			ctr.extractedData->push_back(td.toTemplateData());
+	}
+
+	return (ctr);
+}
 
 FRIF::SubjectPositionCandidate::SubjectPositionCandidate(
     const std::string &identifier_,
@@ -33,13 +256,231 @@ FRIF::SubjectPositionCandidateListKeyHash::operator()(
     const
     noexcept
 {
-	/*
-	 * Keys are guaranteed to not contain spaces (per
-	 * FRIF::TemplateArchive), so combining a unique identifier
-	 * with a finger position delimited by a space results in a unique
-	 * string for that identifier + position combination.
-	 */
-	return (std::hash<std::string>{}(c.identifier + ' ' +
-	    std::to_string(std::underlying_type_t<
-	    EFS::FrictionRidgeGeneralizedPosition>(c.fgp))));
+	std::size_t seed{};
+	Util::hashCombine(seed, c.identifier);
+	Util::hashCombine(seed, c.fgp);
+
+	return (seed);
+}
+
+/**
+ * Order candidates by descending similarity, then by ascending key, with NaN
+ * similarities last so the order stays strict weak.
+ */
+template<typename Candidate>
+static bool
+candidateRankedBefore(
+    const Candidate &aCandidate,
+    const double aSimilarity,
+    const Candidate &bCandidate,
+    const double bSimilarity)
+{
+	const bool aNaN{std::isnan(aSimilarity)};
+	const bool bNaN{std::isnan(bSimilarity)};
+	if (aNaN != bNaN)
+		return (bNaN);
+	if (!aNaN && (aSimilarity != bSimilarity))
+		return (aSimilarity > bSimilarity);
+	return (aCandidate < bCandidate);
+}
+
+/** candidateRankedBefore() for candidate list entries. */
+template<typename Candidate>
+static bool
+rankedBefore(
+    const std::pair<Candidate, double> &a,
+    const std::pair<Candidate, double> &b)
+{
+	return (candidateRankedBefore(a.first, a.second, b.first,
+	    b.second));
+}
+
+template<typename Candidate, typename Hash>
+FRIF::RankedCandidateList<Candidate, Hash>::RankedCandidateList(
+    const std::size_t capacity_) :
+    capacity{capacity_}
+{
+	this->entries.reserve(this->capacity);
+}
+
+template<typename Candidate, typename Hash>
+FRIF::RankedCandidateList<Candidate, Hash>::RankedCandidateList(
+    const CandidateList &candidateList,
+    const std::size_t capacity_) :
+    RankedCandidateList(capacity_)
+{
+	for (const auto &[candidate, similarity] : candidateList)
+		this->push(candidate, similarity);
+}
+
+template<typename Candidate, typename Hash>
+bool
+FRIF::RankedCandidateList<Candidate, Hash>::push(
+    const Candidate &candidate,
+    const double similarity)
+{
+	if (this->capacity == 0)
+		return (false);
+
+	/* Front of the heap is the lowest-ranked candidate */
+	if (this->ranked) {
+		std::make_heap(this->entries.begin(), this->entries.end(),
+		    rankedBefore<Candidate>);
+		this->ranked = false;
+	}
+
+	if (this->entries.size() < this->capacity) {
+		this->entries.emplace_back(candidate, similarity);
+		std::push_heap(this->entries.begin(), this->entries.end(),
+		    rankedBefore<Candidate>);
+		return (true);
+	}
+
+	if (!candidateRankedBefore(candidate, similarity,
+	    this->entries.front().first, this->entries.front().second))
+		return (false);
+
+	std::pop_heap(this->entries.begin(), this->entries.end(),
+	    rankedBefore<Candidate>);
+	this->entries.back().first = candidate;
+	this->entries.back().second = similarity;
+	std::push_heap(this->entries.begin(), this->entries.end(),
+	    rankedBefore<Candidate>);
+
+	return (true);
+}
+
+template<typename Candidate, typename Hash>
+std::span<const typename FRIF::RankedCandidateList<Candidate,
+    Hash>::value_type>
+FRIF::RankedCandidateList<Candidate, Hash>::rank()
+{
+	if (!this->ranked) {
+		std::sort_heap(this->entries.begin(), this->entries.end(),
+		    rankedBefore<Candidate>);
+		this->ranked = true;
+	}
+
+	return (this->entries);
+}
+
+template<typename Candidate, typename Hash>
+std::optional<double>
+FRIF::RankedCandidateList<Candidate, Hash>::getThreshold()
+    const
+{
+	if (this->entries.empty() || (this->entries.size() < this->capacity))
+		return (std::nullopt);
+
+	return (this->ranked ? this->entries.back().second :
+	    this->entries.front().second);
+}
+
+template<typename Candidate, typename Hash>
+typename FRIF::RankedCandidateList<Candidate, Hash>::CandidateList
+FRIF::RankedCandidateList<Candidate, Hash>::toCandidateList()
+    const
+{
+	CandidateList candidateList{};
+	candidateList.reserve(this->entries.size());
+	for (const auto &[candidate, similarity] : this->entries) {
+		const auto [it, inserted] = candidateList.emplace(candidate,
+		    similarity);
+		if (!inserted)
+			it->second = std::max(it->second, similarity);
+	}
+
+	return (candidateList);
+}
+
+template<typename Candidate, typename Hash>
+std::size_t
+FRIF::RankedCandidateList<Candidate, Hash>::getCapacity()
+    const
+{
+	return (this->capacity);
+}
+
+template<typename Candidate, typename Hash>
+std::size_t
+FRIF::RankedCandidateList<Candidate, Hash>::size()
+    const
+{
+	return (this->entries.size());
+}
+
+template<typename Candidate, typename Hash>
+bool
+FRIF::RankedCandidateList<Candidate, Hash>::empty()
+    const
+{
+	return (this->entries.empty());
+}
+
+template class FRIF::RankedCandidateList<FRIF::SubjectCandidate>;
+template class FRIF::RankedCandidateList<FRIF::SubjectPositionCandidate,
+    FRIF::SubjectPositionCandidateListKeyHash>;
+
+FRIF::SubjectIdentifierDictionary::SubjectIdentifierDictionary() = default;
+
+FRIF::SubjectID
+FRIF::SubjectIdentifierDictionary::intern(
+    const std::string &identifier)
+{
+	if (const auto it = this->ids.find(identifier); it != this->ids.cend())
+		return (it->second);
+
+	if (this->identifiers.size() > std::numeric_limits<SubjectID>::max())
+		throw std::runtime_error{"No SubjectID remain for \"" +
+		    identifier + "\""};
+
+	const auto id = static_cast<SubjectID>(this->identifiers.size());
+	this->ids.emplace(identifier, id);
+	this->identifiers.push_back(identifier);
+
+	return (id);
+}
+
+std::optional<FRIF::SubjectID>
+FRIF::SubjectIdentifierDictionary::find(
+    const std::string &identifier)
+    const
+{
+	if (const auto it = this->ids.find(identifier); it != this->ids.cend())
+		return (it->second);
+	return (std::nullopt);
+}
+
+const std::string&
+FRIF::SubjectIdentifierDictionary::resolve(
+    const SubjectID id)
+    const
+{
+	return (this->identifiers.at(id));
+}
+
+std::size_t
+FRIF::SubjectIdentifierDictionary::size()
+    const
+{
+	return (this->identifiers.size());
+}
+
+FRIF::Sample
+FRIF::resample(
+    const Sample &sample,
+    const uint16_t ppi,
+    const ResampleOptions &options)
+{
+	const auto &[image, features] = sample;
+
+	Sample resampled{};
+	if (image)
+		std::get<std::optional<Image>>(resampled) = image->resample(
+		    ppi, options);
+	if (features)
+		std::get<std::optional<EFS::Features>>(resampled) =
+		    EFS::rescale(*features, ppi);
+
+	return (resampled);
 }
@@ -9,12 +9,42 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cctype>
+#include <cerrno>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <new>
 #include <vector>
 #include <random>
 #include <numeric>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#define FRIF_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+#if __has_include(<linux/perf_event.h>)
+#define FRIF_HAVE_PERF_EVENT
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
 
 #include <frifte/efs.h>
 #include <frifte/util.h>
@@ -39,6 +69,856 @@ FRIF::Util::lower(
 	return (s);
 }
 
+FRIF::Util::MappedFile::MappedFile(
+    const std::filesystem::path &pathName,
+    const Access access)
+{
+	const int fd = open(pathName.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		throw std::runtime_error{"Could not open " + pathName.string() +
+		    ": " + std::strerror(errno)};
+
+	struct stat sb{};
+	if (fstat(fd, &sb) == -1) {
+		const int err{errno};
+		close(fd);
+		throw std::runtime_error{"Could not stat " +
+		    pathName.string() + ": " + std::strerror(err)};
+	}
+
+	/* mmap() cannot map 0 bytes */
+	this->length = static_cast<std::size_t>(sb.st_size);
+	if (this->length != 0) {
+		this->address = mmap(nullptr, this->length, PROT_READ,
+		    MAP_PRIVATE, fd, 0);
+		if (this->address == MAP_FAILED) {
+			const int err{errno};
+			this->address = nullptr;
+			close(fd);
+			throw std::runtime_error{"Could not map " +
+			    pathName.string() + ": " + std::strerror(err)};
+		}
+	}
+
+	/* Mapping remains valid after closing the descriptor */
+	close(fd);
+
+	this->advise(access);
+}
+
+void
+FRIF::Util::MappedFile::advise(
+    const Access access)
+    const
+{
+	if (this->address == nullptr)
+		return;
+
+	int advice{MADV_NORMAL};
+	switch (access) {
+	case Access::Normal:
+		advice = MADV_NORMAL;
+		break;
+	case Access::Sequential:
+		advice = MADV_SEQUENTIAL;
+		break;
+	case Access::Random:
+		advice = MADV_RANDOM;
+		break;
+	case Access::WillNeed:
+		advice = MADV_WILLNEED;
+		break;
+	}
+
+	/* Only a hint, so the mapping is usable even if this fails */
+	madvise(this->address, this->length, advice);
+}
+
+std::span<const std::byte>
+FRIF::Util::MappedFile::data()
+    const
+{
+	return {static_cast<const std::byte*>(this->address), this->length};
+}
+
+std::size_t
+FRIF::Util::MappedFile::size()
+    const
+{
+	return (this->length);
+}
+
+FRIF::Util::MappedFile::MappedFile(
+    MappedFile &&rhs)
+    noexcept :
+    address{std::exchange(rhs.address, nullptr)},
+    length{std::exchange(rhs.length, 0)}
+{
+
+}
+
+FRIF::Util::MappedFile&
+FRIF::Util::MappedFile::operator=(
+    MappedFile &&rhs)
+    noexcept
+{
+	if (this != &rhs) {
+		if (this->address != nullptr)
+			munmap(this->address, this->length);
+		this->address = std::exchange(rhs.address, nullptr);
+		this->length = std::exchange(rhs.length, 0);
+	}
+
+	return (*this);
+}
+
+FRIF::Util::MappedFile::~MappedFile()
+{
+	if (this->address != nullptr)
+		munmap(this->address, this->length);
+}
+
+/*
+ * FilePrefetcher. Each backend keeps one slot per file that may be read
+ * ahead, indexed by the file's position in pathNames modulo depth. A slot
+ * is reused only after next() has returned its file.
+ */
+
+/** Maximum number of threads used by FilePrefetcher::ThreadPoolReader. */
+static constexpr uint16_t MaxPrefetchThreads{16};
+
+/** @return Descriptor and size of `pathName`, opened for reading. */
+static std::tuple<int, std::size_t>
+openForRead(
+    const std::filesystem::path &pathName)
+{
+	const int fd = open(pathName.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		throw std::runtime_error{"Could not open " + pathName.string() +
+		    ": " + std::strerror(errno)};
+
+	struct stat sb{};
+	if (fstat(fd, &sb) == -1) {
+		const int err{errno};
+		close(fd);
+		throw std::runtime_error{"Could not stat " +
+		    pathName.string() + ": " + std::strerror(err)};
+	}
+
+	return {fd, static_cast<std::size_t>(sb.st_size)};
+}
+
+/** @return Uninitialized buffer for `size` bytes of a file. */
+static std::shared_ptr<std::byte[]>
+allocateFileBuffer(
+    const std::size_t size)
+{
+	return (std::make_shared_for_overwrite<std::byte[]>(size));
+}
+
+/** @return Contents of `pathName`, read with blocking calls. */
+static FRIF::Util::FileContents
+readFileContents(
+    const std::filesystem::path &pathName)
+{
+	const auto [fd, size] = openForRead(pathName);
+	auto buffer = allocateFileBuffer(size);
+
+	std::size_t offset{0};
+	while (offset < size) {
+		const auto rv = pread(fd, buffer.get() + offset, size - offset,
+		    static_cast<off_t>(offset));
+		if ((rv == -1) && (errno == EINTR))
+			continue;
+		if (rv <= 0) {
+			/* A file that shrinks ends early */
+			const int err{rv == 0 ? EIO : errno};
+			close(fd);
+			throw std::runtime_error{"Could not read " +
+			    pathName.string() + ": " + std::strerror(err)};
+		}
+		offset += static_cast<std::size_t>(rv);
+	}
+	close(fd);
+
+	return {{buffer.get(), size}, buffer};
+}
+
+/** Backend of a FilePrefetcher. */
+class FRIF::Util::FilePrefetcher::Impl
+{
+public:
+	Impl(
+	    std::vector<std::filesystem::path> pathNames_,
+	    const uint16_t depth_) :
+	    pathNames{std::move(pathNames_)},
+	    depth{depth_}
+	{
+
+	}
+
+	virtual ~Impl() = default;
+
+	/**
+	 * @brief
+	 * Obtain the contents of a file, waiting if necessary.
+	 *
+	 * @param index
+	 * Index of the file in #pathNames, one greater than the last
+	 * index passed.
+	 *
+	 * @return
+	 * Contents of the file.
+	 */
+	virtual FileContents
+	take(
+	    const std::size_t index) = 0;
+
+	/**
+	 * @brief
+	 * Append files to #pathNames and start reading any that now fit
+	 * within #depth.
+	 *
+	 * @param morePathNames
+	 * Files to read, in order.
+	 */
+	virtual void
+	extend(
+	    std::vector<std::filesystem::path> morePathNames) = 0;
+
+	/** @return Mechanism used to read files. */
+	virtual Backend
+	getBackend()
+	    const = 0;
+
+	/** Files to read, in order. */
+	std::vector<std::filesystem::path> pathNames;
+	/** Maximum number of files read ahead. */
+	const uint16_t depth;
+	/** Index of the next file to return. */
+	std::size_t nextIndex{};
+};
+
+/** Reads files with blocking calls on a pool of threads. */
+class FRIF::Util::FilePrefetcher::ThreadPoolReader :
+    public FRIF::Util::FilePrefetcher::Impl
+{
+public:
+	ThreadPoolReader(
+	    std::vector<std::filesystem::path> pathNames_,
+	    const uint16_t depth_) :
+	    Impl{std::move(pathNames_), depth_},
+	    slots(depth_)
+	{
+		this->addThreads();
+	}
+
+	~ThreadPoolReader()
+	    override
+	{
+		this->stop();
+	}
+
+	FileContents
+	take(
+	    const std::size_t index)
+	    override
+	{
+		std::unique_lock lock{this->mutex};
+		auto &slot = this->slots[index % this->depth];
+		this->changed.wait(lock, [&slot]() { return (slot.done); });
+
+		Slot taken{std::exchange(slot, {})};
+		this->consumed = index + 1;
+		lock.unlock();
+		this->changed.notify_all();
+
+		if (taken.error)
+			std::rethrow_exception(taken.error);
+		return (taken.contents);
+	}
+
+	void
+	extend(
+	    std::vector<std::filesystem::path> morePathNames)
+	    override
+	{
+		{
+			const std::lock_guard lock{this->mutex};
+			this->pathNames.insert(this->pathNames.cend(),
+			    std::make_move_iterator(morePathNames.begin()),
+			    std::make_move_iterator(morePathNames.end()));
+		}
+		this->changed.notify_all();
+		this->addThreads();
+	}
+
+	Backend
+	getBackend()
+	    const
+	    override
+	{
+		return (Backend::Threads);
+	}
+
+private:
+	/** Result of reading one file. */
+	struct Slot
+	{
+		/** Whether the read has finished. */
+		bool done{};
+		/** Contents of the file, if read without error. */
+		FileContents contents{};
+		/** Error reading the file, if any. */
+		std::exception_ptr error{};
+	};
+
+	/** Start threads until there is one per file that may be read. */
+	void
+	addThreads()
+	{
+		std::size_t numThreads{};
+		{
+			const std::lock_guard lock{this->mutex};
+			numThreads = std::min<std::size_t>({this->depth,
+			    MaxPrefetchThreads, this->pathNames.size()});
+		}
+		try {
+			while (this->threads.size() < numThreads)
+				this->threads.emplace_back(
+				    &ThreadPoolReader::work, this);
+		} catch (...) {
+			this->stop();
+			throw;
+		}
+	}
+
+	/** Read files as they are allowed until stop() is called. */
+	void
+	work()
+	{
+		std::unique_lock lock{this->mutex};
+		while (true) {
+			/* extend() may add files after all are read */
+			this->changed.wait(lock, [this]() {
+				return (this->stopping || ((this->started <
+				    this->pathNames.size()) && (this->started <
+				    this->consumed + this->depth)));
+			});
+			if (this->stopping)
+				return;
+
+			/* extend() may reallocate pathNames once unlocked */
+			const auto index = this->started++;
+			const auto pathName = this->pathNames[index];
+			lock.unlock();
+
+			Slot slot{true};
+			try {
+				slot.contents = readFileContents(pathName);
+			} catch (...) {
+				slot.error = std::current_exception();
+			}
+
+			lock.lock();
+			this->slots[index % this->depth] = std::move(slot);
+			this->changed.notify_all();
+		}
+	}
+
+	/** Stop and join all threads. */
+	void
+	stop()
+	{
+		{
+			const std::lock_guard lock{this->mutex};
+			this->stopping = true;
+		}
+		this->changed.notify_all();
+		for (auto &thread : this->threads)
+			thread.join();
+		this->threads.clear();
+	}
+
+	/** Guards all members below. */
+	std::mutex mutex{};
+	/** Signaled when a read finishes or a file is taken. */
+	std::condition_variable changed{};
+	/** Result of each file read ahead. */
+	std::vector<Slot> slots{};
+	/** Index of the next file to start reading. */
+	std::size_t started{};
+	/** Number of files returned from take(). */
+	std::size_t consumed{};
+	/** Whether threads should exit. */
+	bool stopping{};
+	/** Threads reading files. */
+	std::vector<std::thread> threads{};
+};
+
+/** Reads files with asynchronous reads submitted to io_uring. */
+class FRIF::Util::FilePrefetcher::IOURingReader :
+    public FRIF::Util::FilePrefetcher::Impl
+{
+public:
+	/**
+	 * @throw std::system_error
+	 * io_uring, or its read operation, is unavailable.
+	 */
+	IOURingReader(
+	    const std::vector<std::filesystem::path> &pathNames_,
+	    const uint16_t depth_) :
+	    Impl{pathNames_, depth_},
+	    slots(depth_)
+	{
+#ifdef FRIF_HAVE_IO_URING
+		try {
+			this->setUp();
+			const auto count = std::min<std::size_t>(this->depth,
+			    this->pathNames.size());
+			for (std::size_t i{0}; i < count; ++i)
+				this->start(i);
+			this->submit();
+		} catch (...) {
+			this->tearDown();
+			throw;
+		}
+#else
+		throw std::system_error{ENOSYS, std::generic_category(),
+		    "io_uring unavailable"};
+#endif /* FRIF_HAVE_IO_URING */
+	}
+
+	~IOURingReader()
+	    override
+	{
+		this->tearDown();
+	}
+
+	FileContents
+	take(
+	    const std::size_t index)
+	    override
+	{
+		auto &slot = this->slots[index % this->depth];
+		while (!slot.done)
+			this->reap(true);
+
+		Slot taken{std::exchange(slot, {})};
+		if ((index + this->depth) < this->pathNames.size()) {
+			this->start(index + this->depth);
+			this->submit();
+		}
+
+		if (taken.error)
+			std::rethrow_exception(taken.error);
+		return {{taken.buffer.get(), taken.size}, taken.buffer};
+	}
+
+	void
+	extend(
+	    std::vector<std::filesystem::path> morePathNames)
+	    override
+	{
+		/* Files before the end of the window were started by take() */
+		const auto end = this->nextIndex + this->depth;
+		const auto first = std::min(this->pathNames.size(), end);
+
+		this->pathNames.insert(this->pathNames.cend(),
+		    std::make_move_iterator(morePathNames.begin()),
+		    std::make_move_iterator(morePathNames.end()));
+
+		const auto last = std::min(this->pathNames.size(), end);
+		for (auto i = first; i < last; ++i)
+			this->start(i);
+		this->submit();
+	}
+
+	Backend
+	getBackend()
+	    const
+	    override
+	{
+		return (Backend::IOURing);
+	}
+
+private:
+	/** State of reading one file. */
+	struct Slot
+	{
+		/** Descriptor of the file while it is being read. */
+		int fd{-1};
+		/** Contents of the file. */
+		std::shared_ptr<std::byte[]> buffer{};
+		/** Size of the file. */
+		std::size_t size{};
+		/** Number of bytes read so far. */
+		std::size_t offset{};
+		/** Whether the read has finished. */
+		bool done{};
+		/** Error reading the file, if any. */
+		std::exception_ptr error{};
+	};
+
+	/** Largest read submitted at once, since lengths are 32 bits. */
+	static constexpr std::size_t MaxReadLength{1u << 30};
+
+#ifdef FRIF_HAVE_IO_URING
+	/** Create the ring and map its queues. */
+	void
+	setUp()
+	{
+		io_uring_params params{};
+		this->ringFD = static_cast<int>(syscall(__NR_io_uring_setup,
+		    this->depth, &params));
+		if (this->ringFD == -1)
+			throw std::system_error{errno, std::generic_category(),
+			    "io_uring_setup"};
+
+		/* IORING_OP_READ needs Linux 5.6 */
+		std::vector<std::byte> probeBuffer(sizeof(io_uring_probe) +
+		    (IORING_OP_LAST * sizeof(io_uring_probe_op)));
+		auto *probe = reinterpret_cast<io_uring_probe*>(
+		    probeBuffer.data());
+		if ((syscall(__NR_io_uring_register, this->ringFD,
+		    IORING_REGISTER_PROBE, probe, IORING_OP_LAST) == -1) ||
+		    (probe->last_op < IORING_OP_READ) ||
+		    !(probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED))
+			throw std::system_error{ENOTSUP,
+			    std::generic_category(), "IORING_OP_READ"};
+
+		this->sqRingSize = params.sq_off.array +
+		    (params.sq_entries * sizeof(unsigned));
+		this->cqRingSize = params.cq_off.cqes +
+		    (params.cq_entries * sizeof(io_uring_cqe));
+		const bool singleMap{(params.features &
+		    IORING_FEAT_SINGLE_MMAP) != 0};
+		if (singleMap)
+			this->sqRingSize = this->cqRingSize = std::max(
+			    this->sqRingSize, this->cqRingSize);
+
+		this->sqRing = this->mapRing(this->sqRingSize,
+		    IORING_OFF_SQ_RING);
+		this->cqRing = singleMap ? this->sqRing : this->mapRing(
+		    this->cqRingSize, IORING_OFF_CQ_RING);
+		this->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		this->sqes = static_cast<io_uring_sqe*>(this->mapRing(
+		    this->sqesSize, IORING_OFF_SQES));
+
+		auto *sq = static_cast<char*>(this->sqRing);
+		this->sqTail = reinterpret_cast<unsigned*>(sq +
+		    params.sq_off.tail);
+		this->sqMask = *reinterpret_cast<unsigned*>(sq +
+		    params.sq_off.ring_mask);
+		this->sqArray = reinterpret_cast<unsigned*>(sq +
+		    params.sq_off.array);
+
+		auto *cq = static_cast<char*>(this->cqRing);
+		this->cqHead = reinterpret_cast<unsigned*>(cq +
+		    params.cq_off.head);
+		this->cqTail = reinterpret_cast<unsigned*>(cq +
+		    params.cq_off.tail);
+		this->cqMask = *reinterpret_cast<unsigned*>(cq +
+		    params.cq_off.ring_mask);
+		this->cqes = reinterpret_cast<io_uring_cqe*>(cq +
+		    params.cq_off.cqes);
+	}
+
+	/** @return Mapping of part of the ring. */
+	void*
+	mapRing(
+	    const std::size_t size,
+	    const off_t offset)
+	{
+		void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+		    MAP_SHARED | MAP_POPULATE, this->ringFD, offset);
+		if (address == MAP_FAILED)
+			throw std::system_error{errno, std::generic_category(),
+			    "mmap io_uring"};
+		return (address);
+	}
+#endif /* FRIF_HAVE_IO_URING */
+
+	/** Wait for reads in flight, then release the ring. */
+	void
+	tearDown()
+	    noexcept
+	{
+#ifdef FRIF_HAVE_IO_URING
+		/* The kernel writes into buffers until reads complete */
+		try {
+			while (this->inFlight > 0)
+				this->reap(true);
+		} catch (...) {
+			/* Ring is unusable, so leak buffers rather than risk
+			 * the kernel writing into freed memory */
+			for (auto &slot : this->slots)
+				if (!slot.done)
+					new std::shared_ptr<std::byte[]>(
+					    std::move(slot.buffer));
+		}
+		for (auto &slot : this->slots)
+			if (slot.fd != -1)
+				close(std::exchange(slot.fd, -1));
+
+		if (this->sqes != nullptr)
+			munmap(this->sqes, this->sqesSize);
+		if ((this->cqRing != nullptr) && (this->cqRing != this->sqRing))
+			munmap(this->cqRing, this->cqRingSize);
+		if (this->sqRing != nullptr)
+			munmap(this->sqRing, this->sqRingSize);
+		if (this->ringFD != -1)
+			close(this->ringFD);
+		this->sqes = nullptr;
+		this->sqRing = this->cqRing = nullptr;
+		this->ringFD = -1;
+#endif /* FRIF_HAVE_IO_URING */
+	}
+
+	/** Open file `index` and queue its first read. */
+	void
+	start(
+	    const std::size_t index)
+	{
+		auto &slot = this->slots[index % this->depth];
+		slot = {};
+		try {
+			std::tie(slot.fd, slot.size) = openForRead(
+			    this->pathNames[index]);
+			slot.buffer = allocateFileBuffer(slot.size);
+		} catch (...) {
+			if (slot.fd != -1)
+				close(std::exchange(slot.fd, -1));
+			slot.error = std::current_exception();
+			slot.done = true;
+			return;
+		}
+
+		if (slot.size == 0) {
+			close(std::exchange(slot.fd, -1));
+			slot.done = true;
+			return;
+		}
+		this->queueRead(index);
+	}
+
+	/** Queue a read of the unread remainder of file `index`. */
+	void
+	queueRead(
+	    const std::size_t index)
+	{
+#ifdef FRIF_HAVE_IO_URING
+		const auto &slot = this->slots[index % this->depth];
+
+		/* This thread is the only producer */
+		std::atomic_ref<unsigned> tail{*this->sqTail};
+		const unsigned position{tail.load(std::memory_order_relaxed)};
+		const unsigned entry{position & this->sqMask};
+
+		io_uring_sqe &sqe = this->sqes[entry];
+		sqe = {};
+		sqe.opcode = IORING_OP_READ;
+		sqe.fd = slot.fd;
+		sqe.addr = reinterpret_cast<uint64_t>(slot.buffer.get() +
+		    slot.offset);
+		sqe.len = static_cast<uint32_t>(std::min(MaxReadLength,
+		    slot.size - slot.offset));
+		sqe.off = slot.offset;
+		sqe.user_data = index;
+		this->sqArray[entry] = entry;
+
+		tail.store(position + 1, std::memory_order_release);
+		++this->unsubmitted;
+		++this->inFlight;
+#else
+		static_cast<void>(index);
+#endif /* FRIF_HAVE_IO_URING */
+	}
+
+	/** Submit queued reads without waiting. */
+	void
+	submit()
+	{
+		if (this->unsubmitted > 0)
+			this->enter(0);
+	}
+
+	/**
+	 * @brief
+	 * Submit queued reads and, optionally, wait for completions.
+	 *
+	 * @param minComplete
+	 * Number of completions to wait for.
+	 */
+	void
+	enter(
+	    const unsigned minComplete)
+	{
+#ifdef FRIF_HAVE_IO_URING
+		while (true) {
+			const auto rv = syscall(__NR_io_uring_enter,
+			    this->ringFD, this->unsubmitted, minComplete,
+			    minComplete > 0 ? IORING_ENTER_GETEVENTS : 0,
+			    nullptr, 0);
+			if (rv >= 0) {
+				this->unsubmitted -= static_cast<unsigned>(rv);
+				return;
+			}
+			if (errno != EINTR)
+				throw std::system_error{errno,
+				    std::generic_category(), "io_uring_enter"};
+		}
+#else
+		static_cast<void>(minComplete);
+#endif /* FRIF_HAVE_IO_URING */
+	}
+
+	/**
+	 * @brief
+	 * Process completed reads, queuing the remainder of short reads.
+	 *
+	 * @param wait
+	 * Whether to wait for at least one completion.
+	 */
+	void
+	reap(
+	    const bool wait)
+	{
+#ifdef FRIF_HAVE_IO_URING
+		std::atomic_ref<unsigned> head{*this->cqHead};
+		std::atomic_ref<unsigned> tail{*this->cqTail};
+
+		unsigned position{head.load(std::memory_order_relaxed)};
+		if (wait && (position == tail.load(std::memory_order_acquire)))
+			this->enter(1);
+
+		for (; position != tail.load(std::memory_order_acquire);
+		    ++position) {
+			const io_uring_cqe cqe{this->cqes[position &
+			    this->cqMask]};
+			--this->inFlight;
+
+			const auto index = static_cast<std::size_t>(
+			    cqe.user_data);
+			auto &slot = this->slots[index % this->depth];
+			if (cqe.res > 0) {
+				slot.offset += static_cast<std::size_t>(
+				    cqe.res);
+				if (slot.offset < slot.size) {
+					this->queueRead(index);
+					continue;
+				}
+			} else {
+				/* A file that shrinks ends early */
+				const int err{cqe.res == 0 ? EIO : -cqe.res};
+				slot.error = std::make_exception_ptr(
+				    std::runtime_error{"Could not read " +
+				    this->pathNames[index].string() + ": " +
+				    std::strerror(err)});
+			}
+			close(std::exchange(slot.fd, -1));
+			slot.done = true;
+		}
+		head.store(position, std::memory_order_release);
+
+		this->submit();
+#else
+		static_cast<void>(wait);
+#endif /* FRIF_HAVE_IO_URING */
+	}
+
+	/** State of each file read ahead. */
+	std::vector<Slot> slots{};
+	/** Number of queued reads not yet submitted. */
+	unsigned unsubmitted{};
+	/** Number of submitted reads not yet completed. */
+	unsigned inFlight{};
+
+#ifdef FRIF_HAVE_IO_URING
+	/** io_uring instance. */
+	int ringFD{-1};
+	/** Mapping of the submission queue ring. */
+	void *sqRing{};
+	/** Size of #sqRing. */
+	std::size_t sqRingSize{};
+	/** Mapping of the completion queue ring. */
+	void *cqRing{};
+	/** Size of #cqRing. */
+	std::size_t cqRingSize{};
+	/** Mapping of submission queue entries. */
+	io_uring_sqe *sqes{};
+	/** Size of #sqes. */
+	std::size_t sqesSize{};
+
+	/** Submission queue tail, written by this process. */
+	unsigned *sqTail{};
+	/** Mask applied to submission queue positions. */
+	unsigned sqMask{};
+	/** Indices of submission queue entries. */
+	unsigned *sqArray{};
+	/** Completion queue head, written by this process. */
+	unsigned *cqHead{};
+	/** Completion queue tail, written by the kernel. */
+	unsigned *cqTail{};
+	/** Mask applied to completion queue positions. */
+	unsigned cqMask{};
+	/** Completion queue entries. */
+	io_uring_cqe *cqes{};
+#endif /* FRIF_HAVE_IO_URING */
+};
+
+FRIF::Util::FilePrefetcher::FilePrefetcher(
+    std::vector<std::filesystem::path> pathNames,
+    const uint16_t depth,
+    const Backend backend)
+{
+	if (depth == 0)
+		throw std::invalid_argument{"Prefetch depth must be at least 1"};
+
+	if (backend == Backend::IOURing) {
+		try {
+			this->impl = std::make_unique<IOURingReader>(pathNames,
+			    depth);
+			return;
+		} catch (const std::system_error&) {
+			/* Fall back to threads */
+		}
+	}
+	this->impl = std::make_unique<ThreadPoolReader>(std::move(pathNames),
+	    depth);
+}
+
+FRIF::Util::FileContents
+FRIF::Util::FilePrefetcher::next(
+    const std::filesystem::path &pathName)
+{
+	if (this->impl->nextIndex >= this->impl->pathNames.size())
+		throw std::logic_error{"Requested " + pathName.string() +
+		    ", but all files were prefetched"};
+	if (this->impl->pathNames[this->impl->nextIndex] != pathName)
+		throw std::logic_error{"Requested " + pathName.string() +
+		    ", but the next prefetched file is " + this->impl->
+		    pathNames[this->impl->nextIndex].string()};
+
+	return (this->impl->take(this->impl->nextIndex++));
+}
+
+void
+FRIF::Util::FilePrefetcher::extend(
+    std::vector<std::filesystem::path> pathNames)
+{
+	this->impl->extend(std::move(pathNames));
+}
+
+FRIF::Util::FilePrefetcher::Backend
+FRIF::Util::FilePrefetcher::getBackend()
+    const
+{
+	return (this->impl->getBackend());
+}
+
+FRIF::Util::FilePrefetcher::~FilePrefetcher() = default;
+
 std::vector<uint64_t>
 FRIF::Util::randomizeIndices(
     const uint64_t size,
@@ -61,22 +941,11 @@ std::vector<std::byte>
 FRIF::Util::readFile(
     const std::string &pathName)
 {
-	std::ifstream file{pathName,
-	    std::ifstream::ate | std::ifstream::binary};
-	if (!file)
-		throw std::runtime_error{"Could not open " + pathName};
-	file.unsetf(std::ifstream::skipws);
-
-	const auto size = file.tellg();
-	if (size == -1)
-		throw std::runtime_error{"Could not open " + pathName};
+	/* Copy from a mapping, instead of zero-filling and then reading */
+	const MappedFile file{pathName, MappedFile::Access::Sequential};
+	const auto contents = file.data();
 
-	std::vector<std::byte> buf{};
-	buf.resize(static_cast<std::vector<std::byte>::size_type>(size));
-	file.seekg(std::ifstream::beg);
-	file.read(reinterpret_cast<char*>(buf.data()), size);
-
-	return (buf);
+	return (std::vector<std::byte>{contents.begin(), contents.end()});
 }
 
 std::string
@@ -113,110 +982,193 @@ FRIF::Util::sanitizeMessage(
 	return (wrapInQuotes ? '"' + sanitized + '"' : sanitized);
 }
 
+FRIF::Util::LogBuffer&
+FRIF::Util::LogBuffer::operator<<(
+    const char c)
+{
+	this->buffer += c;
+	return (*this);
+}
+
+FRIF::Util::LogBuffer&
+FRIF::Util::LogBuffer::operator<<(
+    const std::string_view s)
+{
+	this->buffer += s;
+	return (*this);
+}
+
+void
+FRIF::Util::LogBuffer::removeSuffix(
+    const std::string_view suffix)
+{
+	if (std::string_view{this->buffer}.ends_with(suffix))
+		this->buffer.resize(this->buffer.size() - suffix.size());
+}
+
+void
+FRIF::Util::LogBuffer::clear()
+    noexcept
+{
+	this->buffer.clear();
+}
+
+std::string_view
+FRIF::Util::LogBuffer::view()
+    const
+    noexcept
+{
+	return (this->buffer);
+}
+
 std::string
+FRIF::Util::LogBuffer::str()
+    const
+{
+	return (this->buffer);
+}
+
+void
 FRIF::Util::splice(
-    const std::vector<Coordinate> &v,
+    LogBuffer &buffer,
+    std::span<const Coordinate> v,
     const std::string &elementSep,
     const std::string &itemSep)
 {
 	if (elementSep == itemSep)
 		throw std::runtime_error{"elementSep == itemSep"};
 
-	std::string ret{};
 	for (const auto &c : v)
-		ret += ts(c.x) + elementSep + ts(c.y) + itemSep;
-	ret.erase(ret.find_last_of(itemSep), itemSep.length());
-	return (ret);
+		buffer << c.x << elementSep << c.y << itemSep;
+	if (!v.empty())
+		buffer.removeSuffix(itemSep);
 }
 
 std::string
 FRIF::Util::splice(
-    const std::vector<EFS::Minutia> &v,
+    const std::vector<Coordinate> &v,
+    const std::string &elementSep,
+    const std::string &itemSep)
+{
+	LogBuffer buffer{};
+	splice(buffer, v, elementSep, itemSep);
+	return (buffer.str());
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
+    std::span<const EFS::Minutia> v,
     const std::string &elementSep,
     const std::string &itemSep)
 {
 	if (elementSep == itemSep)
 		throw std::runtime_error{"elementSep == itemSep"};
 
-	std::string ret{};
 	for (const auto &m : v)
-		ret += ts(m.coordinate.x) + elementSep + ts(m.coordinate.y) +
-		    elementSep +
-		    (m.coordinateUncertainty ?
-		    ts(*m.coordinateUncertainty) : NA) + elementSep +
-		    ts(m.theta) + elementSep +
-		    (m.thetaUncertainty ? ts(*m.thetaUncertainty) : NA) +
-		    elementSep + e2i2s(m.type) + itemSep;
-	ret.erase(ret.find_last_of(itemSep), itemSep.length());
-	return (ret);
+		buffer << m.coordinate.x << elementSep << m.coordinate.y <<
+		    elementSep << m.coordinateUncertainty << elementSep <<
+		    m.theta << elementSep << m.thetaUncertainty <<
+		    elementSep << m.type << itemSep;
+	if (!v.empty())
+		buffer.removeSuffix(itemSep);
 }
 
 std::string
 FRIF::Util::splice(
-    const std::vector<EFS::Core> &v,
+    const std::vector<EFS::Minutia> &v,
+    const std::string &elementSep,
+    const std::string &itemSep)
+{
+	LogBuffer buffer{};
+	splice(buffer, v, elementSep, itemSep);
+	return (buffer.str());
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
+    std::span<const EFS::Core> v,
     const std::string &elementSep,
     const std::string &itemSep)
 {
 	if (elementSep == itemSep)
 		throw std::runtime_error{"elementSep == itemSep"};
 
-	std::string ret{};
 	for (const auto &c : v)
-		ret += ts(c.coordinate.x) + elementSep +
-		    ts(c.coordinate.y) + elementSep +
-		    (c.coordinateUncertainty ?
-		    ts(*c.coordinateUncertainty) : NA) + elementSep +
-		    (c.direction ? ts(*c.direction) : NA) + itemSep;
-	ret.erase(ret.find_last_of(itemSep), itemSep.length());
-	return (ret);
+		buffer << c.coordinate.x << elementSep << c.coordinate.y <<
+		    elementSep << c.coordinateUncertainty << elementSep <<
+		    c.direction << itemSep;
+	if (!v.empty())
+		buffer.removeSuffix(itemSep);
 }
 
 std::string
 FRIF::Util::splice(
-    const std::vector<EFS::Delta> &v,
+    const std::vector<EFS::Core> &v,
+    const std::string &elementSep,
+    const std::string &itemSep)
+{
+	LogBuffer buffer{};
+	splice(buffer, v, elementSep, itemSep);
+	return (buffer.str());
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
+    std::span<const EFS::Delta> v,
     const std::string &elementSep,
     const std::string &itemSep)
 {
 	if (elementSep == itemSep)
 		throw std::runtime_error{"elementSep == itemSep"};
 
-	std::string ret{};
 	for (const auto &d : v) {
-		ret += ts(d.coordinate.x) + elementSep +
-		    ts(d.coordinate.y) + elementSep +
-		    (d.coordinateUncertainty ?
-		    ts(*d.coordinateUncertainty) : NA) + elementSep;
+		buffer << d.coordinate.x << elementSep << d.coordinate.y <<
+		    elementSep << d.coordinateUncertainty << elementSep;
 		if (d.direction)
-			ret +=
-			    (std::get<0>(*d.direction) ?
-				ts(*std::get<0>(*d.direction)) : NA) +
-				elementSep +
-			    (std::get<1>(*d.direction) ?
-				ts(*std::get<1>(*d.direction)) : NA) +
-				elementSep +
-			    (std::get<2>(*d.direction) ?
-				ts(*std::get<2>(*d.direction)) : NA) +
-				elementSep;
+			buffer << std::get<0>(*d.direction) << elementSep <<
+			    std::get<1>(*d.direction) << elementSep <<
+			    std::get<2>(*d.direction) << elementSep;
 		if (d.directionUncertainty)
-			ret +=
-			    (std::get<0>(*d.directionUncertainty) ?
-				ts(*std::get<0>(*d.directionUncertainty)) :
-				NA) + elementSep +
-			    (std::get<1>(*d.directionUncertainty) ?
-				ts(*std::get<1>(*d.directionUncertainty)) :
-				NA) + elementSep +
-			    (std::get<2>(*d.directionUncertainty) ?
-				ts(*std::get<2>(*d.directionUncertainty)) :
-				NA) + elementSep;
-		ret += itemSep;
-	}
-	ret.erase(ret.find_last_of(itemSep), itemSep.length());
-	return (ret);
+			buffer << std::get<0>(*d.directionUncertainty) <<
+			    elementSep <<
+			    std::get<1>(*d.directionUncertainty) <<
+			    elementSep <<
+			    std::get<2>(*d.directionUncertainty) <<
+			    elementSep;
+		buffer << itemSep;
+	}
+	if (!v.empty())
+		buffer.removeSuffix(itemSep);
 }
 
 std::string
 FRIF::Util::splice(
-    const std::vector<EFS::RidgeQualityRegion> &v,
+    const std::vector<EFS::Delta> &v,
+    const std::string &elementSep,
+    const std::string &itemSep)
+{
+	LogBuffer buffer{};
+	splice(buffer, v, elementSep, itemSep);
+	return (buffer.str());
+}
+
+/**
+ * @brief
+ * Append RidgeQualityRegion or pmr::RidgeQualityRegion to a LogBuffer.
+ *
+ * @see
+ * FRIF::Util::splice(const std::vector<EFS::RidgeQualityRegion>&,
+ * const std::string&, const std::string&, const std::string&,
+ * const std::string&)
+ */
+template<typename RidgeQualityRegion>
+static void
+spliceRidgeQualityRegions(
+    FRIF::Util::LogBuffer &buffer,
+    std::span<const RidgeQualityRegion> v,
     const std::string &elementSep,
     const std::string &itemSep,
     const std::string &coordinateElementSep,
@@ -229,30 +1181,82 @@ FRIF::Util::splice(
 	    (coordinateElementSep == coordinateItemSep))
 		throw std::runtime_error{"separator equality"};
 
-	std::string ret{};
-	for (const auto &r : v)
-		ret += e2i2s(r.quality) + elementSep +
-		    splice(r.region, coordinateElementSep, coordinateItemSep) +
-		    itemSep;
-	ret.erase(ret.find_last_of(itemSep), itemSep.length());
-	return (ret);
+	for (const auto &r : v) {
+		buffer << r.quality << elementSep;
+		FRIF::Util::splice(buffer, r.region, coordinateElementSep,
+		    coordinateItemSep);
+		buffer << itemSep;
+	}
+	if (!v.empty())
+		buffer.removeSuffix(itemSep);
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
+    std::span<const EFS::RidgeQualityRegion> v,
+    const std::string &elementSep,
+    const std::string &itemSep,
+    const std::string &coordinateElementSep,
+    const std::string &coordinateItemSep)
+{
+	spliceRidgeQualityRegions(buffer, v, elementSep, itemSep,
+	    coordinateElementSep, coordinateItemSep);
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
+    std::span<const EFS::pmr::RidgeQualityRegion> v,
+    const std::string &elementSep,
+    const std::string &itemSep,
+    const std::string &coordinateElementSep,
+    const std::string &coordinateItemSep)
+{
+	spliceRidgeQualityRegions(buffer, v, elementSep, itemSep,
+	    coordinateElementSep, coordinateItemSep);
 }
 
 std::string
 FRIF::Util::splice(
-    const std::vector<std::string> &v,
+    const std::vector<EFS::RidgeQualityRegion> &v,
+    const std::string &elementSep,
+    const std::string &itemSep,
+    const std::string &coordinateElementSep,
+    const std::string &coordinateItemSep)
+{
+	LogBuffer buffer{};
+	splice(buffer, v, elementSep, itemSep, coordinateElementSep,
+	    coordinateItemSep);
+	return (buffer.str());
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
+    std::span<const std::string> v,
     const std::string &itemSep)
 {
-	std::string ret{};
 	for (const auto &s : v)
-		ret += s + itemSep;
-	ret.erase(ret.find_last_of(itemSep), itemSep.length());
-	return (ret);
+		buffer << s << itemSep;
+	if (!v.empty())
+		buffer.removeSuffix(itemSep);
 }
 
 std::string
 FRIF::Util::splice(
-    const std::vector<Segment> &v,
+    const std::vector<std::string> &v,
+    const std::string &itemSep)
+{
+	LogBuffer buffer{};
+	splice(buffer, v, itemSep);
+	return (buffer.str());
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
+    std::span<const Segment> v,
     const std::string &itemSep,
     const std::string &coordinateElementSep,
     const std::string &coordinateItemSep)
@@ -262,21 +1266,31 @@ FRIF::Util::splice(
 	    (coordinateElementSep == coordinateItemSep))
 		throw std::runtime_error{"separator equality"};
 
-	std::string ret{};
-	for (const auto &s : v) {
-		ret += ts(std::get<0>(s).x) + coordinateElementSep +
-		    ts(std::get<0>(s).y) + coordinateItemSep +
-		    ts(std::get<1>(s).x) + coordinateElementSep +
-		    ts(std::get<1>(s).y) + itemSep;
-	}
-
-	ret.erase(ret.find_last_of(itemSep), itemSep.length());
-	return (ret);
+	for (const auto &s : v)
+		buffer << std::get<0>(s).x << coordinateElementSep <<
+		    std::get<0>(s).y << coordinateItemSep <<
+		    std::get<1>(s).x << coordinateElementSep <<
+		    std::get<1>(s).y << itemSep;
+	if (!v.empty())
+		buffer.removeSuffix(itemSep);
 }
 
 std::string
 FRIF::Util::splice(
-    const std::vector<EFS::Crease> &v,
+    const std::vector<Segment> &v,
+    const std::string &itemSep,
+    const std::string &coordinateElementSep,
+    const std::string &coordinateItemSep)
+{
+	LogBuffer buffer{};
+	splice(buffer, v, itemSep, coordinateElementSep, coordinateItemSep);
+	return (buffer.str());
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
+    std::span<const EFS::Crease> v,
     const std::string &elementSep,
     const std::string &itemSep,
     const std::string &segmentItemSep,
@@ -294,101 +1308,507 @@ FRIF::Util::splice(
 	    (coordinateElementSep == coordinateItemSep))
 		throw std::runtime_error{"separator equality"};
 
-	std::string ret{};
 	for (const auto &c : v) {
-		ret += e2i2s(c.getFrictionRidgeGeneralizedPosition()) +
+		buffer << c.getFrictionRidgeGeneralizedPosition() <<
+		    elementSep << ts(c.getCreaseClassification()) <<
 		    elementSep;
-		ret += ts(c.getCreaseClassification()) + elementSep;
-		ret += splice(c.getSegments(), segmentItemSep,
-		    coordinateItemSep, coordinateElementSep) + itemSep;
+		splice(buffer, c.getSegments(), segmentItemSep,
+		    coordinateItemSep, coordinateElementSep);
+		buffer << itemSep;
 	}
-
-	ret.erase(ret.find_last_of(itemSep), itemSep.length());
-	return (ret);
+	if (!v.empty())
+		buffer.removeSuffix(itemSep);
 }
 
 std::string
 FRIF::Util::splice(
+    const std::vector<EFS::Crease> &v,
+    const std::string &elementSep,
+    const std::string &itemSep,
+    const std::string &segmentItemSep,
+    const std::string &coordinateElementSep,
+    const std::string &coordinateItemSep)
+{
+	LogBuffer buffer{};
+	splice(buffer, v, elementSep, itemSep, segmentItemSep,
+	    coordinateElementSep, coordinateItemSep);
+	return (buffer.str());
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
     const EFS::QualityMeasure::Description &d,
     const std::string &elementSep)
 {
-	std::string ret{};
 	if (d.identifier) {
 		if (d.identifier->marketing)
-			ret += sanitizeMessage(*d.identifier->marketing);
+			buffer << sanitizeMessage(*d.identifier->marketing);
 		else
-			ret += NA;
-		ret += elementSep;
+			buffer << NA;
+		buffer << elementSep;
 
-		if (d.identifier->cbeff) {
-			ret += std::to_string(d.identifier->cbeff->owner) +
-			    elementSep;
-			if (d.identifier->cbeff->algorithm)
-				ret += std::to_string(
-				    *d.identifier->cbeff->algorithm);
-			else
-				ret += NA;
-			ret += elementSep;
-		} else
-			ret += NA + elementSep + NA + elementSep;
+		if (d.identifier->cbeff)
+			buffer << d.identifier->cbeff->owner << elementSep <<
+			    d.identifier->cbeff->algorithm << elementSep;
+		else
+			buffer << NA << elementSep << NA << elementSep;
 	} else
-		ret += NA + elementSep + NA + elementSep + NA + elementSep;
+		buffer << NA << elementSep << NA << elementSep << NA <<
+		    elementSep;
 
 	if (d.version)
-		ret += sanitizeMessage(*d.version);
+		buffer << sanitizeMessage(*d.version);
 	else
-		ret += NA;
-	ret += elementSep;
+		buffer << NA;
+	buffer << elementSep;
 
 	if (d.comment)
-		ret += sanitizeMessage(*d.comment);
+		buffer << sanitizeMessage(*d.comment);
 	else
-		ret += NA;
-	ret += elementSep;
+		buffer << NA;
+	buffer << elementSep;
 
 	if (d.modelSHA256)
-		ret += sanitizeMessage(*d.modelSHA256);
+		buffer << sanitizeMessage(*d.modelSHA256);
 	else
-		ret += NA;
-
-	return (ret);
+		buffer << NA;
 }
 
 std::string
 FRIF::Util::splice(
+    const EFS::QualityMeasure::Description &d,
+    const std::string &elementSep)
+{
+	LogBuffer buffer{};
+	splice(buffer, d, elementSep);
+	return (buffer.str());
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
     const EFS::QualityMeasure &q,
     const std::string &elementSep)
 {
-	std::string ret = e2i2s(q.getStatus()) + elementSep;
+	buffer << q.getStatus() << elementSep;
 	if (q)
-		ret += std::to_string(q.getValue());
+		buffer << q.getValue();
 	else
-		ret += NA;
-	ret += elementSep;
+		buffer << NA;
+	buffer << elementSep;
 
 	if (q.getMessage())
-		ret += sanitizeMessage(*q.getMessage());
+		buffer << sanitizeMessage(*q.getMessage());
 	else
-		ret += NA;
-
-	return (ret);
+		buffer << NA;
 }
 
 std::string
 FRIF::Util::splice(
-    const EFS::QualityMeasureMap &m,
+    const EFS::QualityMeasure &q,
+    const std::string &elementSep)
+{
+	LogBuffer buffer{};
+	splice(buffer, q, elementSep);
+	return (buffer.str());
+}
+
+/**
+ * @brief
+ * Append QualityMeasureMap or pmr::QualityMeasureMap to a LogBuffer.
+ *
+ * @see
+ * FRIF::Util::splice(const EFS::QualityMeasureMap&, const std::string&,
+ * const std::string&)
+ */
+template<typename QualityMeasureMap>
+static void
+spliceQualityMeasureMap(
+    FRIF::Util::LogBuffer &buffer,
+    const QualityMeasureMap &m,
     const std::string &elementSep,
     const std::string &itemSep)
 {
 	if (elementSep == itemSep)
 		throw std::runtime_error{"elementSep == itemSep"};
 
-	std::string ret{};
-	for (const auto &[k, v] : m)
-		ret += splice(k, elementSep) + elementSep +
-		    splice(v, elementSep) + itemSep;
-	ret.erase(ret.find_last_of(itemSep), itemSep.length());
-	return (ret);
+	for (const auto &[k, v] : m) {
+		FRIF::Util::splice(buffer, k, elementSep);
+		buffer << elementSep;
+		FRIF::Util::splice(buffer, v, elementSep);
+		buffer << itemSep;
+	}
+	if (!m.empty())
+		buffer.removeSuffix(itemSep);
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
+    const EFS::QualityMeasureMap &m,
+    const std::string &elementSep,
+    const std::string &itemSep)
+{
+	spliceQualityMeasureMap(buffer, m, elementSep, itemSep);
+}
+
+void
+FRIF::Util::splice(
+    LogBuffer &buffer,
+    const EFS::pmr::QualityMeasureMap &m,
+    const std::string &elementSep,
+    const std::string &itemSep)
+{
+	spliceQualityMeasureMap(buffer, m, elementSep, itemSep);
+}
+
+std::string
+FRIF::Util::splice(
+    const EFS::QualityMeasureMap &m,
+    const std::string &elementSep,
+    const std::string &itemSep)
+{
+	LogBuffer buffer{};
+	splice(buffer, m, elementSep, itemSep);
+	return (buffer.str());
+}
+
+/** First line of a LatencyHistogram written by write(). */
+static const std::string LatencyHistogramMagic{"LatencyHistogram"};
+
+FRIF::Util::LatencyHistogram::LatencyHistogram() :
+    counts(getIndex((uint64_t{1} << MaxValueBits) - 1) + 1)
+{
+
+}
+
+FRIF::Util::LatencyHistogram::LatencyHistogram(
+    std::istream &in) :
+    LatencyHistogram()
+{
+	std::string magic{};
+	unsigned int subBucketBits{}, maxValueBits{};
+	std::size_t numBuckets{};
+	in >> magic >> subBucketBits >> maxValueBits >> this->max >>
+	    numBuckets;
+	if (!in || (magic != LatencyHistogramMagic))
+		throw std::runtime_error{"Malformed latency histogram"};
+	if ((subBucketBits != SubBucketBits) || (maxValueBits != MaxValueBits))
+		throw std::runtime_error{"Latency histogram has a different "
+		    "layout (" + ts(subBucketBits) + '/' + ts(maxValueBits) +
+		    ')'};
+
+	for (std::size_t i{0}; i < numBuckets; ++i) {
+		std::size_t index{};
+		uint64_t bucketCount{};
+		if (!(in >> index >> bucketCount) ||
+		    (index >= this->counts.size()))
+			throw std::runtime_error{"Malformed latency histogram "
+			    "bucket " + ts(i)};
+		this->counts[index] += bucketCount;
+		this->count += bucketCount;
+	}
+}
+
+std::size_t
+FRIF::Util::LatencyHistogram::getIndex(
+    const uint64_t value)
+{
+	/* Values below 2^(SubBucketBits + 1) are their own index */
+	const auto width = static_cast<unsigned int>(std::bit_width(value));
+	const unsigned int shift{width > (SubBucketBits + 1u) ?
+	    width - (SubBucketBits + 1u) : 0};
+
+	return ((std::size_t{shift} << SubBucketBits) + (value >> shift));
+}
+
+uint64_t
+FRIF::Util::LatencyHistogram::getHighestValue(
+    const std::size_t index)
+{
+	const std::size_t shift{(index >> SubBucketBits) > 1 ?
+	    (index >> SubBucketBits) - 1 : 0};
+	const uint64_t lowest{(index - (shift << SubBucketBits)) << shift};
+
+	return (lowest + (uint64_t{1} << shift) - 1);
+}
+
+void
+FRIF::Util::LatencyHistogram::record(
+    const uint64_t value)
+{
+	const uint64_t clamped{std::min(value,
+	    (uint64_t{1} << MaxValueBits) - 1)};
+
+	++this->counts[getIndex(clamped)];
+	++this->count;
+	this->max = std::max(this->max, clamped);
+}
+
+void
+FRIF::Util::LatencyHistogram::record(
+    const std::chrono::steady_clock::time_point &start,
+    const std::chrono::steady_clock::time_point &stop)
+{
+	const auto elapsed = std::chrono::duration_cast<
+	    std::chrono::microseconds>(stop - start).count();
+	this->record(static_cast<uint64_t>(std::max<decltype(elapsed)>(
+	    elapsed, 0)));
+}
+
+void
+FRIF::Util::LatencyHistogram::merge(
+    const LatencyHistogram &rhs)
+{
+	for (std::size_t i{0}; i < this->counts.size(); ++i)
+		this->counts[i] += rhs.counts[i];
+	this->count += rhs.count;
+	this->max = std::max(this->max, rhs.max);
+}
+
+uint64_t
+FRIF::Util::LatencyHistogram::getCount()
+    const
+{
+	return (this->count);
+}
+
+uint64_t
+FRIF::Util::LatencyHistogram::getMax()
+    const
+{
+	return (this->max);
+}
+
+uint64_t
+FRIF::Util::LatencyHistogram::getValueAtPercentile(
+    const double percentile)
+    const
+{
+	if (this->count == 0)
+		return (0);
+
+	/* Rank of the value at percentile, counting from 1 */
+	const double clamped{std::clamp(percentile, 0.0, 100.0)};
+	const uint64_t rank{std::max<uint64_t>(1, static_cast<uint64_t>(
+	    std::ceil((clamped / 100.0) * static_cast<double>(this->count))))};
+
+	uint64_t seen{0};
+	for (std::size_t i{0}; i < this->counts.size(); ++i) {
+		seen += this->counts[i];
+		if (seen >= rank)
+			return (std::min(getHighestValue(i), this->max));
+	}
+
+	return (this->max);
+}
+
+void
+FRIF::Util::LatencyHistogram::write(
+    std::ostream &out)
+    const
+{
+	const auto numBuckets = std::count_if(this->counts.cbegin(),
+	    this->counts.cend(), [](const uint64_t c) { return (c != 0); });
+
+	out << LatencyHistogramMagic << ' ' << ts(SubBucketBits) << ' ' <<
+	    ts(MaxValueBits) << ' ' << ts(this->max) << ' ' <<
+	    ts(numBuckets) << '\n';
+	for (std::size_t i{0}; i < this->counts.size(); ++i)
+		if (this->counts[i] != 0)
+			out << ts(i) << ' ' << ts(this->counts[i]) << '\n';
+}
+
+#ifdef FRIF_HAVE_PERF_EVENT
+/** @return perf_event_attr type and config counting `event`. */
+static std::pair<uint32_t, uint64_t>
+getPerfEventConfig(
+    const FRIF::Util::PerfCounters::Event event)
+{
+	using Event = FRIF::Util::PerfCounters::Event;
+
+	switch (event) {
+	case Event::Cycles:
+		return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+	case Event::Instructions:
+		return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+	case Event::LLCMisses:
+		/* Generic cache miss event is the last level cache */
+		return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+	case Event::BranchMisses:
+		return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+	case Event::PageFaults:
+		return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS};
+	}
+
+	throw std::invalid_argument{"Unknown performance counter event"};
+}
+#endif /* FRIF_HAVE_PERF_EVENT */
+
+FRIF::Util::PerfCounters::PerfCounters()
+{
+	this->fds.fill(-1);
+
+#ifdef FRIF_HAVE_PERF_EVENT
+	for (std::size_t i{0}; i < Events.size(); ++i) {
+		perf_event_attr attr{};
+		attr.size = sizeof(attr);
+		std::tie(attr.type, attr.config) = getPerfEventConfig(
+		    Events[i]);
+		/* Inherited events cannot be read with PERF_FORMAT_GROUP */
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+		    PERF_FORMAT_TOTAL_TIME_RUNNING;
+		/* Count threads the implementation creates after this */
+		attr.inherit = 1;
+		/* User space only is permitted at perf_event_paranoid 2 */
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+
+		const long fd = syscall(SYS_perf_event_open, &attr, 0, -1,
+		    -1, PERF_FLAG_FD_CLOEXEC);
+		if (fd != -1)
+			this->fds[i] = static_cast<int>(fd);
+	}
+#endif /* FRIF_HAVE_PERF_EVENT */
+}
+
+bool
+FRIF::Util::PerfCounters::isCounting(
+    const Event event)
+    const
+{
+	return (this->fds.at(static_cast<std::size_t>(event)) != -1);
+}
+
+FRIF::Util::PerfCounters::Reading
+FRIF::Util::PerfCounters::read(
+    const std::size_t index)
+    const
+{
+	/* Value, then times enabled and running (summed over children) */
+	std::array<uint64_t, 3> buffer{};
+	if (::read(this->fds.at(index), buffer.data(), sizeof(buffer)) == -1)
+		throw std::runtime_error{"Could not read performance "
+		    "counters: " + std::string{std::strerror(errno)}};
+
+	return {buffer[0], buffer[1], buffer[2]};
+}
+
+void
+FRIF::Util::PerfCounters::start()
+{
+	for (std::size_t i{0}; i < Events.size(); ++i)
+		if (this->fds[i] != -1)
+			this->begin[i] = this->read(i);
+}
+
+FRIF::Util::PerfCounters::Counts
+FRIF::Util::PerfCounters::stop()
+{
+	Counts counts{};
+	for (std::size_t i{0}; i < Events.size(); ++i) {
+		if (this->fds[i] == -1)
+			continue;
+
+		const Reading end = this->read(i);
+		const uint64_t enabled{end.enabled - this->begin[i].enabled};
+		const uint64_t running{end.running - this->begin[i].running};
+
+		/* Event was never scheduled, so nothing was counted */
+		if (running == 0)
+			continue;
+
+		uint64_t value{end.value - this->begin[i].value};
+		/* Extrapolate when sharing hardware with other events */
+		if (running < enabled)
+			value = static_cast<uint64_t>(std::llround(
+			    static_cast<double>(value) *
+			    (static_cast<double>(enabled) /
+			    static_cast<double>(running))));
+		counts[i] = value;
+	}
+
+	return (counts);
+}
+
+std::string
+FRIF::Util::PerfCounters::getName(
+    const Event event)
+{
+	switch (event) {
+	case Event::Cycles:
+		return ("cycles");
+	case Event::Instructions:
+		return ("instructions");
+	case Event::LLCMisses:
+		return ("llc_misses");
+	case Event::BranchMisses:
+		return ("branch_misses");
+	case Event::PageFaults:
+		return ("page_faults");
+	}
+
+	throw std::invalid_argument{"Unknown performance counter event"};
+}
+
+FRIF::Util::PerfCounters::~PerfCounters()
+{
+	for (const auto &fd : this->fds)
+		if (fd != -1)
+			close(fd);
+}
+
+/* Processes share the cursor, so it must not fall back to a lock */
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+FRIF::Util::WorkQueue::WorkQueue(
+    const uint64_t size_,
+    const uint64_t chunkSize_) :
+    size{size_},
+    chunkSize{chunkSize_}
+{
+	if (this->chunkSize == 0)
+		throw std::invalid_argument{"Chunk size must be at least 1"};
+
+	void *address = mmap(nullptr, sizeof(std::atomic<uint64_t>),
+	    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (address == MAP_FAILED)
+		throw std::runtime_error{"Could not map work queue: " +
+		    std::string{std::strerror(errno)}};
+	this->cursor = new (address) std::atomic<uint64_t>{0};
+}
+
+std::optional<std::pair<uint64_t, uint64_t>>
+FRIF::Util::WorkQueue::claim()
+{
+	/* Claims past the end only move the cursor further past it */
+	const uint64_t first{this->cursor->fetch_add(this->chunkSize,
+	    std::memory_order_relaxed)};
+	if (first >= this->size)
+		return (std::nullopt);
+
+	return {{first, first + std::min(this->chunkSize,
+	    this->size - first)}};
+}
+
+uint64_t
+FRIF::Util::WorkQueue::getSize()
+    const
+{
+	return (this->size);
+}
+
+uint64_t
+FRIF::Util::WorkQueue::getChunkSize()
+    const
+{
+	return (this->chunkSize);
+}
+
+FRIF::Util::WorkQueue::~WorkQueue()
+{
+	munmap(this->cursor, sizeof(std::atomic<uint64_t>));
 }
 
 std::vector<std::vector<uint64_t>>
@@ -439,7 +1859,7 @@ FRIF::Util::ts(
 
 void
 FRIF::Util::writeFile(
-    const std::vector<std::byte> &data,
+    std::span<const std::byte> data,
     const std::string &pathName)
 {
 	std::ofstream file{pathName,